@@ -19,6 +19,10 @@
 #include <android/log.h>
 #include <cutils/properties.h>
 #include <log/log.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
 #include <thread>
 #include "ExecutionBurstServer.h"
 #include "Utils.h"
@@ -39,8 +43,6 @@ static const Timing kNoTiming = {.timeOnDevice = UINT64_MAX, .timeInDriver = UIN
 
 void BasePreparedModel::deinitialize() {
     ALOGV("Entering %s", __func__);
-    mModelInfo->unmapRuntimeMemPools();
-
     ALOGV("Exiting %s", __func__);
 }
 
@@ -56,6 +58,21 @@ bool BasePreparedModel::initialize() {
     return true;
 }
 
+uint64_t BasePreparedModel::nextModelId() {
+    static std::atomic<uint64_t> sNextModelId{1};
+    return sNextModelId++;
+}
+
+void BasePreparedModel::releaseBuildData(bool releaseConstants) {
+    ALOGV("Entering %s", __func__);
+    cnnNetworkPtr.reset();
+    mPlugin->releaseNetwork();
+    mNgraphNetCreator->releaseGraph();
+    const size_t released = mModelInfo->releaseModelData(releaseConstants);
+    mMemoryProfile.mark("release_build_data");
+    ALOGD("%s model %" PRIu64 " released %zu bytes of constants", __func__, mModelId, released);
+}
+
 static Return<void> notify(const sp<V1_0::IExecutionCallback>& callback, const ErrorStatus& status,
                            const hidl_vec<OutputShape>&, Timing) {
     return callback->notify(status);
@@ -71,6 +88,19 @@ static Return<void> notify(const sp<V1_3::IExecutionCallback>& callback, const E
     return callback->notify_1_3(convertToV1_3(status), outputShapes, timing);
 }
 
+// Executions cancelled by the loop timeout, MISSED_DEADLINE_TRANSIENT where the interface has it
+static Return<void> notifyLoopTimeout(const sp<V1_0::IExecutionCallback>& callback) {
+    return callback->notify(ErrorStatus::GENERAL_FAILURE);
+}
+
+static Return<void> notifyLoopTimeout(const sp<V1_2::IExecutionCallback>& callback) {
+    return callback->notify_1_2(ErrorStatus::GENERAL_FAILURE, {}, kNoTiming);
+}
+
+static Return<void> notifyLoopTimeout(const sp<V1_3::IExecutionCallback>& callback) {
+    return callback->notify_1_3(V1_3::ErrorStatus::MISSED_DEADLINE_TRANSIENT, {}, kNoTiming);
+}
+
 static void floatToUint8(const float* src, uint8_t* dst, size_t size) {
     for (uint32_t i = 0; i < size; ++i) {
         dst[i] = static_cast<uint8_t>(src[i]);
@@ -106,18 +136,59 @@ static void floatToUInt16(const float* src, uint16_t* dst, size_t size) {
     }
 }
 
+// Outputs the plugin returns as f32 blobs and copyOutputs narrows to the operand type
+static bool isConvertedOutput(OperandType type) {
+    switch (type) {
+        case OperandType::TENSOR_BOOL8:
+        case OperandType::TENSOR_QUANT8_ASYMM:
+        case OperandType::TENSOR_QUANT8_SYMM:
+        case OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL:
+        case OperandType::TENSOR_QUANT8_ASYMM_SIGNED:
+        case OperandType::TENSOR_FLOAT16:
+        case OperandType::TENSOR_QUANT16_SYMM:
+        case OperandType::TENSOR_QUANT16_ASYMM:
+            return true;
+        default:
+            return false;
+    }
+}
+
 namespace {
 using time_point = std::chrono::steady_clock::time_point;
 auto now() { return std::chrono::steady_clock::now(); };
 auto microsecondsDuration(decltype(now()) end, decltype(now()) start) {
     return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 };
+
+// The NNAPI default and upper bound of the time an execution may spend in WHILE loops, the
+// default also applying to the executions of the interfaces without a loop timeout
+constexpr std::chrono::nanoseconds kDefaultLoopTimeout = std::chrono::seconds(2);
+constexpr std::chrono::nanoseconds kMaxLoopTimeout = std::chrono::seconds(15);
+
+std::chrono::nanoseconds getLoopTimeout(const V1_3::OptionalTimeoutDuration& loopTimeoutDuration) {
+    if (loopTimeoutDuration.getDiscriminator() !=
+        V1_3::OptionalTimeoutDuration::hidl_discriminator::nanoseconds)
+        return kDefaultLoopTimeout;
+    return std::min(std::chrono::nanoseconds(loopTimeoutDuration.nanoseconds()), kMaxLoopTimeout);
+}
+
+// Runs the inference on request, cancelling the models with WHILE loops once loopTimeout
+// elapsed. Returns false when it was cancelled. The Loop runs inside the plugin's inference, so
+// unlike NNAPI, where it bounds the loops alone, loopTimeout bounds the whole inference.
+bool runInference(BasePreparedModel* preparedModel, InferenceEngine::InferRequest& request,
+                  std::chrono::nanoseconds loopTimeout) {
+    if (preparedModel->getModelInfo()->hasLoops())
+        return preparedModel->getPlugin()->infer(request, loopTimeout);
+    preparedModel->getPlugin()->infer(request);
+    return true;
+}
 }  // namespace
 
 template <typename T_IExecutionCallback>
 Return<ErrorStatus> executeBase(const Request& request, MeasureTiming measure,
                                 BasePreparedModel* preparedModel,
-                                const sp<T_IExecutionCallback>& callback) {
+                                const sp<T_IExecutionCallback>& callback,
+                                std::chrono::nanoseconds loopTimeout = kDefaultLoopTimeout) {
     ALOGV("Entering %s", __func__);
 
     time_point driverStart;
@@ -127,15 +198,15 @@ Return<ErrorStatus> executeBase(const Request& request, MeasureTiming measure,
         ALOGE("invalid callback passed to execute");
         return ErrorStatus::INVALID_ARGUMENT;
     }
-    if (!validateRequest(request, convertToV1_2(preparedModel->getModelInfo()->getModel()))) {
+    if (!preparedModel->getRequestValidator().validate(request)) {
         notify(callback, ErrorStatus::INVALID_ARGUMENT, {}, kNoTiming);
         return ErrorStatus::INVALID_ARGUMENT;
     }
 
     // This thread is intentionally detached because the driver service
     // is expected to live forever.
-    std::thread([preparedModel, request, measure, driverStart, callback] {
-        asyncExecute(request, measure, preparedModel, driverStart, callback);
+    std::thread([preparedModel, request, measure, driverStart, callback, loopTimeout] {
+        asyncExecute(request, measure, preparedModel, driverStart, callback, loopTimeout);
     }).detach();
     ALOGV("Exiting %s", __func__);
     return ErrorStatus::NONE;
@@ -143,32 +214,49 @@ Return<ErrorStatus> executeBase(const Request& request, MeasureTiming measure,
 
 template <typename T_IExecutionCallback>
 void asyncExecute(const Request& request, MeasureTiming measure, BasePreparedModel* preparedModel,
-                  time_point driverStart, const sp<T_IExecutionCallback>& callback) {
+                  time_point driverStart, const sp<T_IExecutionCallback>& callback,
+                  std::chrono::nanoseconds loopTimeout) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("asyncExecute", preparedModel->getModelId());
+    ExecutionMetrics::Execution execution(preparedModel->getMetrics(),
+                                          ExecutionMetrics::Path::ASYNC);
     auto modelInfo = preparedModel->getModelInfo();
     auto plugin = preparedModel->getPlugin();
     auto ngraphNw = preparedModel->getNgraphNwCreator();
     time_point driverEnd, deviceStart, deviceEnd;
-    std::vector<RunTimePoolInfo> requestPoolInfos;
-    auto errorStatus = modelInfo->setRunTimePoolInfosFromHidlMemories(request.pools);
+    ExecutionContext context;
+    TraceEvent poolTrace("mapPools");
+    auto errorStatus = modelInfo->setRunTimePoolInfosFromHidlMemories(request.pools, context);
     if (errorStatus != ErrorStatus::NONE) {
         ALOGE("Failed to set runtime pool info from HIDL memories");
         notify(callback, ErrorStatus::GENERAL_FAILURE, {}, kNoTiming);
         return;
     }
+    poolTrace.end();
+
+    // Held until the outputs are copied out of its blobs
+    InferRequestLease inferRequest(plugin);
 
+    TraceEvent inputTrace("copyInputs");
     for (size_t i = 0; i < request.inputs.size(); i++) {
         uint32_t len;
         auto inIndex = modelInfo->getModelInputIndex(i);
-        void* srcPtr = modelInfo->getBlobFromMemoryPoolIn(request, i, len);
-
+        void* srcPtr = modelInfo->getBlobFromMemoryPoolIn(request, i, len, context);
+
+        const std::string& stateSelector = ngraphNw->getStateSelector(inIndex);
+        if (stateSelector != "") {
+            // An omitted state input reads the state assigned by the previous execution
+            plugin->getBlob(inferRequest.get(), stateSelector)->buffer().as<uint8_t*>()[0] =
+                !request.inputs[i].hasNoValue;
+            if (request.inputs[i].hasNoValue) continue;
+        }
         const std::string& inputNodeName = ngraphNw->getNodeName(inIndex);
         if (inputNodeName == "") {
             ALOGD("Ignorning input at index(%d), since it is invalid", inIndex);
             continue;
         }
         ALOGD("Input index: %d layername : %s", inIndex, inputNodeName.c_str());
-        auto destBlob = plugin->getBlob(inputNodeName);
+        auto destBlob = plugin->getBlob(inferRequest.get(), inputNodeName);
         if (modelInfo->getOperandType(inIndex) == OperandType::TENSOR_FLOAT16) {
             float* dest = destBlob->buffer().as<float*>();
             _Float16* src = (_Float16*)srcPtr;
@@ -176,37 +264,53 @@ void asyncExecute(const Request& request, MeasureTiming measure, BasePreparedMod
             for (unsigned int i = 0; i < len / 2; i++) {
                 dest[i] = src[i];
             }
+            preparedModel->getMetrics().addBytes(len, true);
         } else {
             uint8_t* dest = destBlob->buffer().as<uint8_t*>();
             std::memcpy(dest, (uint8_t*)srcPtr, len);
+            preparedModel->getMetrics().addBytes(len, false);
         }
     }
+    inputTrace.end();
     ALOGD("%s Run", __func__);
 
+    TraceEvent inferTrace("infer");
     if (measure == MeasureTiming::YES) deviceStart = now();
+    bool completed;
     try {
-        plugin->infer();
+        completed = runInference(preparedModel, inferRequest.get(), loopTimeout);
     } catch (const std::exception& ex) {
         ALOGE("%s Exception !!! %s", __func__, ex.what());
         notify(callback, ErrorStatus::GENERAL_FAILURE, {}, kNoTiming);
         return;
     }
+    if (!completed) {
+        notifyLoopTimeout(callback);
+        return;
+    }
     if (measure == MeasureTiming::YES) deviceEnd = now();
+    inferTrace.end();
 
+    TraceEvent outputTrace("copyOutputs");
     for (size_t i = 0; i < request.outputs.size(); i++) {
         auto outIndex = modelInfo->getModelOutputIndex(i);
         ALOGI("OutputIndex: %d", outIndex);
+        // Such as the state output of a stateful model
+        if (request.outputs[i].hasNoValue) {
+            ALOGD("Ignoring output at index(%d), since it is omitted", outIndex);
+            continue;
+        }
         const std::string& outputNodeName = ngraphNw->getNodeName(outIndex);
         if (outputNodeName == "") {
             ALOGD("Ignorning output at index(%d), since it is invalid", outIndex);
             continue;
         }
         ALOGD("Output index: %d layername : %s", outIndex, outputNodeName.c_str());
-        auto srcBlob = plugin->getBlob(outputNodeName);
+        auto srcBlob = plugin->getBlob(inferRequest.get(), outputNodeName);
         auto operandType = modelInfo->getOperandType(outIndex);
         uint32_t actualLength = srcBlob->byteSize();
         uint32_t expectedLength = 0;
-        void* destPtr = modelInfo->getBlobFromMemoryPoolOut(request, i, expectedLength);
+        void* destPtr = modelInfo->getBlobFromMemoryPoolOut(request, i, expectedLength, context);
         auto outputBlobDims = srcBlob->getTensorDesc().getDims();
 
         ALOGD("output precision: %d", static_cast<int>(srcBlob->getTensorDesc().getPrecision()));
@@ -240,19 +344,20 @@ void asyncExecute(const Request& request, MeasureTiming measure, BasePreparedMod
         // output dimension is coming as 0
         if ((outputBlobDims.size() == 0) && (actualLength != 0)) {
             std::vector<size_t> rdims = {1};
-            modelInfo->updateOutputshapes(i, rdims, outputSizeMismatch ? false : true);
+            modelInfo->updateOutputshapes(context, i, rdims, !outputSizeMismatch);
         } else
-            modelInfo->updateOutputshapes(i, outputBlobDims, outputSizeMismatch ? false : true);
+            modelInfo->updateOutputshapes(context, i, outputBlobDims, !outputSizeMismatch);
 
         if (outputSizeMismatch) {
             ALOGE(
                 "Mismatch in actual and exepcted output sizes. Return with "
                 "OUTPUT_INSUFFICIENT_SIZE error");
-            notify(callback, ErrorStatus::OUTPUT_INSUFFICIENT_SIZE, modelInfo->getOutputShapes(),
+            notify(callback, ErrorStatus::OUTPUT_INSUFFICIENT_SIZE, context.outputShapes,
                    kNoTiming);
             return;
         }
 
+        preparedModel->getMetrics().addBytes(expectedLength, isConvertedOutput(operandType));
         switch (operandType) {
             case OperandType::TENSOR_INT32:
             case OperandType::TENSOR_FLOAT32: {
@@ -293,18 +398,21 @@ void asyncExecute(const Request& request, MeasureTiming measure, BasePreparedMod
         }
     }
 
-    if (!modelInfo->updateRequestPoolInfos()) {
+    if (!modelInfo->updateRequestPoolInfos(context)) {
         ALOGE("Failed to update the request pool infos");
     }
+    outputTrace.end();
+    execution.setSucceeded();
 
+    TraceEvent notifyTrace("notify");
     Return<void> returned;
     if (measure == MeasureTiming::YES) {
         driverEnd = now();
         Timing timing = {.timeOnDevice = uint64_t(microsecondsDuration(deviceEnd, deviceStart)),
                          .timeInDriver = uint64_t(microsecondsDuration(driverEnd, driverStart))};
-        returned = notify(callback, ErrorStatus::NONE, modelInfo->getOutputShapes(), timing);
+        returned = notify(callback, ErrorStatus::NONE, context.outputShapes, timing);
     } else {
-        returned = notify(callback, ErrorStatus::NONE, modelInfo->getOutputShapes(), kNoTiming);
+        returned = notify(callback, ErrorStatus::NONE, context.outputShapes, kNoTiming);
     }
     if (!returned.isOk()) {
         ALOGE("hidl callback failed to return properly: %s", returned.description().c_str());
@@ -312,33 +420,50 @@ void asyncExecute(const Request& request, MeasureTiming measure, BasePreparedMod
     ALOGV("Exiting %s", __func__);
 }
 
+// loopTimedOut, when given, is set when the execution was cancelled by the loop timeout
 static std::tuple<ErrorStatus, hidl_vec<V1_2::OutputShape>, Timing> executeSynchronouslyBase(
     const Request& request, MeasureTiming measure, BasePreparedModel* preparedModel,
-    time_point driverStart) {
+    time_point driverStart, std::chrono::nanoseconds loopTimeout = kDefaultLoopTimeout,
+    bool* loopTimedOut = nullptr) {
     ALOGV("Entering %s", __func__);
+    ExecutionMetrics::Execution execution(preparedModel->getMetrics(),
+                                          ExecutionMetrics::Path::SYNC);
     auto modelInfo = preparedModel->getModelInfo();
     auto plugin = preparedModel->getPlugin();
     auto ngraphNw = preparedModel->getNgraphNwCreator();
     time_point driverEnd, deviceStart, deviceEnd;
-    std::vector<RunTimePoolInfo> requestPoolInfos;
-    auto errorStatus = modelInfo->setRunTimePoolInfosFromHidlMemories(request.pools);
+    ExecutionContext context;
+    TraceEvent poolTrace("mapPools");
+    auto errorStatus = modelInfo->setRunTimePoolInfosFromHidlMemories(request.pools, context);
     if (errorStatus != ErrorStatus::NONE) {
         ALOGE("Failed to set runtime pool info from HIDL memories");
         return {ErrorStatus::GENERAL_FAILURE, {}, kNoTiming};
     }
+    poolTrace.end();
 
+    // Held until the outputs are copied out of its blobs
+    InferRequestLease inferRequest(plugin);
+
+    TraceEvent inputTrace("copyInputs");
     for (size_t i = 0; i < request.inputs.size(); i++) {
         uint32_t len;
         auto inIndex = modelInfo->getModelInputIndex(i);
-        void* srcPtr = modelInfo->getBlobFromMemoryPoolIn(request, i, len);
-
+        void* srcPtr = modelInfo->getBlobFromMemoryPoolIn(request, i, len, context);
+
+        const std::string& stateSelector = ngraphNw->getStateSelector(inIndex);
+        if (stateSelector != "") {
+            // An omitted state input reads the state assigned by the previous execution
+            plugin->getBlob(inferRequest.get(), stateSelector)->buffer().as<uint8_t*>()[0] =
+                !request.inputs[i].hasNoValue;
+            if (request.inputs[i].hasNoValue) continue;
+        }
         const std::string& inputNodeName = ngraphNw->getNodeName(inIndex);
         if (inputNodeName == "") {
             ALOGD("Ignorning input at index(%d), since it is invalid", inIndex);
             continue;
         }
         ALOGD("Input index: %d layername : %s", inIndex, inputNodeName.c_str());
-        auto destBlob = plugin->getBlob(inputNodeName);
+        auto destBlob = plugin->getBlob(inferRequest.get(), inputNodeName);
         if (modelInfo->getOperandType(inIndex) == OperandType::TENSOR_FLOAT16) {
             float* dest = destBlob->buffer().as<float*>();
             _Float16* src = (_Float16*)srcPtr;
@@ -346,37 +471,53 @@ static std::tuple<ErrorStatus, hidl_vec<V1_2::OutputShape>, Timing> executeSynch
             for (unsigned int i = 0; i < len / 2; i++) {
                 dest[i] = src[i];
             }
+            preparedModel->getMetrics().addBytes(len, true);
         } else {
             uint8_t* dest = destBlob->buffer().as<uint8_t*>();
             std::memcpy(dest, (uint8_t*)srcPtr, len);
+            preparedModel->getMetrics().addBytes(len, false);
         }
     }
+    inputTrace.end();
 
     ALOGD("%s Run", __func__);
 
+    TraceEvent inferTrace("infer");
     if (measure == MeasureTiming::YES) deviceStart = now();
+    bool completed;
     try {
-        plugin->infer();
+        completed = runInference(preparedModel, inferRequest.get(), loopTimeout);
     } catch (const std::exception& ex) {
         ALOGE("%s Exception !!! %s", __func__, ex.what());
         return {ErrorStatus::GENERAL_FAILURE, {}, kNoTiming};
     }
+    if (!completed) {
+        if (loopTimedOut) *loopTimedOut = true;
+        return {ErrorStatus::GENERAL_FAILURE, {}, kNoTiming};
+    }
     if (measure == MeasureTiming::YES) deviceEnd = now();
+    inferTrace.end();
 
+    TraceEvent outputTrace("copyOutputs");
     for (size_t i = 0; i < request.outputs.size(); i++) {
         auto outIndex = modelInfo->getModelOutputIndex(i);
         ALOGI("OutputIndex: %d", outIndex);
+        // Such as the state output of a stateful model
+        if (request.outputs[i].hasNoValue) {
+            ALOGD("Ignoring output at index(%d), since it is omitted", outIndex);
+            continue;
+        }
         const std::string& outputNodeName = ngraphNw->getNodeName(outIndex);
         if (outputNodeName == "") {
             ALOGD("Ignorning output at index(%d), since it is invalid", outIndex);
             continue;
         }
         ALOGD("Output index: %d layername : %s", outIndex, outputNodeName.c_str());
-        auto srcBlob = plugin->getBlob(outputNodeName);
+        auto srcBlob = plugin->getBlob(inferRequest.get(), outputNodeName);
         auto operandType = modelInfo->getOperandType(outIndex);
         uint32_t actualLength = srcBlob->byteSize();
         uint32_t expectedLength = 0;
-        void* destPtr = modelInfo->getBlobFromMemoryPoolOut(request, i, expectedLength);
+        void* destPtr = modelInfo->getBlobFromMemoryPoolOut(request, i, expectedLength, context);
         auto outputBlobDims = srcBlob->getTensorDesc().getDims();
 
         ALOGD("output precision: %d", static_cast<int>(srcBlob->getTensorDesc().getPrecision()));
@@ -410,17 +551,18 @@ static std::tuple<ErrorStatus, hidl_vec<V1_2::OutputShape>, Timing> executeSynch
         // output dimension is coming as 0
         if ((outputBlobDims.size() == 0) && (actualLength != 0)) {
             std::vector<size_t> rdims = {1};
-            modelInfo->updateOutputshapes(i, rdims, outputSizeMismatch ? false : true);
+            modelInfo->updateOutputshapes(context, i, rdims, !outputSizeMismatch);
         } else
-            modelInfo->updateOutputshapes(i, outputBlobDims, outputSizeMismatch ? false : true);
+            modelInfo->updateOutputshapes(context, i, outputBlobDims, !outputSizeMismatch);
 
         if (outputSizeMismatch) {
             ALOGE(
                 "Mismatch in actual and exepcted output sizes. Return with "
                 "OUTPUT_INSUFFICIENT_SIZE error");
-            return {ErrorStatus::OUTPUT_INSUFFICIENT_SIZE, modelInfo->getOutputShapes(), kNoTiming};
+            return {ErrorStatus::OUTPUT_INSUFFICIENT_SIZE, context.outputShapes, kNoTiming};
         }
 
+        preparedModel->getMetrics().addBytes(expectedLength, isConvertedOutput(operandType));
         switch (operandType) {
             case OperandType::TENSOR_INT32:
             case OperandType::TENSOR_FLOAT32: {
@@ -461,54 +603,60 @@ static std::tuple<ErrorStatus, hidl_vec<V1_2::OutputShape>, Timing> executeSynch
         }
     }
 
-    if (!modelInfo->updateRequestPoolInfos()) {
+    if (!modelInfo->updateRequestPoolInfos(context)) {
         ALOGE("Failed to update the request pool infos");
         return {ErrorStatus::GENERAL_FAILURE, {}, kNoTiming};
     }
+    execution.setSucceeded();
 
     if (measure == MeasureTiming::YES) {
         driverEnd = now();
         Timing timing = {.timeOnDevice = uint64_t(microsecondsDuration(deviceEnd, deviceStart)),
                          .timeInDriver = uint64_t(microsecondsDuration(driverEnd, driverStart))};
-        return {ErrorStatus::NONE, modelInfo->getOutputShapes(), timing};
+        return {ErrorStatus::NONE, context.outputShapes, timing};
     }
     ALOGV("Exiting %s", __func__);
-    return {ErrorStatus::NONE, modelInfo->getOutputShapes(), kNoTiming};
+    return {ErrorStatus::NONE, context.outputShapes, kNoTiming};
 }
 
 Return<void> BasePreparedModel::executeSynchronously(const Request& request, MeasureTiming measure,
                                                      executeSynchronously_cb cb) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("executeSynchronously", mModelId);
     time_point driverStart;
     if (measure == MeasureTiming::YES) driverStart = now();
 
-    if (!validateRequest(request, convertToV1_2(mModelInfo->getModel()))) {
+    if (!mRequestValidator.validate(request)) {
         cb(ErrorStatus::INVALID_ARGUMENT, {}, kNoTiming);
         return Void();
     }
     auto [status, outputShapes, timing] =
         executeSynchronouslyBase(request, measure, this, driverStart);
+    TraceEvent callbackTrace("callback");
     cb(status, std::move(outputShapes), timing);
     ALOGV("Exiting %s", __func__);
     return Void();
 }
 
-Return<void> BasePreparedModel::executeSynchronously_1_3(const V1_3::Request& request,
-                                                         V1_2::MeasureTiming measure,
-                                                         const V1_3::OptionalTimePoint&,
-                                                         const V1_3::OptionalTimeoutDuration&,
-                                                         executeSynchronously_1_3_cb cb) {
+Return<void> BasePreparedModel::executeSynchronously_1_3(
+    const V1_3::Request& request, V1_2::MeasureTiming measure, const V1_3::OptionalTimePoint&,
+    const V1_3::OptionalTimeoutDuration& loopTimeoutDuration, executeSynchronously_1_3_cb cb) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("executeSynchronously", mModelId);
     time_point driverStart;
     if (measure == MeasureTiming::YES) driverStart = now();
 
-    if (!validateRequest(convertToV1_0(request), convertToV1_2(mModelInfo->getModel()))) {
+    if (!mRequestValidator.validate(request)) {
         cb(V1_3::ErrorStatus::INVALID_ARGUMENT, {}, kNoTiming);
         return Void();
     }
+    bool loopTimedOut = false;
     auto [status, outputShapes, timing] =
-        executeSynchronouslyBase(convertToV1_0(request), measure, this, driverStart);
-    cb(convertToV1_3(status), std::move(outputShapes), timing);
+        executeSynchronouslyBase(convertToV1_0(request), measure, this, driverStart,
+                                 getLoopTimeout(loopTimeoutDuration), &loopTimedOut);
+    TraceEvent callbackTrace("callback");
+    cb(loopTimedOut ? V1_3::ErrorStatus::MISSED_DEADLINE_TRANSIENT : convertToV1_3(status),
+       std::move(outputShapes), timing);
     ALOGV("Exiting %s", __func__);
     return Void();
 }
@@ -546,24 +694,25 @@ Return<ErrorStatus> BasePreparedModel::execute_1_2(const Request& request, Measu
 
 Return<V1_3::ErrorStatus> BasePreparedModel::execute_1_3(
     const V1_3::Request& request, V1_2::MeasureTiming measure, const V1_3::OptionalTimePoint&,
-    const V1_3::OptionalTimeoutDuration&, const sp<V1_3::IExecutionCallback>& callback) {
+    const V1_3::OptionalTimeoutDuration& loopTimeoutDuration,
+    const sp<V1_3::IExecutionCallback>& callback) {
     ALOGV("Entering %s", __func__);
-    return convertToV1_3(executeBase(convertToV1_0(request), measure, this, callback));
+    return convertToV1_3(executeBase(convertToV1_0(request), measure, this, callback,
+                                     getLoopTimeout(loopTimeoutDuration)));
 }
 
-Return<void> BasePreparedModel::executeFenced(const V1_3::Request& request1_3,
-                                              const hidl_vec<hidl_handle>& waitFor,
-                                              V1_2::MeasureTiming measure,
-                                              const V1_3::OptionalTimePoint& halDeadline,
-                                              const V1_3::OptionalTimeoutDuration&,
-                                              const V1_3::OptionalTimeoutDuration& duration,
-                                              executeFenced_cb cb) {
+Return<void> BasePreparedModel::executeFenced(
+    const V1_3::Request& request1_3, const hidl_vec<hidl_handle>& waitFor,
+    V1_2::MeasureTiming measure, const V1_3::OptionalTimePoint& halDeadline,
+    const V1_3::OptionalTimeoutDuration& loopTimeoutDuration,
+    const V1_3::OptionalTimeoutDuration& duration, executeFenced_cb cb) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("executeFenced", mModelId);
 
     time_point driverStart, driverEnd;
     if (measure == MeasureTiming::YES) driverStart = now();
 
-    if (!validateRequest(request1_3, mModelInfo->getModel(), /*allowUnspecifiedOutput=*/false)) {
+    if (!mRequestValidator.validate(request1_3, /*allowUnspecifiedOutput=*/false)) {
         cb(V1_3::ErrorStatus::INVALID_ARGUMENT, hidl_handle(nullptr), nullptr);
         return Void();
     }
@@ -575,6 +724,7 @@ Return<void> BasePreparedModel::executeFenced(const V1_3::Request& request1_3,
     }
 
     // Wait for the dependent events to signal
+    TraceEvent fenceTrace("waitForFences");
     for (const auto& fenceHandle : waitFor) {
         if (!fenceHandle.getNativeHandle()) {
             cb(V1_3::ErrorStatus::INVALID_ARGUMENT, hidl_handle(nullptr), nullptr);
@@ -588,31 +738,50 @@ Return<void> BasePreparedModel::executeFenced(const V1_3::Request& request1_3,
         }
     }
 
-    auto errorStatus = mModelInfo->setRunTimePoolInfosFromHidlMemories(request1_3.pools);
+    fenceTrace.end();
+
+    // Fence waits are left out of the latency, they depend on the other executions only
+    ExecutionMetrics::Execution execution(mMetrics, ExecutionMetrics::Path::FENCED);
+    ExecutionContext context;
+    TraceEvent poolTrace("mapPools");
+    auto errorStatus = mModelInfo->setRunTimePoolInfosFromHidlMemories(request1_3.pools, context);
     if (errorStatus != V1_3::ErrorStatus::NONE) {
         ALOGE("Failed to set runtime pool info from HIDL memories");
         cb(errorStatus, hidl_handle(nullptr), nullptr);
         return Void();
     }
 
+    poolTrace.end();
+
+    // Held until the outputs are copied out of its blobs
+    InferRequestLease inferRequest(mPlugin);
+
     // rest of the interfaces are based on 1.0 request
     auto request = convertToV1_0(request1_3);
 
     time_point driverAfterFence;
     if (measure == MeasureTiming::YES) driverAfterFence = now();
 
+    TraceEvent inputTrace("copyInputs");
     for (size_t i = 0; i < request.inputs.size(); i++) {
         uint32_t len;
         auto inIndex = mModelInfo->getModelInputIndex(i);
-        void* srcPtr = mModelInfo->getBlobFromMemoryPoolIn(request, i, len);
-
+        void* srcPtr = mModelInfo->getBlobFromMemoryPoolIn(request, i, len, context);
+
+        const std::string& stateSelector = mNgraphNetCreator->getStateSelector(inIndex);
+        if (stateSelector != "") {
+            // An omitted state input reads the state assigned by the previous execution
+            mPlugin->getBlob(inferRequest.get(), stateSelector)->buffer().as<uint8_t*>()[0] =
+                !request.inputs[i].hasNoValue;
+            if (request.inputs[i].hasNoValue) continue;
+        }
         const std::string& inputNodeName = mNgraphNetCreator->getNodeName(inIndex);
         if (inputNodeName == "") {
             ALOGD("Ignorning input at index(%d), since it is invalid", inIndex);
             continue;
         }
         ALOGD("Input index: %d layername : %s", inIndex, inputNodeName.c_str());
-        auto destBlob = mPlugin->getBlob(inputNodeName);
+        auto destBlob = mPlugin->getBlob(inferRequest.get(), inputNodeName);
         if (mModelInfo->getOperandType(inIndex) == OperandType::TENSOR_FLOAT16) {
             float* dest = destBlob->buffer().as<float*>();
             _Float16* src = (_Float16*)srcPtr;
@@ -620,39 +789,55 @@ Return<void> BasePreparedModel::executeFenced(const V1_3::Request& request1_3,
             for (unsigned int i = 0; i < len / 2; i++) {
                 dest[i] = src[i];
             }
+            mMetrics.addBytes(len, true);
         } else {
             uint8_t* dest = destBlob->buffer().as<uint8_t*>();
             std::memcpy(dest, (uint8_t*)srcPtr, len);
+            mMetrics.addBytes(len, false);
         }
     }
 
+    inputTrace.end();
     ALOGD("%s Run", __func__);
 
     time_point deviceStart, deviceEnd;
+    TraceEvent inferTrace("infer");
     if (measure == MeasureTiming::YES) deviceStart = now();
+    bool completed;
     try {
-        mPlugin->infer();
+        completed = runInference(this, inferRequest.get(), getLoopTimeout(loopTimeoutDuration));
     } catch (const std::exception& ex) {
         ALOGE("%s Exception !!! %s", __func__, ex.what());
         cb(V1_3::ErrorStatus::GENERAL_FAILURE, hidl_handle(nullptr), nullptr);
         return Void();
     }
+    if (!completed) {
+        cb(V1_3::ErrorStatus::MISSED_DEADLINE_TRANSIENT, hidl_handle(nullptr), nullptr);
+        return Void();
+    }
     if (measure == MeasureTiming::YES) deviceEnd = now();
+    inferTrace.end();
 
+    TraceEvent outputTrace("copyOutputs");
     for (size_t i = 0; i < request.outputs.size(); i++) {
         auto outIndex = mModelInfo->getModelOutputIndex(i);
         ALOGI("OutputIndex: %d", outIndex);
+        // Such as the state output of a stateful model
+        if (request.outputs[i].hasNoValue) {
+            ALOGD("Ignoring output at index(%d), since it is omitted", outIndex);
+            continue;
+        }
         const std::string& outputNodeName = mNgraphNetCreator->getNodeName(outIndex);
         if (outputNodeName == "") {
             ALOGD("Ignorning output at index(%d), since it is invalid", outIndex);
             continue;
         }
         ALOGD("Output index: %d layername : %s", outIndex, outputNodeName.c_str());
-        auto srcBlob = mPlugin->getBlob(outputNodeName);
+        auto srcBlob = mPlugin->getBlob(inferRequest.get(), outputNodeName);
         auto operandType = mModelInfo->getOperandType(outIndex);
         uint32_t actualLength = srcBlob->byteSize();
         uint32_t expectedLength = 0;
-        void* destPtr = mModelInfo->getBlobFromMemoryPoolOut(request, i, expectedLength);
+        void* destPtr = mModelInfo->getBlobFromMemoryPoolOut(request, i, expectedLength, context);
         auto outDims = srcBlob->getTensorDesc().getDims();
         switch (operandType) {
             case OperandType::TENSOR_BOOL8:
@@ -675,12 +860,13 @@ Return<void> BasePreparedModel::executeFenced(const V1_3::Request& request1_3,
         if (actualLength != expectedLength) {
             ALOGE("%s Invalid length(%d) at outIndex(%d)", __func__, actualLength, outIndex);
             // Notify Insufficient Buffer Length to modelInfo
-            mModelInfo->updateOutputshapes(i, outDims, false);
+            mModelInfo->updateOutputshapes(context, i, outDims, false);
             cb(V1_3::ErrorStatus::OUTPUT_INSUFFICIENT_SIZE, hidl_handle(nullptr), nullptr);
             return Void();
         } else {
-            mModelInfo->updateOutputshapes(i, outDims);
+            mModelInfo->updateOutputshapes(context, i, outDims);
         }
+        mMetrics.addBytes(expectedLength, isConvertedOutput(operandType));
         switch (operandType) {
             case OperandType::TENSOR_INT32:
             case OperandType::TENSOR_FLOAT32: {
@@ -721,9 +907,11 @@ Return<void> BasePreparedModel::executeFenced(const V1_3::Request& request1_3,
         }
     }
 
-    if (!mModelInfo->updateRequestPoolInfos()) {
+    if (!mModelInfo->updateRequestPoolInfos(context)) {
         ALOGE("Failed to update the request pool infos");
     }
+    outputTrace.end();
+    execution.setSucceeded();
 
     Timing timingSinceLaunch = {.timeOnDevice = UINT64_MAX, .timeInDriver = UINT64_MAX};
     Timing timingAfterFence = {.timeOnDevice = UINT64_MAX, .timeInDriver = UINT64_MAX};
@@ -740,11 +928,34 @@ Return<void> BasePreparedModel::executeFenced(const V1_3::Request& request1_3,
 
     sp<BaseFencedExecutionCallback> fencedExecutionCallback = new BaseFencedExecutionCallback(
         timingSinceLaunch, timingAfterFence, V1_3::ErrorStatus::NONE);
+    TraceEvent callbackTrace("callback");
     cb(V1_3::ErrorStatus::NONE, hidl_handle(nullptr), fencedExecutionCallback);
     ALOGV("Exiting %s", __func__);
     return Void();
 }
 
+void BasePreparedModel::dumpState(int fd) {
+    dprintf(fd, "fingerprint %016llx, device %s, preference %s\nmemory %s%s",
+            (unsigned long long)mFingerprint, getDeviceTypeName(mTargetDevice),
+            getExecutionProfileName(mPreference), mMemoryProfile.toString().c_str(),
+            mMetrics.toString().c_str());
+}
+
+void BasePreparedModel::resetState() {
+    if (!mStateful) return;
+    mPlugin->resetState();
+    ALOGI("%s model %" PRIu64, __func__, mModelId);
+}
+
+Return<void> BasePreparedModel::debug(const hidl_handle& fd,
+                                      const hidl_vec<hidl_string>& options) {
+    if (std::find(options.begin(), options.end(), kResetStateOption) != options.end())
+        resetState();
+    if (fd.getNativeHandle() == nullptr || fd->numFds < 1) return Void();
+    dumpState(fd->data[0]);
+    return Void();
+}
+
 }  // namespace nnhal
 }  // namespace neuralnetworks
 }  // namespace hardware
@@ -31,8 +31,13 @@
 
 #include <NgraphNetworkCreator.hpp>
 #include "Driver.h"
+#include "DriverConfig.h"
+#include "ExecutionMetrics.h"
 #include "IENetwork.h"
+#include "MemoryProfile.h"
 #include "ModelManager.h"
+#include "RequestValidator.h"
+#include "Tracing.h"
 #include "utils.h"
 
 #if __ANDROID__
@@ -52,13 +57,22 @@ template <class T>
 using vec = std::vector<T>;
 typedef uint8_t* memory;
 
+// Option of the prepared model's debug() that resets its state variables
+constexpr char kResetStateOption[] = "--reset-state";
+
 class BasePreparedModel : public V1_3::IPreparedModel {
 public:
     BasePreparedModel(const Model& model) : mTargetDevice(IntelDeviceType::CPU) {
+        if (getDriverConfig().profileMemory) mMemoryProfile.start();
         mModelInfo = std::make_shared<NnapiModelInfo>(model);
+        mRequestValidator = RequestValidator(*mModelInfo);
+        mMemoryProfile.mark("model_copy");
     }
     BasePreparedModel(const IntelDeviceType device, const Model& model) : mTargetDevice(device) {
+        if (getDriverConfig().profileMemory) mMemoryProfile.start();
         mModelInfo = std::make_shared<NnapiModelInfo>(model);
+        mRequestValidator = RequestValidator(*mModelInfo);
+        mMemoryProfile.mark("model_copy");
     }
 
     virtual ~BasePreparedModel() { deinitialize(); }
@@ -87,6 +101,12 @@ public:
                                const V1_3::OptionalTimeoutDuration& loopTimeoutDuration,
                                const V1_3::OptionalTimeoutDuration& duration,
                                executeFenced_cb cb) override;
+    // Dumps the state written by dumpState(), after resetting the state variables when the
+    // options hold kResetStateOption
+    Return<void> debug(const hidl_handle& fd, const hidl_vec<hidl_string>& options) override;
+    // Writes the fingerprint, device, preference, preparation memory profile and execution
+    // metrics of the model to fd. Also used by the Driver dump.
+    void dumpState(int fd);
 
     virtual bool initialize();
 
@@ -96,15 +116,58 @@ public:
 
     std::shared_ptr<IIENetwork> getPlugin() { return mPlugin; }
 
+    const RequestValidator& getRequestValidator() { return mRequestValidator; }
+
+    // Set when a cached getSupportedOperations verdict already covers every operation of the
+    // model, so initialize() can skip validating them again.
+    void setOperationsValidated(bool validated) { mOperationsValidated = validated; }
+
+    // Unique within the process, tags the trace events of this model
+    uint64_t getModelId() { return mModelId; }
+
+    void setFingerprint(uint64_t fingerprint) { mFingerprint = fingerprint; }
+    uint64_t getFingerprint() { return mFingerprint; }
+
+    // Selects the plugin performance profile, must be set before initialize()
+    void setExecutionPreference(V1_1::ExecutionPreference preference) {
+        mPreference = preference;
+    }
+    V1_1::ExecutionPreference getExecutionPreference() { return mPreference; }
+
+    // Started when the prepared model is constructed. initialize() marks its stages and the
+    // Driver finishes the profile once initialize() returned and released its temporaries.
+    MemoryProfile& getMemoryProfile() { return mMemoryProfile; }
+
+    ExecutionMetrics& getMetrics() { return mMetrics; }
+
+    // Sets the state variables back to zeros, once the running execution completed, as the
+    // plugin gives a stateful model a single InferRequest
+    void resetState();
+
     std::shared_ptr<InferenceEngine::CNNNetwork> cnnNetworkPtr;
 
 protected:
     virtual void deinitialize();
+    // Called by initialize() once the network is loaded: drops the CNNNetwork, the graph builder
+    // and the Model data executions do not read, with the constants when the plugin copied them
+    void releaseBuildData(bool releaseConstants);
 
     IntelDeviceType mTargetDevice;
     std::shared_ptr<NnapiModelInfo> mModelInfo;
     std::shared_ptr<NgraphNetworkCreator> mNgraphNetCreator;
     std::shared_ptr<IIENetwork> mPlugin;
+    bool mOperationsValidated = false;
+    uint64_t mFingerprint = 0;
+    V1_1::ExecutionPreference mPreference = V1_1::ExecutionPreference::FAST_SINGLE_ANSWER;
+    MemoryProfile mMemoryProfile;
+    RequestValidator mRequestValidator;
+    ExecutionMetrics mMetrics;
+    const uint64_t mModelId = nextModelId();
+    // Set by initialize() when the model keeps state variables in the plugin
+    bool mStateful = false;
+
+private:
+    static uint64_t nextModelId();
 };
 
 class BaseFencedExecutionCallback : public V1_3::IFencedExecutionCallback {
@@ -0,0 +1,546 @@
+#include "DeviceCapabilities.h"
+
+#include <CpuExecutor.h>
+#include <NeuralNetworks.h>
+#include <ie_version.hpp>
+#include <log/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <ngraph/ngraph.hpp>
+#include <ngraph/opsets/opset3.hpp>
+#include <sstream>
+#include <vector>
+
+#include "DriverConfig.h"
+#include "IENetwork.h"
+
+#undef LOG_TAG
+#define LOG_TAG "DeviceCapabilities"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+// Bumped whenever the calibration kernels change, so that older results are measured again
+constexpr int kCalibrationVersion = 2;
+
+// A 3x3 same padded convolution of a 1x16x32x32 NCHW input to 16 channels, the shape of the
+// bulk of the work in the vision models the partitioner weighs
+constexpr size_t kChannels = 16;
+constexpr size_t kSize = 32;
+constexpr size_t kKernel = 3;
+constexpr size_t kTensorSize = kChannels * kSize * kSize;
+constexpr size_t kFilterSize = kChannels * kChannels * kKernel * kKernel;
+
+constexpr int kWarmup = 3;
+constexpr int kIterations = 15;
+
+// Measured ratios are clamped, a plugin hiccup must not make the device look free or unusable
+constexpr float kMinRatio = 0.01f;
+constexpr float kMaxRatio = 10.f;
+
+// Quantization of the quant8 variant, the same for the input, filter and output grids
+constexpr float kQuantScale = 1.f / 64;
+constexpr int32_t kQuantZeroPoint = 128;
+
+enum class OperandClass { FLOAT32, FLOAT16, QUANT8 };
+
+struct ConvData {
+    std::vector<float> filter, bias;
+    std::vector<uint8_t> quantFilter;
+    std::vector<int32_t> quantBias;
+    std::vector<float> input, output;
+    std::vector<_Float16> halfInput, halfOutput;
+    std::vector<uint8_t> quantInput, quantOutput;
+
+    ConvData()
+        : filter(kFilterSize),
+          bias(kChannels),
+          quantFilter(kFilterSize),
+          quantBias(kChannels),
+          input(kTensorSize),
+          output(kTensorSize),
+          halfInput(kTensorSize),
+          halfOutput(kTensorSize),
+          quantInput(kTensorSize),
+          quantOutput(kTensorSize) {
+        // Deterministic values in [-1, 1), exactly representable on the quantized grid
+        uint32_t state = 1;
+        auto next = [&state]() {
+            state = state * 1103515245u + 12345u;
+            return static_cast<int32_t>((state >> 16) % 128) - 64;
+        };
+        for (size_t i = 0; i < kFilterSize; i++) {
+            const int32_t value = next();
+            quantFilter[i] = static_cast<uint8_t>(value + kQuantZeroPoint);
+            filter[i] = value * kQuantScale;
+        }
+        for (size_t i = 0; i < kChannels; i++) {
+            quantBias[i] = next();
+            bias[i] = quantBias[i] * kQuantScale * kQuantScale;
+        }
+        for (size_t i = 0; i < kTensorSize; i++) {
+            const int32_t value = next();
+            quantInput[i] = static_cast<uint8_t>(value + kQuantZeroPoint);
+            input[i] = value * kQuantScale;
+            halfInput[i] = input[i];
+        }
+    }
+};
+
+template <typename T_Run>
+double medianUs(T_Run run) {
+    for (int i = 0; i < kWarmup; i++) run();
+    std::vector<double> times;
+    times.reserve(kIterations);
+    for (int i = 0; i < kIterations; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        times.push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+// Appends an operand to the main subgraph of model, copying value into the model when given
+template <typename T>
+uint32_t addOperand(V1_3::Model& model, OperandType type, const std::vector<uint32_t>& dimensions,
+                    OperandLifeTime lifetime, const std::vector<T>& value = {}, float scale = 0.f,
+                    int32_t zeroPoint = 0) {
+    Operand operand = {};
+    operand.type = type;
+    operand.dimensions = dimensions;
+    operand.scale = scale;
+    operand.zeroPoint = zeroPoint;
+    operand.lifetime = lifetime;
+    if (lifetime == OperandLifeTime::CONSTANT_COPY) {
+        // Kept 4 byte aligned, the executor reads the values in place
+        std::vector<uint8_t> values = model.operandValues;
+        const uint32_t offset = (values.size() + 3) & ~3u;
+        const uint32_t length = value.size() * sizeof(T);
+        values.resize(offset + length);
+        std::memcpy(values.data() + offset, value.data(), length);
+        model.operandValues = values;
+        operand.location = {.poolIndex = 0, .offset = offset, .length = length};
+    }
+    std::vector<Operand> operands = model.main.operands;
+    operands.push_back(operand);
+    model.main.operands = operands;
+    return operands.size() - 1;
+}
+
+// The CONV_2D of the operand class as the runtime hands it to its own CPU path, in the NHWC
+// layout of that path. Only the timing is compared, so the NCHW data is reused as is.
+V1_3::Model createConvModel(OperandClass operandClass, const ConvData& data) {
+    const std::vector<uint32_t> tensorDims = {1, kSize, kSize, kChannels};
+    const std::vector<uint32_t> filterDims = {kChannels, kKernel, kKernel, kChannels};
+    V1_3::Model model;
+    uint32_t input, filter, bias, output;
+    switch (operandClass) {
+        case OperandClass::FLOAT16: {
+            const std::vector<_Float16> halfFilter(data.filter.begin(), data.filter.end());
+            const std::vector<_Float16> halfBias(data.bias.begin(), data.bias.end());
+            input = addOperand<_Float16>(model, OperandType::TENSOR_FLOAT16, tensorDims,
+                                         OperandLifeTime::SUBGRAPH_INPUT);
+            filter = addOperand(model, OperandType::TENSOR_FLOAT16, filterDims,
+                                OperandLifeTime::CONSTANT_COPY, halfFilter);
+            bias = addOperand(model, OperandType::TENSOR_FLOAT16, {kChannels},
+                              OperandLifeTime::CONSTANT_COPY, halfBias);
+            output = addOperand<_Float16>(model, OperandType::TENSOR_FLOAT16, tensorDims,
+                                          OperandLifeTime::SUBGRAPH_OUTPUT);
+            break;
+        }
+        case OperandClass::QUANT8:
+            input = addOperand<uint8_t>(model, OperandType::TENSOR_QUANT8_ASYMM, tensorDims,
+                                        OperandLifeTime::SUBGRAPH_INPUT, {}, kQuantScale,
+                                        kQuantZeroPoint);
+            filter = addOperand(model, OperandType::TENSOR_QUANT8_ASYMM, filterDims,
+                                OperandLifeTime::CONSTANT_COPY, data.quantFilter, kQuantScale,
+                                kQuantZeroPoint);
+            bias = addOperand(model, OperandType::TENSOR_INT32, {kChannels},
+                              OperandLifeTime::CONSTANT_COPY, data.quantBias,
+                              kQuantScale * kQuantScale);
+            output = addOperand<uint8_t>(model, OperandType::TENSOR_QUANT8_ASYMM, tensorDims,
+                                         OperandLifeTime::SUBGRAPH_OUTPUT, {}, kQuantScale,
+                                         kQuantZeroPoint);
+            break;
+        case OperandClass::FLOAT32:
+        default:
+            input = addOperand<float>(model, OperandType::TENSOR_FLOAT32, tensorDims,
+                                      OperandLifeTime::SUBGRAPH_INPUT);
+            filter = addOperand(model, OperandType::TENSOR_FLOAT32, filterDims,
+                                OperandLifeTime::CONSTANT_COPY, data.filter);
+            bias = addOperand(model, OperandType::TENSOR_FLOAT32, {kChannels},
+                              OperandLifeTime::CONSTANT_COPY, data.bias);
+            output = addOperand<float>(model, OperandType::TENSOR_FLOAT32, tensorDims,
+                                       OperandLifeTime::SUBGRAPH_OUTPUT);
+            break;
+    }
+    // SAME padding, unit strides and no fused activation
+    const uint32_t padding = addOperand(model, OperandType::INT32, {},
+                                        OperandLifeTime::CONSTANT_COPY, std::vector<int32_t>{1});
+    const uint32_t stride = addOperand(model, OperandType::INT32, {},
+                                       OperandLifeTime::CONSTANT_COPY, std::vector<int32_t>{1});
+    const uint32_t activation = addOperand(model, OperandType::INT32, {},
+                                           OperandLifeTime::CONSTANT_COPY, std::vector<int32_t>{0});
+
+    std::vector<Operand> operands = model.main.operands;
+    for (uint32_t index : {input, filter, bias, padding, stride, stride, activation})
+        operands[index].numberOfConsumers++;
+    model.main.operands = operands;
+    model.main.operations = std::vector<Operation>{
+        {.type = OperationType::CONV_2D,
+         .inputs = {input, filter, bias, padding, stride, stride, activation},
+         .outputs = {output}}};
+    model.main.inputIndexes = std::vector<uint32_t>{input};
+    model.main.outputIndexes = std::vector<uint32_t>{output};
+    return model;
+}
+
+// Times the convolution on the CpuExecutor of the NNAPI common library, the CPU path the runtime
+// falls back to for the operations a driver does not take
+double cpuExecutorUs(OperandClass operandClass, ConvData& data) {
+    const V1_3::Model model = createConvModel(operandClass, data);
+    uint8_t *input, *output;
+    uint32_t length;
+    switch (operandClass) {
+        case OperandClass::FLOAT16:
+            input = reinterpret_cast<uint8_t*>(data.halfInput.data());
+            output = reinterpret_cast<uint8_t*>(data.halfOutput.data());
+            length = kTensorSize * sizeof(_Float16);
+            break;
+        case OperandClass::QUANT8:
+            input = data.quantInput.data();
+            output = data.quantOutput.data();
+            length = kTensorSize;
+            break;
+        case OperandClass::FLOAT32:
+        default:
+            input = reinterpret_cast<uint8_t*>(data.input.data());
+            output = reinterpret_cast<uint8_t*>(data.output.data());
+            length = kTensorSize * sizeof(float);
+            break;
+    }
+
+    V1_3::Request request;
+    request.inputs = std::vector<V1_0::RequestArgument>{
+        {.hasNoValue = false, .location = {.poolIndex = 0, .offset = 0, .length = length}}};
+    request.outputs = std::vector<V1_0::RequestArgument>{
+        {.hasNoValue = false, .location = {.poolIndex = 1, .offset = 0, .length = length}}};
+    request.pools.resize(2);
+    const std::vector<android::nn::RunTimePoolInfo> requestPoolInfos = {
+        android::nn::RunTimePoolInfo::createFromExistingBuffer(input, length),
+        android::nn::RunTimePoolInfo::createFromExistingBuffer(output, length)};
+
+    int status = ANEURALNETWORKS_NO_ERROR;
+    const double us = medianUs([&]() {
+        if (status != ANEURALNETWORKS_NO_ERROR) return;
+        android::nn::CpuExecutor executor;
+        status = executor.run(model, request, {}, requestPoolInfos);
+    });
+    if (status != ANEURALNETWORKS_NO_ERROR) {
+        ALOGE("%s CpuExecutor failed with %d", __func__, status);
+        return 0;
+    }
+    return us;
+}
+
+std::shared_ptr<ngraph::Node> createConstant(const std::vector<float>& values,
+                                             const ngraph::Shape& shape) {
+    return std::make_shared<ngraph::opset3::Constant>(ngraph::element::f32, shape, values);
+}
+
+// The graph the driver builds for a CONV_2D of the operand class: quantized inputs are
+// dequantized in the graph, the constants are dequantized at build time and the result is
+// requantized before the output, as OperationsBase does
+std::shared_ptr<ngraph::Function> createConvFunction(OperandClass operandClass,
+                                                     const ConvData& data) {
+    const ngraph::Shape inputShape = {1, kChannels, kSize, kSize};
+    const bool quantized = operandClass == OperandClass::QUANT8;
+    auto input = std::make_shared<ngraph::opset3::Parameter>(
+        quantized ? ngraph::element::u8 : ngraph::element::f32, inputShape);
+    input->set_friendly_name("input");
+
+    std::shared_ptr<ngraph::Node> node = input;
+    if (quantized) {
+        node = std::make_shared<ngraph::opset3::Convert>(node, ngraph::element::f32);
+        node = std::make_shared<ngraph::opset3::Subtract>(
+            node, createConstant({static_cast<float>(kQuantZeroPoint)}, {}));
+        node = std::make_shared<ngraph::opset3::Multiply>(node, createConstant({kQuantScale}, {}));
+    }
+    auto filter = createConstant(data.filter, {kChannels, kChannels, kKernel, kKernel});
+    node = std::make_shared<ngraph::opset3::Convolution>(
+        node, filter, ngraph::Strides{1, 1}, ngraph::CoordinateDiff{1, 1},
+        ngraph::CoordinateDiff{1, 1}, ngraph::Strides{1, 1});
+    node = std::make_shared<ngraph::opset3::Add>(node,
+                                                 createConstant(data.bias, {1, kChannels, 1, 1}));
+    if (quantized) {
+        node = std::make_shared<ngraph::opset3::Divide>(node, createConstant({kQuantScale}, {}));
+        node = std::make_shared<ngraph::op::v5::Round>(
+            node, ngraph::op::v5::Round::RoundMode::HALF_TO_EVEN);
+        node = std::make_shared<ngraph::opset3::Convert>(node, ngraph::element::i32);
+        auto zeroPoint = std::make_shared<ngraph::opset3::Constant>(
+            ngraph::element::i32, ngraph::Shape{}, std::vector<int32_t>{kQuantZeroPoint});
+        node = std::make_shared<ngraph::opset3::Add>(node, zeroPoint);
+        node = std::make_shared<ngraph::opset3::Clamp>(node, 0, 255);
+        node = std::make_shared<ngraph::opset3::Convert>(node, ngraph::element::u8);
+    }
+    auto result = std::make_shared<ngraph::opset3::Result>(node);
+    return std::make_shared<ngraph::Function>(ngraph::ResultVector{result},
+                                              ngraph::ParameterVector{input});
+}
+
+// Loads the graph on the device plugin and times an execution the way BasePreparedModel runs
+// one: copy or convert the input into the plugin blob, infer, then copy or convert the f32
+// output blob into the request memory
+double driverUs(IntelDeviceType device, OperandClass operandClass, ConvData& data) {
+    auto network =
+        std::make_shared<InferenceEngine::CNNNetwork>(createConvFunction(operandClass, data));
+    const std::string inputName = network->getInputsInfo().begin()->first;
+    const std::string outputName = network->getOutputsInfo().begin()->first;
+    network->getOutputsInfo().begin()->second->setPrecision(InferenceEngine::Precision::FP32);
+
+    IENetwork plugin(network, device);
+    if (!plugin.loadNetwork()) return 0;
+    // The only execution of the network, the request is not returned to the pool
+    auto request = plugin.acquireInferRequest();
+    auto inputBlob = request.GetBlob(inputName);
+    auto outputBlob = request.GetBlob(outputName);
+
+    switch (operandClass) {
+        case OperandClass::FLOAT16:
+            return medianUs([&]() {
+                float* dest = inputBlob->buffer().as<float*>();
+                for (size_t i = 0; i < kTensorSize; i++) dest[i] = data.halfInput[i];
+                plugin.infer(request);
+                const float* src = outputBlob->buffer().as<float*>();
+                for (size_t i = 0; i < kTensorSize; i++) data.halfOutput[i] = src[i];
+            });
+        case OperandClass::QUANT8:
+            return medianUs([&]() {
+                std::memcpy(inputBlob->buffer().as<uint8_t*>(), data.quantInput.data(),
+                            kTensorSize);
+                plugin.infer(request);
+                const float* src = outputBlob->buffer().as<float*>();
+                for (size_t i = 0; i < kTensorSize; i++)
+                    data.quantOutput[i] = static_cast<uint8_t>(src[i]);
+            });
+        case OperandClass::FLOAT32:
+        default:
+            return medianUs([&]() {
+                std::memcpy(inputBlob->buffer().as<float*>(), data.input.data(),
+                            kTensorSize * sizeof(float));
+                plugin.infer(request);
+                std::memcpy(data.output.data(), outputBlob->buffer().as<float*>(),
+                            kTensorSize * sizeof(float));
+            });
+    }
+}
+
+std::string getOpenVinoBuild() {
+    const auto* version = InferenceEngine::GetInferenceEngineVersion();
+    return version != nullptr && version->buildNumber != nullptr ? version->buildNumber
+                                                                 : "unknown";
+}
+
+V1_0::PerformanceInfo getOperandPerformance(const DevicePerformance& performance,
+                                            OperandType type) {
+    switch (type) {
+        case OperandType::FLOAT16:
+        case OperandType::TENSOR_FLOAT16:
+            return performance.float16;
+        case OperandType::TENSOR_QUANT8_ASYMM:
+        case OperandType::TENSOR_QUANT8_SYMM:
+        case OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL:
+        case OperandType::TENSOR_QUANT8_ASYMM_SIGNED:
+        case OperandType::TENSOR_QUANT16_SYMM:
+        case OperandType::TENSOR_QUANT16_ASYMM:
+            return performance.quant8;
+        default:
+            // Scalars, indices and booleans run through the float32 kernels of the plugin
+            return performance.float32;
+    }
+}
+
+std::string toString(const V1_0::PerformanceInfo& info) {
+    std::ostringstream out;
+    out << info.execTime << " " << info.powerUsage;
+    return out.str();
+}
+
+bool parsePerformance(const std::string& value, V1_0::PerformanceInfo& info) {
+    std::istringstream in(value);
+    V1_0::PerformanceInfo parsed;
+    if (!(in >> parsed.execTime >> parsed.powerUsage)) return false;
+    if (!(parsed.execTime > 0) || !(parsed.powerUsage > 0)) return false;
+    info = parsed;
+    return true;
+}
+}  // namespace
+
+DevicePerformance getDefaultPerformance(IntelDeviceType device) {
+    DevicePerformance performance;
+    V1_0::PerformanceInfo operand = {1.1f, 1.1f}, relaxed = {1.1f, 1.1f};
+    if (device == IntelDeviceType::CPU) {
+        operand = relaxed = {0.9f, 0.9f};
+    } else if (device == IntelDeviceType::GPU) {
+        operand = {0.95f, 0.95f};
+        relaxed = {0.95f, 0.85f};
+    } else if (device == IntelDeviceType::GNA) {
+        operand = relaxed = {0.8f, 0.8f};
+    }
+    performance.float32 = performance.float16 = performance.quant8 = operand;
+    performance.relaxed = relaxed;
+    return performance;
+}
+
+bool calibratePerformance(IntelDeviceType device, DevicePerformance& performance) {
+    // Only these devices have a prepared model the partitioner can hand work to
+    if (device != IntelDeviceType::CPU && device != IntelDeviceType::GNA) return false;
+
+    // Power cannot be measured here, it keeps the power to time proportion of the defaults
+    const auto defaults = getDefaultPerformance(device);
+    const float powerPerTime = defaults.float32.powerUsage / defaults.float32.execTime;
+
+    ConvData data;
+    DevicePerformance measured;
+    const std::pair<OperandClass, V1_0::PerformanceInfo*> classes[] = {
+        {OperandClass::FLOAT32, &measured.float32},
+        {OperandClass::FLOAT16, &measured.float16},
+        {OperandClass::QUANT8, &measured.quant8}};
+    for (const auto& operandClass : classes) {
+        double driver = 0;
+        try {
+            driver = driverUs(device, operandClass.first, data);
+        } catch (const std::exception& ex) {
+            ALOGE("%s Exception !!! %s", __func__, ex.what());
+            return false;
+        }
+        const double reference = cpuExecutorUs(operandClass.first, data);
+        if (driver <= 0 || reference <= 0) {
+            ALOGE("%s failed to time operand class %d", __func__,
+                  static_cast<int>(operandClass.first));
+            return false;
+        }
+        const float ratio = std::min(kMaxRatio, std::max(kMinRatio, float(driver / reference)));
+        *operandClass.second = {ratio, ratio * powerPerTime};
+        ALOGI("%s class %d: driver %.1f us, CpuExecutor %.1f us", __func__,
+              static_cast<int>(operandClass.first), driver, reference);
+    }
+    // The plugin runs relaxed models and the IF and WHILE branches in float32
+    measured.relaxed = measured.float32;
+    measured.calibrated = true;
+    performance = measured;
+    return true;
+}
+
+bool loadPerformance(const std::string& path, DevicePerformance& performance) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    DevicePerformance parsed;
+    bool versionMatches = false, buildMatches = false;
+    bool hasFloat32 = false, hasFloat16 = false, hasQuant8 = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        const auto separator = line.find('=');
+        if (separator == std::string::npos) continue;
+        std::istringstream keyStream(line.substr(0, separator));
+        std::string key;
+        keyStream >> key;
+        std::string value = line.substr(separator + 1);
+        value.erase(0, value.find_first_not_of(" \t"));
+        value.erase(value.find_last_not_of(" \t\r") + 1);
+
+        if (key == "version")
+            versionMatches = value == std::to_string(kCalibrationVersion);
+        else if (key == "openvino")
+            buildMatches = value == getOpenVinoBuild();
+        else if (key == "float32")
+            hasFloat32 = parsePerformance(value, parsed.float32);
+        else if (key == "float16")
+            hasFloat16 = parsePerformance(value, parsed.float16);
+        else if (key == "quant8")
+            hasQuant8 = parsePerformance(value, parsed.quant8);
+    }
+    if (!versionMatches || !buildMatches || !hasFloat32 || !hasFloat16 || !hasQuant8) {
+        ALOGI("%s ignoring stale or incomplete calibration %s", __func__, path.c_str());
+        return false;
+    }
+    parsed.relaxed = parsed.float32;
+    parsed.calibrated = true;
+    performance = parsed;
+    return true;
+}
+
+bool savePerformance(const std::string& path, const DevicePerformance& performance) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        ALOGE("%s failed to open %s", __func__, path.c_str());
+        return false;
+    }
+    file << "# nnhal calibration: execTime powerUsage relative to the NNAPI CpuExecutor\n"
+         << "version = " << kCalibrationVersion << "\n"
+         << "openvino = " << getOpenVinoBuild() << "\n"
+         << "float32 = " << toString(performance.float32) << "\n"
+         << "float16 = " << toString(performance.float16) << "\n"
+         << "quant8 = " << toString(performance.quant8) << "\n";
+    return file.good();
+}
+
+std::string getCalibrationPath(IntelDeviceType device) {
+    const auto& config = getDriverConfig();
+    if (!config.calibrationFile.empty()) return config.calibrationFile;
+    return config.irDumpDir + "/nnhal_calibration_" + getDeviceTypeName(device) + ".txt";
+}
+
+V1_3::Capabilities getDeviceCapabilities(IntelDeviceType device) {
+    DevicePerformance performance = getDefaultPerformance(device);
+    if (getDriverConfig().calibrateCapabilities) {
+        const std::string path = getCalibrationPath(device);
+        if (!loadPerformance(path, performance)) {
+            DevicePerformance measured;
+            if (calibratePerformance(device, measured)) {
+                performance = measured;
+                savePerformance(path, performance);
+            }
+        }
+    }
+    ALOGI("%s %s %s: float32 %s, float16 %s, quant8 %s", __func__, getDeviceTypeName(device),
+          performance.calibrated ? "calibrated" : "defaults",
+          toString(performance.float32).c_str(), toString(performance.float16).c_str(),
+          toString(performance.quant8).c_str());
+
+    static constexpr hidl_enum_range<OperandType> kOperandTypeRange;
+    std::vector<V1_3::Capabilities::OperandPerformance> operandPerformance;
+    for (OperandType type : kOperandTypeRange) {
+        if (type == OperandType::SUBGRAPH) continue;
+        operandPerformance.push_back({type, getOperandPerformance(performance, type)});
+    }
+    std::sort(operandPerformance.begin(), operandPerformance.end(),
+              [](const V1_3::Capabilities::OperandPerformance& a,
+                 const V1_3::Capabilities::OperandPerformance& b) { return a.type < b.type; });
+
+    V1_3::Capabilities capabilities;
+    capabilities.relaxedFloat32toFloat16PerformanceScalar = performance.relaxed;
+    capabilities.relaxedFloat32toFloat16PerformanceTensor = performance.relaxed;
+    capabilities.operandPerformance = operandPerformance;
+    // IF runs both of its branches and selects their outputs
+    capabilities.ifPerformance = {performance.relaxed.execTime * 2,
+                                  performance.relaxed.powerUsage * 2};
+    capabilities.whilePerformance = performance.relaxed;
+    return capabilities;
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
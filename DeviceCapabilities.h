@@ -0,0 +1,53 @@
+#ifndef ANDROID_ML_NN_DEVICECAPABILITIES_H
+#define ANDROID_ML_NN_DEVICECAPABILITIES_H
+
+#include <string>
+
+#include "Driver.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Driver performance relative to the runtime's CPU path for the operand classes the partitioner
+// compares devices on. Ratios below 1 mean the driver is faster.
+struct DevicePerformance {
+    V1_0::PerformanceInfo float32 = {1.f, 1.f};
+    V1_0::PerformanceInfo float16 = {1.f, 1.f};
+    V1_0::PerformanceInfo quant8 = {1.f, 1.f};
+    // Relaxed float32 models and the IF and WHILE operations
+    V1_0::PerformanceInfo relaxed = {1.f, 1.f};
+    // Set when the numbers come from a calibration rather than the built-in defaults
+    bool calibrated = false;
+};
+
+// The fixed figures reported before calibration existed, used for the devices that cannot be
+// calibrated or when calibration is disabled or fails
+DevicePerformance getDefaultPerformance(IntelDeviceType device);
+
+// Times a 3x3 convolution in each operand class through the plugin of device, including the
+// input and output conversions the driver applies, against the same CONV_2D on the NNAPI
+// CpuExecutor. Returns false for the devices without a prepared model implementation.
+bool calibratePerformance(IntelDeviceType device, DevicePerformance& performance);
+
+// Calibration results persisted across service restarts. Files written by another OpenVINO build
+// or calibration version are ignored.
+bool loadPerformance(const std::string& path, DevicePerformance& performance);
+bool savePerformance(const std::string& path, const DevicePerformance& performance);
+
+// The calibration file of the config or, when unset, nnhal_calibration_<DEVICE>.txt in the
+// IR dump directory
+std::string getCalibrationPath(IntelDeviceType device);
+
+// Loads the persisted calibration of device, calibrating and persisting it when there is none
+// and calibration is enabled, and expands it to the per operand type capabilities. Calibrating
+// takes a few hundred milliseconds, so the service calls it at start, see Driver::initCapabilities.
+V1_3::Capabilities getDeviceCapabilities(IntelDeviceType device);
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_DEVICECAPABILITIES_H
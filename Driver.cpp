@@ -18,11 +18,17 @@
 #include <string>
 
 #include <android-base/logging.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
 #include <thread>
 #include "BasePreparedModel.h"
 #include "CpuPreparedModel.h"
+#include "DeviceCapabilities.h"
 #include "GnaPreparedModel.h"
+#include "DriverConfig.h"
 #include "ModelManager.h"
+#include "PartitionCostModel.h"
 #include "ValidateHal.h"
 
 #undef LOG_TAG
@@ -35,45 +41,19 @@ namespace nnhal {
 
 using namespace android::nn;
 
-hidl_vec<V1_2::Capabilities::OperandPerformance> nonExtensionOperandPerformanceV1_2(
-    V1_0::PerformanceInfo perf) {
-    using OpPerf = V1_2::Capabilities::OperandPerformance;
-
-    // Note: range presents enumerators in declaration order, not in numerical order.
-    static constexpr ::android::hardware::hidl_enum_range<V1_2::OperandType> kOperandTypeRange;
-
-    hidl_vec<OpPerf> ret(kOperandTypeRange.end() - kOperandTypeRange.begin());
-
-    std::transform(kOperandTypeRange.begin(), kOperandTypeRange.end(), ret.begin(),
-                   [perf](V1_2::OperandType type) {
-                       return V1_2::Capabilities::OperandPerformance{(type), perf};
-                   });
-    std::sort(ret.begin(), ret.end(),
-              [](const OpPerf& a, const OpPerf& b) { return a.type < b.type; });
-
-    return ret;
-}
-
-hidl_vec<Capabilities::OperandPerformance> nonExtensionOperandPerformance(
-    V1_0::PerformanceInfo perf) {
-    using OpPerf = Capabilities::OperandPerformance;
-
-    // Note: range presents enumerators in declaration order, not in numerical order.
-    static constexpr hidl_enum_range<OperandType> kOperandTypeRange;
-
-    std::vector<OpPerf> ret;
-    ret.reserve(kOperandTypeRange.end() - kOperandTypeRange.begin());
-    for (OperandType type : kOperandTypeRange) {
-        if (static_cast<OperandType>(type) != OperandType::SUBGRAPH) {
-            ret.push_back(OpPerf{type, perf});
-        }
+const char* getDeviceTypeName(IntelDeviceType type) {
+    switch (type) {
+        case IntelDeviceType::CPU:
+            return "CPU";
+        case IntelDeviceType::GPU:
+            return "GPU";
+        case IntelDeviceType::GNA:
+            return "GNA";
+        case IntelDeviceType::VPU:
+            return "VPU";
+        default:
+            return "OTHER";
     }
-    std::sort(ret.begin(), ret.end(),
-              [](const OpPerf& a, const OpPerf& b) { return a.type < b.type; });
-    hidl_vec<OpPerf> ret1;
-    ret1 = ret;
-
-    return ret1;
 }
 
 static sp<BasePreparedModel> ModelFactory(IntelDeviceType deviceType, const Model& model) {
@@ -85,6 +65,76 @@ static sp<BasePreparedModel> ModelFactory(IntelDeviceType deviceType, const Mode
         driverPreparedModel = new GnaPreparedModel(model);
     return driverPreparedModel;
 }
+
+void Driver::querySupportedOperations(const Model& model, std::vector<bool>& supported) {
+    ModelSupportInfo info;
+    // The query only lives as long as the call, so the model is read in place
+    auto modelInfo = NnapiModelInfo::createForQuery(model);
+    if (!modelInfo->mapPools()) {
+        supported.assign(model.main.operations.size(), false);
+        return;
+    }
+    auto fingerprint = getModelFingerprint(model, modelInfo->getPoolBuffers());
+    if (!mSupportCache.lookup(fingerprint, info)) {
+        info.supportedOperations.assign(model.main.operations.size(), false);
+        NgraphNetworkCreator::querySupportedOperations(modelInfo, mDeviceType,
+                                                       info.supportedOperations);
+        info.operationTypes.reserve(model.main.operations.size());
+        for (const auto& operation : model.main.operations)
+            info.operationTypes.push_back(operation.type);
+        mSupportCache.insert(fingerprint, info);
+    }
+    // The cache keeps the plugin verdicts, applyCachedSupport checks prepared models against them
+    supported = info.supportedOperations;
+
+    const auto& driverConfig = getDriverConfig();
+    if (driverConfig.withholdIslands) {
+        IslandThresholds thresholds;
+        thresholds.minOperations = driverConfig.islandMinOperations;
+        thresholds.minWorkPerByte = driverConfig.islandMinWorkPerByte;
+        const size_t withheld = withholdUnprofitableIslands(model, thresholds, supported);
+        if (withheld > 0)
+            ALOGI("%s withheld %zu of %zu operations", __func__, withheld, supported.size());
+    }
+}
+
+// Reuses the verdicts of an earlier support query on the same model. Returns false when that
+// query already rejected one of the model's operations.
+bool Driver::applyCachedSupport(const Model& model, const sp<BasePreparedModel>& preparedModel) {
+    ModelSupportInfo info;
+    // Pools are mapped here rather than in initialize() to hash the parameters stored in them
+    auto modelInfo = preparedModel->getModelInfo();
+    if (!modelInfo->mapPools()) return true;
+    auto fingerprint = getModelFingerprint(model, modelInfo->getPoolBuffers());
+    preparedModel->setFingerprint(fingerprint);
+    if (!mSupportCache.lookup(fingerprint, info)) return true;
+
+    // Guard against fingerprint collisions before trusting the cached verdicts
+    const auto& operations = model.main.operations;
+    if (info.operationTypes.size() != operations.size()) return true;
+    for (size_t i = 0; i < operations.size(); i++) {
+        if (info.operationTypes[i] != operations[i].type) return true;
+    }
+
+    if (!info.isFullySupported()) {
+        ALOGE("%s model has operations rejected by getSupportedOperations", __func__);
+        return false;
+    }
+    preparedModel->setOperationsValidated(true);
+    return true;
+}
+
+void Driver::registerPreparedModel(const sp<BasePreparedModel>& preparedModel) {
+    std::lock_guard<std::mutex> lock(mPreparedModelsMutex);
+    // Drop the models the runtime released since the last registration
+    mPreparedModels.erase(std::remove_if(mPreparedModels.begin(), mPreparedModels.end(),
+                                         [](const wp<BasePreparedModel>& model) {
+                                             return model.promote() == nullptr;
+                                         }),
+                          mPreparedModels.end());
+    mPreparedModels.push_back(preparedModel);
+}
+
 // For HAL-1.0 version
 Return<void> Driver::getCapabilities(getCapabilities_cb cb) {
     ALOGV("Entering %s", __func__);
@@ -110,6 +160,7 @@ Return<void> Driver::getSupportedOperations(const V1_0_Model& model, getSupporte
 Return<ErrorStatus> Driver::prepareModel(const V1_0_Model& model,
                                          const sp<V1_0::IPreparedModelCallback>& callback) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("prepareModel");
     if (callback.get() == nullptr) {
         ALOGE("invalid callback passed to prepareModel");
         return ErrorStatus::INVALID_ARGUMENT;
@@ -119,19 +170,28 @@ Return<ErrorStatus> Driver::prepareModel(const V1_0_Model& model,
         return ErrorStatus::INVALID_ARGUMENT;
     }
 
-    sp<BasePreparedModel> driverPreparedModel = ModelFactory(mDeviceType, convertToV1_3(model));
+    const Model model_1_3 = convertToV1_3(model);
+    sp<BasePreparedModel> driverPreparedModel = ModelFactory(mDeviceType, model_1_3);
     if (driverPreparedModel == NULL) {
         ALOGE("failed to create preparedmodel");
         return ErrorStatus::INVALID_ARGUMENT;
     }
+    trace.setModelId(driverPreparedModel->getModelId());
     for (auto opn : model.operations) dumpOperation(opn);
 
+    if (!applyCachedSupport(model_1_3, driverPreparedModel)) {
+        callback->notify(ErrorStatus::INVALID_ARGUMENT, nullptr);
+        return ErrorStatus::NONE;
+    }
+
     if (!driverPreparedModel->initialize()) {
         ALOGE("failed to initialize preparedmodel");
         callback->notify(ErrorStatus::INVALID_ARGUMENT, nullptr);
         return ErrorStatus::NONE;
     }
 
+    driverPreparedModel->getMemoryProfile().finish();
+    registerPreparedModel(driverPreparedModel);
     callback->notify(ErrorStatus::NONE, driverPreparedModel);
     ALOGV("Exiting %s", __func__);
     return ErrorStatus::NONE;
@@ -164,6 +224,7 @@ Return<ErrorStatus> Driver::prepareModel_1_1(const V1_1_Model& model,
                                              ExecutionPreference preference,
                                              const sp<V1_0::IPreparedModelCallback>& callback) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("prepareModel_1_1");
 
     if (callback.get() == nullptr) {
         ALOGE("invalid callback passed to prepareModel");
@@ -174,19 +235,29 @@ Return<ErrorStatus> Driver::prepareModel_1_1(const V1_1_Model& model,
         return ErrorStatus::INVALID_ARGUMENT;
     }
 
-    sp<BasePreparedModel> driverPreparedModel = ModelFactory(mDeviceType, convertToV1_3(model));
+    const Model model_1_3 = convertToV1_3(model);
+    sp<BasePreparedModel> driverPreparedModel = ModelFactory(mDeviceType, model_1_3);
     if (driverPreparedModel == NULL) {
         ALOGE("failed to create preparedmodel");
         return ErrorStatus::INVALID_ARGUMENT;
     }
+    trace.setModelId(driverPreparedModel->getModelId());
     for (auto opn : model.operations) dumpOperation(opn);
 
+    driverPreparedModel->setExecutionPreference(preference);
+    if (!applyCachedSupport(model_1_3, driverPreparedModel)) {
+        callback->notify(ErrorStatus::INVALID_ARGUMENT, nullptr);
+        return ErrorStatus::NONE;
+    }
+
     if (!driverPreparedModel->initialize()) {
         ALOGE("failed to initialize preparedmodel");
         callback->notify(ErrorStatus::INVALID_ARGUMENT, nullptr);
         return ErrorStatus::NONE;
     }
 
+    driverPreparedModel->getMemoryProfile().finish();
+    registerPreparedModel(driverPreparedModel);
     callback->notify(ErrorStatus::NONE, driverPreparedModel);
     ALOGV("Exiting %s", __func__);
     return ErrorStatus::NONE;
@@ -195,49 +266,10 @@ Return<ErrorStatus> Driver::prepareModel_1_1(const V1_1_Model& model,
 // For HAL-1.2 version
 Return<void> Driver::getCapabilities_1_2(getCapabilities_1_2_cb cb) {
     ALOGV("Entering %s", __func__);
-    if (mDeviceType == IntelDeviceType::CPU) {
-        ALOGI("CPU driver getCapabilities()");
-        // Setting operandPerformance value to base value for all operand types
-        V1_2::Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 0.9f, .powerUsage = 0.9f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 0.9f, .powerUsage = 0.9f},
-            .operandPerformance = nonExtensionOperandPerformanceV1_2({0.9f, 0.9f})};
-
-        ALOGI("CPU MKLDNN driver Capabilities .execTime = 0.9f, .powerUsage = 0.9f");
-        cb(ErrorStatus::NONE, capabilities);
-    } else if (mDeviceType == IntelDeviceType::GPU) {
-        ALOGI("GPU driver getCapabilities()");
-        V1_2::Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 0.95f, .powerUsage = 0.85f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 0.95f, .powerUsage = 0.85f},
-            .operandPerformance = nonExtensionOperandPerformanceV1_2({0.95f, 0.95f})};
-
-        ALOGI("GPU clDNN driver Capabilities .execTime = 0.95f, .powerUsage = 0.85f");
-        cb(ErrorStatus::NONE, capabilities);
-    } else if (mDeviceType == IntelDeviceType::GNA) {
-        ALOGI("GPU driver getCapabilities()");
-        V1_2::Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 0.8f, .powerUsage = 0.8f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 0.8f, .powerUsage = 0.8f},
-            .operandPerformance = nonExtensionOperandPerformanceV1_2({0.8f, 0.8f})};
-
-        ALOGI("GPU clDNN driver Capabilities .execTime = 0.95f, .powerUsage = 0.85f");
-        cb(ErrorStatus::NONE, capabilities);
-    } else if (mDeviceType == IntelDeviceType::VPU) {
-        ALOGI("Myriad driver getCapabilities()");
-        V1_2::Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 1.1f, .powerUsage = 1.1f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 1.1f, .powerUsage = 1.1f},
-            .operandPerformance = nonExtensionOperandPerformanceV1_2({1.1f, 1.1f})};
-
-        ALOGI("Driver Capabilities .execTime = 1.1f, .powerUsage = 1.1f");
-        cb(ErrorStatus::NONE, capabilities);
-    } else {
-        V1_2::Capabilities capabilities;
-        cb(ErrorStatus::DEVICE_UNAVAILABLE, capabilities);
-    }
-    ALOGV("Exiting %s", __func__);
-    return Void();
+    return getCapabilities_1_3(
+        [&](V1_3::ErrorStatus error, const V1_3::Capabilities& capabilities) {
+            cb(convertToV1_0(error), convertToV1_2(capabilities));
+        });
 }
 
 Return<void> Driver::getSupportedOperations_1_2(const V1_2_Model& model,
@@ -253,9 +285,7 @@ Return<void> Driver::getSupportedOperations_1_2(const V1_2_Model& model,
         return Void();
     }
 
-    auto modelInfo = std::make_shared<NnapiModelInfo>(convertToV1_3(model));
-    NgraphNetworkCreator ngraphCreatorInst(modelInfo, mDeviceType);
-    ngraphCreatorInst.getSupportedOperations(supported);
+    querySupportedOperations(convertToV1_3(model), supported);
 
     cb(ErrorStatus::NONE, supported);
     ALOGV("Exiting %s", __func__);
@@ -268,6 +298,7 @@ Return<ErrorStatus> Driver::prepareModel_1_2(const V1_2_Model& model,
                                              const hidl_vec<hidl_handle>&, const HidlToken&,
                                              const sp<V1_2::IPreparedModelCallback>& callback) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("prepareModel_1_2");
 
     if (callback.get() == nullptr) {
         ALOGE("invalid callback passed to prepareModel");
@@ -279,19 +310,29 @@ Return<ErrorStatus> Driver::prepareModel_1_2(const V1_2_Model& model,
     }
 
     // TODO: make asynchronous later
-    sp<BasePreparedModel> driverPreparedModel = ModelFactory(mDeviceType, convertToV1_3(model));
+    const Model model_1_3 = convertToV1_3(model);
+    sp<BasePreparedModel> driverPreparedModel = ModelFactory(mDeviceType, model_1_3);
     if (driverPreparedModel == NULL) {
         ALOGE("failed to create preparedmodel");
         return ErrorStatus::INVALID_ARGUMENT;
     }
+    trace.setModelId(driverPreparedModel->getModelId());
     for (auto opn : model.operations) dumpOperation(opn);
 
+    driverPreparedModel->setExecutionPreference(preference);
+    if (!applyCachedSupport(model_1_3, driverPreparedModel)) {
+        callback->notify(ErrorStatus::INVALID_ARGUMENT, nullptr);
+        return ErrorStatus::NONE;
+    }
+
     if (!driverPreparedModel->initialize()) {
         ALOGE("failed to initialize preparedmodel");
         callback->notify(ErrorStatus::INVALID_ARGUMENT, nullptr);
         return ErrorStatus::NONE;
     }
 
+    driverPreparedModel->getMemoryProfile().finish();
+    registerPreparedModel(driverPreparedModel);
     callback->notify(ErrorStatus::NONE, driverPreparedModel);
     ALOGV("Exiting %s", __func__);
     return ErrorStatus::NONE;
@@ -313,57 +354,21 @@ Return<ErrorStatus> Driver::prepareModelFromCache(
 }
 
 // For HAL-1.3 version
+void Driver::initCapabilities() {
+    if (mDeviceType == IntelDeviceType::OTHER) return;
+    std::call_once(mCapabilitiesOnce,
+                   [this]() { mCapabilities = getDeviceCapabilities(mDeviceType); });
+}
+
 Return<void> Driver::getCapabilities_1_3(getCapabilities_1_3_cb cb) {
     ALOGV("Entering %s", __func__);
-    if (mDeviceType == IntelDeviceType::CPU) {
-        ALOGI("CPU driver getCapabilities()");
-        // Setting operandPerformance value to base value for all operand types
-        Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 0.9f, .powerUsage = 0.9f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 0.9f, .powerUsage = 0.9f},
-            .operandPerformance = nonExtensionOperandPerformance({0.9f, 0.9f}),
-            .ifPerformance = {.execTime = 0.9f, .powerUsage = 0.9f},
-            .whilePerformance = {.execTime = 0.9f, .powerUsage = 0.9f}};
-
-        ALOGI("CPU MKLDNN driver Capabilities .execTime = 0.9f, .powerUsage = 0.9f");
-        cb(V1_3::ErrorStatus::NONE, capabilities);
-    } else if (mDeviceType == IntelDeviceType::GPU) {
-        ALOGI("GPU driver getCapabilities()");
-        V1_3::Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 0.95f, .powerUsage = 0.85f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 0.95f, .powerUsage = 0.85f},
-            .operandPerformance = nonExtensionOperandPerformance({0.95f, 0.95f}),
-            .ifPerformance = {.execTime = 0.95f, .powerUsage = 0.85f},
-            .whilePerformance = {.execTime = 0.95f, .powerUsage = 0.85f}};
-
-        ALOGI("GPU clDNN driver Capabilities .execTime = 0.95f, .powerUsage = 0.85f");
-        cb(V1_3::ErrorStatus::NONE, capabilities);
-    } else if (mDeviceType == IntelDeviceType::GNA) {
-        ALOGI("GNA driver getCapabilities()");
-        Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 0.8f, .powerUsage = 0.8f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 0.8f, .powerUsage = 0.8f},
-            .operandPerformance = nonExtensionOperandPerformance({0.8f, 0.8f}),
-            .ifPerformance = {.execTime = 0.8f, .powerUsage = 0.8f},
-            .whilePerformance = {.execTime = 0.8f, .powerUsage = 0.8f}};
-
-        ALOGI("GNA driver Capabilities .execTime = 0.95f, .powerUsage = 0.85f");
-        cb(V1_3::ErrorStatus::NONE, capabilities);
-    } else if (mDeviceType == IntelDeviceType::VPU) {
-        ALOGI("Driver getCapabilities()");
-        Capabilities capabilities = {
-            .relaxedFloat32toFloat16PerformanceScalar = {.execTime = 1.1f, .powerUsage = 1.1f},
-            .relaxedFloat32toFloat16PerformanceTensor = {.execTime = 1.1f, .powerUsage = 1.1f},
-            .operandPerformance = nonExtensionOperandPerformance({1.1f, 1.1f}),
-            .ifPerformance = {.execTime = 1.1f, .powerUsage = 1.1f},
-            .whilePerformance = {.execTime = 1.1f, .powerUsage = 1.1f}};
-
-        ALOGI("Driver Capabilities .execTime = 1.1f, .powerUsage = 1.1f");
-        cb(V1_3::ErrorStatus::NONE, capabilities);
-    } else {
-        Capabilities capabilities;
-        cb(V1_3::ErrorStatus::DEVICE_UNAVAILABLE, capabilities);
+    if (mDeviceType == IntelDeviceType::OTHER) {
+        cb(V1_3::ErrorStatus::DEVICE_UNAVAILABLE, {});
+        return Void();
     }
+    // Already initialized by the service at start
+    initCapabilities();
+    cb(V1_3::ErrorStatus::NONE, mCapabilities);
     ALOGV("Exiting %s", __func__);
     return Void();
 }
@@ -381,9 +386,7 @@ Return<void> Driver::getSupportedOperations_1_3(const Model& model,
         return Void();
     }
 
-    auto modelInfo = std::make_shared<NnapiModelInfo>(model);
-    NgraphNetworkCreator ngraphCreatorInst(modelInfo, mDeviceType);
-    ngraphCreatorInst.getSupportedOperations(supported);
+    querySupportedOperations(model, supported);
 
     cb(V1_3::ErrorStatus::NONE, supported);
     ALOGV("Exiting %s", __func__);
@@ -397,6 +400,7 @@ Return<V1_3::ErrorStatus> Driver::prepareModel_1_3(
     const android::hardware::hidl_vec<android::hardware::hidl_handle>&, const HidlToken&,
     const android::sp<V1_3::IPreparedModelCallback>& cb) {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("prepareModel_1_3");
 
     if (cb.get() == nullptr) {
         ALOGI("invalid callback passed to prepareModel");
@@ -412,11 +416,19 @@ Return<V1_3::ErrorStatus> Driver::prepareModel_1_3(
 
     // TODO: make asynchronous later
     sp<BasePreparedModel> driverPreparedModel = ModelFactory(mDeviceType, model);
+    trace.setModelId(driverPreparedModel->getModelId());
+    driverPreparedModel->setExecutionPreference(preference);
+    if (!applyCachedSupport(model, driverPreparedModel)) {
+        cb->notify_1_3(V1_3::ErrorStatus::INVALID_ARGUMENT, nullptr);
+        return V1_3::ErrorStatus::NONE;
+    }
     if (!driverPreparedModel->initialize()) {
         ALOGI("Failed to initialize prepared model");
         cb->notify_1_3(convertToV1_3(ErrorStatus::INVALID_ARGUMENT), nullptr);
         return V1_3::ErrorStatus::NONE;
     }
+    driverPreparedModel->getMemoryProfile().finish();
+    registerPreparedModel(driverPreparedModel);
     cb->notify_1_3((V1_3::ErrorStatus::NONE), driverPreparedModel);
     ALOGV("Exiting %s", __func__);
 
@@ -476,6 +488,37 @@ Return<void> Driver::getSupportedExtensions(getSupportedExtensions_cb cb) {
     return Void();
 }
 
+Return<void> Driver::debug(const hidl_handle& fd, const hidl_vec<hidl_string>& options) {
+    // Promote under the lock, dump outside of it so that a slow reader never blocks prepareModel
+    std::vector<sp<BasePreparedModel>> preparedModels;
+    {
+        std::lock_guard<std::mutex> lock(mPreparedModelsMutex);
+        for (const auto& model : mPreparedModels) {
+            auto preparedModel = model.promote();
+            if (preparedModel != nullptr) preparedModels.push_back(preparedModel);
+        }
+    }
+    if (fd.getNativeHandle() == nullptr || fd->numFds < 1) return Void();
+    const int out = fd->data[0];
+
+    const uint64_t hits = mSupportCache.getHits();
+    const uint64_t lookups = hits + mSupportCache.getMisses();
+    dprintf(out, "device %s\nsupport cache: %" PRIu64 " lookups, %" PRIu64 " hits (%.1f%%)\n",
+            getDeviceTypeName(mDeviceType), lookups, hits,
+            lookups == 0 ? 0.0 : 100.0 * hits / lookups);
+
+    uint64_t inFlight = 0;
+    for (const auto& preparedModel : preparedModels)
+        inFlight += preparedModel->getMetrics().getInFlight();
+    dprintf(out, "prepared models: %zu, executions in flight: %" PRIu64 "\n",
+            preparedModels.size(), inFlight);
+    for (const auto& preparedModel : preparedModels) {
+        dprintf(out, "\nmodel %" PRIu64 "\n", preparedModel->getModelId());
+        preparedModel->dumpState(out);
+    }
+    return Void();
+}
+
 }  // namespace nnhal
 }  // namespace neuralnetworks
 }  // namespace hardware
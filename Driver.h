@@ -35,7 +35,10 @@
 #include <android/hardware/neuralnetworks/1.3/IPreparedModelCallback.h>
 #include <android/hardware/neuralnetworks/1.3/types.h>
 
+#include <mutex>
 #include <string>
+#include <vector>
+#include "ModelSupportCache.h"
 #include "Utils.h"
 
 namespace android {
@@ -45,6 +48,8 @@ namespace nnhal {
 
 enum class IntelDeviceType { CPU, GPU, GNA, VPU, OTHER };
 
+const char* getDeviceTypeName(IntelDeviceType type);
+
 // For HAL-1.0 version
 using namespace ::android::hardware::neuralnetworks::V1_0;
 using V1_0_Model = ::android::hardware::neuralnetworks::V1_0::Model;
@@ -81,6 +86,8 @@ using Capabilities = ::android::hardware::neuralnetworks::V1_3::Capabilities;
 using ::android::hardware::MQDescriptorSync;
 using HidlToken = android::hardware::hidl_array<uint8_t, 32>;
 
+class BasePreparedModel;
+
 // Base class used to create vpu drivers for the NN HAL.  This class
 // provides some implementation of the more common functions.
 //
@@ -91,6 +98,10 @@ public:
     Driver() {}
     Driver(IntelDeviceType device) : mDeviceType(device) {}
 
+    // Loads or measures the capabilities, once. The service calls it before registering, so that
+    // no binder call waits for a calibration.
+    void initCapabilities();
+
     ~Driver() override {}
 
     // For HAL-1.0 version
@@ -146,8 +157,25 @@ public:
     Return<void> getSupportedExtensions(getSupportedExtensions_cb) override;
     Return<void> getNumberOfCacheFilesNeeded(getNumberOfCacheFilesNeeded_cb cb) override;
 
+    // Dumps the support cache hit rate and the state of every live prepared model, for
+    // lshal debug on Android
+    Return<void> debug(const hidl_handle& fd, const hidl_vec<hidl_string>& options) override;
+
 protected:
     IntelDeviceType mDeviceType;
+    ModelSupportCache mSupportCache;
+
+private:
+    void querySupportedOperations(const Model& model, std::vector<bool>& supported);
+    bool applyCachedSupport(const Model& model, const sp<BasePreparedModel>& preparedModel);
+    // Lists a successfully prepared model for debug(), the list only holds weak references
+    void registerPreparedModel(const sp<BasePreparedModel>& preparedModel);
+
+    std::mutex mPreparedModelsMutex;
+    std::vector<wp<BasePreparedModel>> mPreparedModels;
+
+    std::once_flag mCapabilitiesOnce;
+    Capabilities mCapabilities;
 };
 
 }  // namespace nnhal
@@ -0,0 +1,229 @@
+#include "DriverConfig.h"
+
+#include <GraphOptimizer.hpp>
+
+#include <gna/gna_config.hpp>
+#include <ie_plugin_config.hpp>
+#include <log/log.h>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#undef LOG_TAG
+#define LOG_TAG "DriverConfig"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+DriverConfig sDriverConfig;
+
+std::string trim(const std::string& str) {
+    const char* whitespace = " \t\r\n";
+    auto begin = str.find_first_not_of(whitespace);
+    if (begin == std::string::npos) return "";
+    auto end = str.find_last_not_of(whitespace);
+    return str.substr(begin, end - begin + 1);
+}
+
+// The values are bounded to int, as the plugins parse the keys forwarded to them as int. Values
+// out of range are rejected like malformed ones rather than throwing.
+bool parseUnsigned(const std::string& value, unsigned long min, unsigned long& result) {
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) return false;
+    errno = 0;
+    const unsigned long long parsed = std::strtoull(value.c_str(), nullptr, 10);
+    if (errno == ERANGE || parsed > static_cast<unsigned long long>(INT_MAX)) return false;
+    result = static_cast<unsigned long>(parsed);
+    return result >= min;
+}
+
+// Comma separated, an empty list disables the optimizations
+bool parseGraphPasses(const std::string& value, DriverConfig& config) {
+    std::istringstream passes(value);
+    std::string pass;
+    config.graphPasses.clear();
+    while (std::getline(passes, pass, ',')) {
+        pass = trim(pass);
+        if (!GraphOptimizer::isKnownPass(pass)) return false;
+        config.graphPasses.push_back(pass);
+    }
+    config.graphPassesConfigured = true;
+    return true;
+}
+
+bool applyDeviceKey(const std::string& deviceName, const std::string& key,
+                    const std::string& value, DriverConfig& config) {
+    using namespace InferenceEngine;
+    auto& pluginConfig = config.pluginConfig["CPU"];
+    unsigned long number;
+
+    if (key == "graph_passes") {
+        // Overrides the global list, the device sections follow it
+        return parseGraphPasses(value, config);
+    } else if (key == "threads") {
+        // 0 lets the plugin use every core
+        if (!parseUnsigned(value, 0, number)) return false;
+        pluginConfig[PluginConfigParams::KEY_CPU_THREADS_NUM] = value;
+    } else if (key == "streams") {
+        if (value == "AUTO") {
+            pluginConfig[PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS] =
+                PluginConfigParams::CPU_THROUGHPUT_AUTO;
+        } else {
+            if (!parseUnsigned(value, 1, number)) return false;
+            pluginConfig[PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS] = value;
+        }
+    } else if (key == "bind_thread") {
+        if (value != PluginConfigParams::YES && value != PluginConfigParams::NO &&
+            value != PluginConfigParams::NUMA)
+            return false;
+        pluginConfig[PluginConfigParams::KEY_CPU_BIND_THREAD] = value;
+    } else if (key == "dynamic_batch_limit") {
+        if (!parseUnsigned(value, 1, number)) return false;
+        pluginConfig[PluginConfigParams::KEY_DYN_BATCH_ENABLED] = PluginConfigParams::YES;
+        pluginConfig[PluginConfigParams::KEY_DYN_BATCH_LIMIT] = value;
+    } else if (key == "device_mode" && deviceName == "GNA") {
+        // GNA_SW_EXACT emulates the hardware bit exactly on hosts without a GNA device
+        if (value != GNAConfigParams::GNA_AUTO && value != GNAConfigParams::GNA_HW &&
+            value != GNAConfigParams::GNA_SW && value != GNAConfigParams::GNA_SW_EXACT &&
+            value != GNAConfigParams::GNA_SW_FP32)
+            return false;
+        config.pluginConfig["GNA"][GNAConfigParams::KEY_GNA_DEVICE_MODE] = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool applyGlobalKey(const std::string& key, const std::string& value, DriverConfig& config) {
+    unsigned long number;
+
+    if (key == "binder_threads") {
+        if (!parseUnsigned(value, 1, number)) return false;
+        config.binderThreads = number;
+    } else if (key == "ir_dump_dir") {
+        if (value.empty()) return false;
+        config.irDumpDir = value;
+    } else if (key == "graph_passes") {
+        if (!parseGraphPasses(value, config)) return false;
+    } else if (key == "low_precision") {
+        if (value != "YES" && value != "NO") return false;
+        config.lowPrecision = value == "YES";
+    } else if (key == "stateful_models") {
+        if (value != "YES" && value != "NO") return false;
+        config.statefulModels = value == "YES";
+    } else if (key == "profile_memory") {
+        if (value != "YES" && value != "NO") return false;
+        config.profileMemory = value == "YES";
+    } else if (key == "trace_file") {
+        config.traceFile = value;
+    } else if (key == "calibrate_capabilities") {
+        if (value != "YES" && value != "NO") return false;
+        config.calibrateCapabilities = value == "YES";
+    } else if (key == "calibration_file") {
+        config.calibrationFile = value;
+    } else if (key == "withhold_islands") {
+        if (value != "YES" && value != "NO") return false;
+        config.withholdIslands = value == "YES";
+    } else if (key == "island_min_operations") {
+        if (!parseUnsigned(value, 1, number)) return false;
+        config.islandMinOperations = number;
+    } else if (key == "island_min_work_per_byte") {
+        if (!parseUnsigned(value, 0, number)) return false;
+        config.islandMinWorkPerByte = number;
+    } else {
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+bool parseDriverConfig(const std::string& path, const std::string& deviceName,
+                       DriverConfig& config) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        ALOGI("%s no config file at %s", __func__, path.c_str());
+        return false;
+    }
+
+    DriverConfig parsed;
+    std::string section, line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (line.back() != ']') {
+                ALOGE("%s %s:%zu malformed section", __func__, path.c_str(), lineNumber);
+                return false;
+            }
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        auto separator = line.find('=');
+        if (separator == std::string::npos) {
+            ALOGE("%s %s:%zu expected key = value", __func__, path.c_str(), lineNumber);
+            return false;
+        }
+        auto key = trim(line.substr(0, separator));
+        auto value = trim(line.substr(separator + 1));
+
+        bool valid;
+        if (section.empty())
+            valid = applyGlobalKey(key, value, parsed);
+        else if (section == deviceName)
+            valid = applyDeviceKey(deviceName, key, value, parsed);
+        else
+            continue;
+
+        if (!valid) {
+            ALOGE("%s %s:%zu invalid entry %s = %s", __func__, path.c_str(), lineNumber,
+                  key.c_str(), value.c_str());
+            return false;
+        }
+    }
+
+    config = parsed;
+    return true;
+}
+
+void loadDriverConfig(const std::string& deviceName, const std::string& path) {
+    DriverConfig config;
+    if (!parseDriverConfig(path, deviceName, config)) {
+        ALOGI("%s using default configuration for %s", __func__, deviceName.c_str());
+        return;
+    }
+    sDriverConfig = config;
+
+    ALOGI("%s loaded %s for %s: binder_threads %zu, ir_dump_dir %s, low_precision %d, "
+          "stateful_models %d, profile_memory %d, trace_file %s, "
+          "calibrate_capabilities %d, calibration_file %s, withhold_islands %d (min operations "
+          "%zu, min work per byte %zu)",
+          __func__, path.c_str(), deviceName.c_str(), sDriverConfig.binderThreads,
+          sDriverConfig.irDumpDir.c_str(), sDriverConfig.lowPrecision,
+          sDriverConfig.statefulModels, sDriverConfig.profileMemory,
+          sDriverConfig.traceFile.c_str(),
+          sDriverConfig.calibrateCapabilities, sDriverConfig.calibrationFile.c_str(),
+          sDriverConfig.withholdIslands, sDriverConfig.islandMinOperations,
+          sDriverConfig.islandMinWorkPerByte);
+    for (const auto& plugin : sDriverConfig.pluginConfig) {
+        for (const auto& entry : plugin.second)
+            ALOGI("%s %s plugin config %s = %s", __func__, plugin.first.c_str(),
+                  entry.first.c_str(), entry.second.c_str());
+    }
+}
+
+const DriverConfig& getDriverConfig() { return sDriverConfig; }
+
+void setDriverConfig(const DriverConfig& config) { sDriverConfig = config; }
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,76 @@
+#ifndef ANDROID_ML_NN_DRIVERCONFIG_H
+#define ANDROID_ML_NN_DRIVERCONFIG_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+#if __ANDROID__
+#define NNHAL_CONFIG_FILE "/vendor/etc/openvino/nnhal.conf"
+#else
+#define NNHAL_CONFIG_FILE "/usr/local/etc/openvino/nnhal.conf"
+#endif
+
+// Deployment tuning read once at service start. The file holds global "key = value" lines
+// followed by per device sections ([CPU], [GNA], ...); only the section of the device served by
+// this process is applied. See config/nnhal.conf for the supported keys.
+struct DriverConfig {
+    // Size of the HIDL binder thread pool
+    size_t binderThreads = 4;
+    // Directory the generated IR is serialized to
+#if __ANDROID__
+    std::string irDumpDir = "/data/vendor/neuralnetworks";
+#else
+    std::string irDumpDir = "/tmp";
+#endif
+    // Plugin config keys, keyed by plugin name ("CPU", "GNA"). The CPU keys are applied on top
+    // of the ExecutionPreference profile, also for the CPU fallback of the GNA device.
+    std::map<std::string, std::map<std::string, std::string>> pluginConfig;
+    // GraphOptimizer passes run on the generated graph, set globally or per device. When not
+    // configured, CPU runs GraphOptimizer::getDefaultPasses() and the other devices none.
+    bool graphPassesConfigured = false;
+    std::vector<std::string> graphPasses;
+    // Lower 8 bit quantized operations to FakeQuantize graphs the CPU plugin runs in int8,
+    // instead of dequantizing them to float32
+    bool lowPrecision = false;
+    // Keep the recurrent state of LSTM/RNN models in the plugin between executions
+    bool statefulModels = false;
+    // Record the RSS and heap deltas of the preparation stages of each model
+    bool profileMemory = false;
+    // Host builds write the trace events to this file, Android builds forward them to atrace
+    std::string traceFile;
+    // Report the per operand type performance measured on this device instead of the built-in
+    // figures. The measurement runs once at service start and is persisted.
+    bool calibrateCapabilities = true;
+    // Where the calibration is persisted, nnhal_calibration_<DEVICE>.txt in irDumpDir when empty
+    std::string calibrationFile;
+    // Withhold the support of the islands of supported operations too small to pay for their
+    // transfers, see PartitionCostModel.h for the thresholds
+    bool withholdIslands = false;
+    size_t islandMinOperations = 2;
+    size_t islandMinWorkPerByte = 4;
+};
+
+// Parses the file at path for deviceName into config. Returns false, leaving config untouched,
+// when the file is missing or has any invalid entry.
+bool parseDriverConfig(const std::string& path, const std::string& deviceName,
+                       DriverConfig& config);
+
+// Loads the process wide configuration, falling back to the defaults on any error
+void loadDriverConfig(const std::string& deviceName, const std::string& path = NNHAL_CONFIG_FILE);
+const DriverConfig& getDriverConfig();
+// Replaces the process wide configuration, for tools comparing configurations in one process.
+// Must not race with model preparations.
+void setDriverConfig(const DriverConfig& config);
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_DRIVERCONFIG_H
@@ -0,0 +1,110 @@
+#include "ExecutionMetrics.h"
+
+#include <sstream>
+#include <utility>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+const char* const kPathNames[ExecutionMetrics::kPathCount] = {"sync", "async", "fenced"};
+
+size_t getLatencyBucket(uint64_t latencyUs) {
+    size_t bucket = 0;
+    while (latencyUs > 1 && bucket + 1 < ExecutionMetrics::kLatencyBuckets) {
+        latencyUs >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+}  // namespace
+
+ExecutionMetrics::Execution::Execution(ExecutionMetrics& metrics, Path path)
+    : mMetrics(metrics), mPath(path), mStart(std::chrono::steady_clock::now()) {
+    const uint64_t inFlight = mMetrics.mInFlight.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t maxInFlight = mMetrics.mMaxInFlight.load(std::memory_order_relaxed);
+    while (inFlight > maxInFlight &&
+           !mMetrics.mMaxInFlight.compare_exchange_weak(maxInFlight, inFlight,
+                                                        std::memory_order_relaxed)) {
+    }
+}
+
+ExecutionMetrics::Execution::~Execution() {
+    const auto latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - mStart)
+                               .count();
+    mMetrics.mExecutions[static_cast<size_t>(mPath)].fetch_add(1, std::memory_order_relaxed);
+    if (mSucceeded)
+        mMetrics.recordLatency(static_cast<uint64_t>(latencyUs));
+    else
+        mMetrics.mFailures.fetch_add(1, std::memory_order_relaxed);
+    mMetrics.mInFlight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ExecutionMetrics::recordLatency(uint64_t latencyUs) {
+    mLatencyUs[getLatencyBucket(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+    mTotalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+}
+
+uint64_t ExecutionMetrics::getExecutions() const {
+    uint64_t executions = 0;
+    for (const auto& count : mExecutions) executions += count.load(std::memory_order_relaxed);
+    return executions;
+}
+
+std::string ExecutionMetrics::toString() const {
+    std::ostringstream out;
+    out << "executions";
+    for (size_t i = 0; i < kPathCount; i++)
+        out << " " << kPathNames[i] << " " << mExecutions[i].load(std::memory_order_relaxed);
+    out << ", failures " << mFailures.load(std::memory_order_relaxed) << "\n";
+    out << "in flight " << getInFlight() << ", max "
+        << mMaxInFlight.load(std::memory_order_relaxed) << "\n";
+    out << "bytes copied " << mBytesCopied.load(std::memory_order_relaxed) << ", converted "
+        << mBytesConverted.load(std::memory_order_relaxed) << "\n";
+
+    uint64_t buckets[kLatencyBuckets];
+    uint64_t succeeded = 0;
+    for (size_t i = 0; i < kLatencyBuckets; i++) {
+        buckets[i] = mLatencyUs[i].load(std::memory_order_relaxed);
+        succeeded += buckets[i];
+    }
+    if (succeeded == 0) {
+        out << "latency: no successful execution\n";
+        return out.str();
+    }
+
+    // Percentiles are reported as the upper bound of the bucket they fall in
+    out << "latency us: mean " << mTotalLatencyUs.load(std::memory_order_relaxed) / succeeded;
+    const std::pair<const char*, uint64_t> percentiles[] = {{"p50", 50}, {"p90", 90}, {"p99", 99}};
+    for (const auto& percentile : percentiles) {
+        const uint64_t rank = (succeeded * percentile.second + 99) / 100;
+        uint64_t seen = 0;
+        size_t bucket = 0;
+        while (bucket + 1 < kLatencyBuckets && seen + buckets[bucket] < rank)
+            seen += buckets[bucket++];
+        out << ", " << percentile.first;
+        if (bucket + 1 < kLatencyBuckets)
+            out << " <" << (2ULL << bucket);
+        else
+            out << " >=" << (1ULL << bucket);
+    }
+    out << "\n";
+    for (size_t i = 0; i < kLatencyBuckets; i++) {
+        if (buckets[i] == 0) continue;
+        out << "  [" << (i == 0 ? 0 : 1ULL << i) << ", ";
+        if (i + 1 < kLatencyBuckets)
+            out << (2ULL << i) << ")";
+        else
+            out << "inf)";
+        out << ": " << buckets[i] << "\n";
+    }
+    return out.str();
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
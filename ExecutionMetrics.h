@@ -0,0 +1,71 @@
+#ifndef ANDROID_ML_NN_EXECUTIONMETRICS_H
+#define ANDROID_ML_NN_EXECUTIONMETRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Execution counters of a prepared model, dumped by debug(). Every update is a relaxed atomic
+// operation so that concurrent executions never wait on each other or on a dump; a dump may mix
+// counts of executions that complete while it is read.
+class ExecutionMetrics {
+public:
+    enum class Path { SYNC, ASYNC, FENCED };
+    static constexpr size_t kPathCount = 3;
+    // Bucket i counts latencies in [2^i, 2^(i+1)) microseconds, the last one every longer one
+    static constexpr size_t kLatencyBuckets = 24;
+
+    // Counts an execution as in flight from its construction to its destruction, and as failed
+    // unless setSucceeded() was called
+    class Execution {
+    public:
+        Execution(ExecutionMetrics& metrics, Path path);
+        ~Execution();
+        Execution(const Execution&) = delete;
+        Execution& operator=(const Execution&) = delete;
+
+        void setSucceeded() { mSucceeded = true; }
+
+    private:
+        ExecutionMetrics& mMetrics;
+        Path mPath;
+        bool mSucceeded = false;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    // Bytes moved between the request pools and the plugin blobs, converted when the element
+    // type differs on the two sides
+    void addBytes(uint64_t bytes, bool converted) {
+        (converted ? mBytesConverted : mBytesCopied).fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    uint64_t getExecutions() const;
+    uint64_t getInFlight() const { return mInFlight.load(std::memory_order_relaxed); }
+
+    std::string toString() const;
+
+private:
+    void recordLatency(uint64_t latencyUs);
+
+    std::atomic<uint64_t> mExecutions[kPathCount] = {};
+    std::atomic<uint64_t> mFailures{0};
+    std::atomic<uint64_t> mInFlight{0};
+    std::atomic<uint64_t> mMaxInFlight{0};
+    std::atomic<uint64_t> mBytesCopied{0};
+    std::atomic<uint64_t> mBytesConverted{0};
+    std::atomic<uint64_t> mTotalLatencyUs{0};
+    std::atomic<uint64_t> mLatencyUs[kLatencyBuckets] = {};
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_EXECUTIONMETRICS_H
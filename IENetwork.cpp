@@ -1,10 +1,17 @@
 #include "IENetwork.h"
+#include "DriverConfig.h"
+#include "Tracing.h"
 #include "ie_common.h"
 
 #include <android-base/logging.h>
 #include <android/log.h>
+#include <gna/gna_config.hpp>
 #include <ie_blob.h>
+#include <ie_plugin_config.hpp>
 #include <log/log.h>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
 
 #undef LOG_TAG
 #define LOG_TAG "IENetwork"
@@ -14,6 +21,91 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
+const char* getExecutionProfileName(V1_1::ExecutionPreference preference) {
+    switch (preference) {
+        case V1_1::ExecutionPreference::LOW_POWER:
+            return "low-power";
+        case V1_1::ExecutionPreference::SUSTAINED_SPEED:
+            return "throughput";
+        case V1_1::ExecutionPreference::FAST_SINGLE_ANSWER:
+        default:
+            return "latency";
+    }
+}
+
+std::map<std::string, std::string> IENetwork::getPerformanceConfig() {
+    using namespace InferenceEngine;
+    std::map<std::string, std::string> config;
+
+    switch (mPreference) {
+        case V1_1::ExecutionPreference::SUSTAINED_SPEED:
+            // As many streams as the plugin finds optimal for the cores, each execution running
+            // on its own InferRequest. The threads are left unpinned, so the scheduler can
+            // balance a sustained load with the rest of the system.
+            config[PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS] =
+                PluginConfigParams::CPU_THROUGHPUT_AUTO;
+            config[PluginConfigParams::KEY_CPU_THREADS_NUM] = "0";
+            config[PluginConfigParams::KEY_CPU_BIND_THREAD] = PluginConfigParams::NO;
+            break;
+        case V1_1::ExecutionPreference::LOW_POWER: {
+            // Half of the cores, left unpinned so the scheduler can keep them in low power states
+            unsigned int threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+            config[PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS] = "1";
+            config[PluginConfigParams::KEY_CPU_THREADS_NUM] = std::to_string(threads);
+            config[PluginConfigParams::KEY_CPU_BIND_THREAD] = PluginConfigParams::NO;
+            break;
+        }
+        case V1_1::ExecutionPreference::FAST_SINGLE_ANSWER:
+        default:
+            // A single stream spread over all the cores
+            config[PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS] = "1";
+            config[PluginConfigParams::KEY_CPU_THREADS_NUM] = "0";
+            config[PluginConfigParams::KEY_CPU_BIND_THREAD] = PluginConfigParams::YES;
+            break;
+    }
+
+    // Keys tuned in the driver configuration file take precedence over the profile
+    const auto& pluginConfig = getDriverConfig().pluginConfig;
+    auto cpuConfig = pluginConfig.find("CPU");
+    if (cpuConfig != pluginConfig.end()) {
+        for (const auto& entry : cpuConfig->second) config[entry.first] = entry.second;
+    }
+    return config;
+}
+
+std::map<std::string, std::string> IENetwork::getGnaConfig() {
+    using namespace InferenceEngine;
+    std::map<std::string, std::string> config;
+
+#if __ANDROID__
+    config[GNAConfigParams::KEY_GNA_DEVICE_MODE] = GNAConfigParams::GNA_AUTO;
+#else
+    // Host builds have no GNA device, emulate it bit exactly unless configured otherwise
+    config[GNAConfigParams::KEY_GNA_DEVICE_MODE] = GNAConfigParams::GNA_SW_EXACT;
+#endif
+    const auto& pluginConfig = getDriverConfig().pluginConfig;
+    auto gnaConfig = pluginConfig.find("GNA");
+    if (gnaConfig != pluginConfig.end()) {
+        for (const auto& entry : gnaConfig->second) config[entry.first] = entry.second;
+    }
+    return config;
+}
+
+std::string IENetwork::getDeviceName() {
+    switch (mDeviceType) {
+        // Layers GNA can't run fall back to CPU inside the same executable network
+        case IntelDeviceType::GNA:
+            return "HETERO:GNA,CPU";
+        case IntelDeviceType::GPU:
+            return "GPU";
+        case IntelDeviceType::VPU:
+            return "MYRIAD";
+        case IntelDeviceType::CPU:
+        default:
+            return "CPU";
+    }
+}
+
 bool IENetwork::loadNetwork() {
     ALOGD("%s", __func__);
 
@@ -22,13 +114,44 @@ bool IENetwork::loadNetwork() {
 #else
     InferenceEngine::Core ie(std::string("/usr/local/lib64/plugins.xml"));
 #endif
-    std::map<std::string, std::string> config;
+    std::map<std::string, std::string> config = getPerformanceConfig();
+    const std::string deviceName = getDeviceName();
 
     if (mNetwork) {
-        mExecutableNw = ie.LoadNetwork(*mNetwork, "CPU");
-        ALOGD("LoadNetwork is done....");
-        mInferRequest = mExecutableNw.CreateInferRequest();
+        // Set per plugin, so that the HETERO device forwards each config to its own plugin only
+        ie.SetConfig(config, "CPU");
+        if (mDeviceType == IntelDeviceType::GNA) ie.SetConfig(getGnaConfig(), "GNA");
+        TraceEvent loadTrace("LoadNetwork");
+        mExecutableNw = ie.LoadNetwork(*mNetwork, deviceName);
+        loadTrace.end();
+        ALOGD("LoadNetwork on %s is done....", deviceName.c_str());
+
+        // As many requests as the plugin finds optimal, one per stream on CPU, so that concurrent
+        // executions keep all the streams busy. The states of a stateful network live in its
+        // request, so it gets a single one.
+        unsigned int numRequests = 1;
+        const auto function = mNetwork->getFunction();
+        const bool stateful = function && !function->get_sinks().empty();
+        if (!stateful) {
+            try {
+                numRequests = std::max(
+                    1u, mExecutableNw.GetMetric(METRIC_KEY(OPTIMAL_NUMBER_OF_INFER_REQUESTS))
+                            .as<unsigned int>());
+            } catch (const std::exception& ex) {
+                ALOGD("%s optimal number of requests unavailable: %s", __func__, ex.what());
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mInferRequestsMutex);
+            mFreeInferRequests.clear();
+            for (unsigned int i = 0; i < numRequests; i++)
+                mFreeInferRequests.push_back(mExecutableNw.CreateInferRequest());
+        }
         ALOGD("CreateInfereRequest is done....");
+        ALOGI("Execution profile %s, streams %s, %u infer requests",
+              getExecutionProfileName(mPreference),
+              config[InferenceEngine::PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS].c_str(),
+              numRequests);
 
         mInputInfo = mNetwork->getInputsInfo();
         mOutputInfo = mNetwork->getOutputsInfo();
@@ -57,24 +180,85 @@ void IENetwork::prepareOutput(InferenceEngine::Precision precision,
     output->setLayout(layout);
 }
 
-void IENetwork::setBlob(const std::string& inName, const InferenceEngine::Blob::Ptr& inputBlob) {
+InferenceEngine::InferRequest IENetwork::acquireInferRequest() {
+    std::unique_lock<std::mutex> lock(mInferRequestsMutex);
+    mInferRequestReturned.wait(lock, [this] { return !mFreeInferRequests.empty(); });
+    auto request = mFreeInferRequests.back();
+    mFreeInferRequests.pop_back();
+    return request;
+}
+
+void IENetwork::releaseInferRequest(const InferenceEngine::InferRequest& request) {
+    {
+        std::lock_guard<std::mutex> lock(mInferRequestsMutex);
+        mFreeInferRequests.push_back(request);
+    }
+    mInferRequestReturned.notify_one();
+}
+
+void IENetwork::setBlob(InferenceEngine::InferRequest& request, const std::string& inName,
+                        const InferenceEngine::Blob::Ptr& inputBlob) {
     ALOGI("setBlob input or output blob name : %s", inName.c_str());
-    mInferRequest.SetBlob(inName, inputBlob);
+    request.SetBlob(inName, inputBlob);
 }
 
-InferenceEngine::TBlob<float>::Ptr IENetwork::getBlob(const std::string& outName) {
+InferenceEngine::TBlob<float>::Ptr IENetwork::getBlob(InferenceEngine::InferRequest& request,
+                                                      const std::string& outName) {
     InferenceEngine::Blob::Ptr outputBlob;
-    outputBlob = mInferRequest.GetBlob(outName);
+    outputBlob = request.GetBlob(outName);
     return android::hardware::neuralnetworks::nnhal::As<InferenceEngine::TBlob<float>>(outputBlob);
 }
 
-void IENetwork::infer() {
+// The states live in the only request of a stateful network, so no execution runs while they are
+// reset
+void IENetwork::resetState() {
+    InferenceEngine::InferRequest request = acquireInferRequest();
+    try {
+        for (auto& state : request.QueryState()) state.Reset();
+    } catch (...) {
+        releaseInferRequest(request);
+        throw;
+    }
+    releaseInferRequest(request);
+}
+
+void IENetwork::infer(InferenceEngine::InferRequest& request) {
     ALOGI("Infer Network\n");
-    mInferRequest.StartAsync();
-    mInferRequest.Wait(10000);
+    if (mPreference == V1_1::ExecutionPreference::FAST_SINGLE_ANSWER) {
+        // Run on the calling thread, skipping the hand-off to the plugin's executor
+        request.Infer();
+    } else {
+        request.StartAsync();
+        const auto status = request.Wait(InferenceEngine::InferRequest::WaitMode::RESULT_READY);
+        // The callers report exceptions of the plugin as execution failures
+        if (status != InferenceEngine::StatusCode::OK)
+            throw std::runtime_error("infer request failed with status " +
+                                     std::to_string(static_cast<int>(status)));
+    }
     ALOGI("infer request completed");
 }
 
+bool IENetwork::infer(InferenceEngine::InferRequest& request, std::chrono::nanoseconds timeout) {
+    // Rounded up, a zero wait would only poll the request
+    const auto timeoutMs =
+        std::max<int64_t>(1, std::chrono::ceil<std::chrono::milliseconds>(timeout).count());
+    ALOGI("Infer Network, timeout %lld ms", static_cast<long long>(timeoutMs));
+    request.StartAsync();
+    if (request.Wait(timeoutMs) == InferenceEngine::StatusCode::OK) {
+        ALOGI("infer request completed");
+        return true;
+    }
+    request.Cancel();
+    // The request goes back to the pool, so it must be idle when this execution returns
+    try {
+        request.Wait(InferenceEngine::InferRequest::WaitMode::RESULT_READY);
+    } catch (const std::exception& ex) {
+        ALOGD("%s cancelled request: %s", __func__, ex.what());
+    }
+    ALOGE("%s infer request cancelled after %lld ms", __func__, static_cast<long long>(timeoutMs));
+    return false;
+}
+
 }  // namespace nnhal
 }  // namespace neuralnetworks
 }  // namespace hardware
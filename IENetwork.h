@@ -6,6 +6,9 @@
 #include <ie_executable_network.hpp>
 #include <ie_infer_request.hpp>
 #include <ie_input_info.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 
 #include "utils.h"
@@ -23,41 +26,90 @@ class IIENetwork {
 public:
     virtual ~IIENetwork() {}
     virtual bool loadNetwork() = 0;
-    virtual InferenceEngine::InferRequest getInferRequest() = 0;
-    virtual void infer() = 0;
-    virtual void queryState() = 0;
-    virtual InferenceEngine::TBlob<float>::Ptr getBlob(const std::string& outName) = 0;
+    // Drops the CNNNetwork once it is loaded
+    virtual void releaseNetwork() = 0;
+    // Checks an idle request out of the pool of the network, waiting for one to be returned
+    // when all of them are running. Each execution runs on its own request, so the executions
+    // of a prepared model can overlap on the plugin streams.
+    virtual InferenceEngine::InferRequest acquireInferRequest() = 0;
+    virtual void releaseInferRequest(const InferenceEngine::InferRequest& request) = 0;
+    virtual void infer(InferenceEngine::InferRequest& request) = 0;
+    // Cancels the request once timeout elapsed, returning false. The plugin honors the
+    // cancellation between the layers it runs.
+    virtual bool infer(InferenceEngine::InferRequest& request,
+                       std::chrono::nanoseconds timeout) = 0;
+    // Sets the state variables of a stateful model back to their zero initial values
+    virtual void resetState() = 0;
+    virtual InferenceEngine::TBlob<float>::Ptr getBlob(InferenceEngine::InferRequest& request,
+                                                       const std::string& outName) = 0;
     virtual void prepareInput(InferenceEngine::Precision precision,
                               InferenceEngine::Layout layout) = 0;
     virtual void prepareOutput(InferenceEngine::Precision precision,
                                InferenceEngine::Layout layout) = 0;
-    virtual void setBlob(const std::string& inName,
+    virtual void setBlob(InferenceEngine::InferRequest& request, const std::string& inName,
                          const InferenceEngine::Blob::Ptr& inputBlob) = 0;
 };
 
+// Holds a request of the pool of a network for the scope of one execution
+class InferRequestLease {
+public:
+    explicit InferRequestLease(std::shared_ptr<IIENetwork> network)
+        : mNetwork(network), mRequest(network->acquireInferRequest()) {}
+    ~InferRequestLease() { mNetwork->releaseInferRequest(mRequest); }
+    InferRequestLease(const InferRequestLease&) = delete;
+    InferRequestLease& operator=(const InferRequestLease&) = delete;
+
+    InferenceEngine::InferRequest& get() { return mRequest; }
+
+private:
+    std::shared_ptr<IIENetwork> mNetwork;
+    InferenceEngine::InferRequest mRequest;
+};
+
 // Abstract this class for all accelerators
 class IENetwork : public IIENetwork {
 private:
     std::shared_ptr<InferenceEngine::CNNNetwork> mNetwork;
     InferenceEngine::ExecutableNetwork mExecutableNw;
-    InferenceEngine::InferRequest mInferRequest;
+    // The idle requests. A stateful network gets a single one, as its states live in the
+    // request, so its executions run one at a time.
+    std::vector<InferenceEngine::InferRequest> mFreeInferRequests;
+    std::mutex mInferRequestsMutex;
+    std::condition_variable mInferRequestReturned;
     InferenceEngine::InputsDataMap mInputInfo;
     InferenceEngine::OutputsDataMap mOutputInfo;
+    IntelDeviceType mDeviceType;
+    V1_1::ExecutionPreference mPreference;
+
+    std::string getDeviceName();
+    std::map<std::string, std::string> getPerformanceConfig();
+    std::map<std::string, std::string> getGnaConfig();
 
 public:
     IENetwork() : IENetwork(nullptr) {}
-    IENetwork(std::shared_ptr<InferenceEngine::CNNNetwork> network) : mNetwork(network) {}
+    IENetwork(std::shared_ptr<InferenceEngine::CNNNetwork> network,
+              IntelDeviceType deviceType = IntelDeviceType::CPU,
+              V1_1::ExecutionPreference preference = V1_1::ExecutionPreference::FAST_SINGLE_ANSWER)
+        : mNetwork(network), mDeviceType(deviceType), mPreference(preference) {}
 
     virtual bool loadNetwork();
+    void releaseNetwork() { mNetwork.reset(); }
     void prepareInput(InferenceEngine::Precision precision, InferenceEngine::Layout layout);
     void prepareOutput(InferenceEngine::Precision precision, InferenceEngine::Layout layout);
-    void setBlob(const std::string& inName, const InferenceEngine::Blob::Ptr& inputBlob);
-    InferenceEngine::TBlob<float>::Ptr getBlob(const std::string& outName);
-    InferenceEngine::InferRequest getInferRequest() { return mInferRequest; }
-    void queryState() {}
-    void infer();
+    void setBlob(InferenceEngine::InferRequest& request, const std::string& inName,
+                 const InferenceEngine::Blob::Ptr& inputBlob);
+    InferenceEngine::TBlob<float>::Ptr getBlob(InferenceEngine::InferRequest& request,
+                                               const std::string& outName);
+    InferenceEngine::InferRequest acquireInferRequest();
+    void releaseInferRequest(const InferenceEngine::InferRequest& request);
+    void resetState();
+    void infer(InferenceEngine::InferRequest& request);
+    bool infer(InferenceEngine::InferRequest& request, std::chrono::nanoseconds timeout);
+    V1_1::ExecutionPreference getExecutionPreference() { return mPreference; }
 };
 
+const char* getExecutionProfileName(V1_1::ExecutionPreference preference);
+
 }  // namespace nnhal
 }  // namespace neuralnetworks
 }  // namespace hardware
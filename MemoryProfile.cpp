@@ -0,0 +1,114 @@
+#include "MemoryProfile.h"
+
+#include <android/log.h>
+#include <log/log.h>
+#include <malloc.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#undef LOG_TAG
+#define LOG_TAG "MemoryProfile"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+constexpr double kMiB = 1024.0 * 1024.0;
+
+size_t getHeapBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    // The int fields of mallinfo wrap above 2GB
+    return mallinfo2().uordblks;
+#else
+    return mallinfo().uordblks;
+#endif
+}
+}  // namespace
+
+MemoryUsage getMemoryUsage() {
+    MemoryUsage usage;
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        size_t* field = nullptr;
+        if (line.compare(0, 6, "VmRSS:") == 0)
+            field = &usage.rssBytes;
+        else if (line.compare(0, 6, "VmHWM:") == 0)
+            field = &usage.peakRssBytes;
+        if (field) *field = std::stoull(line.substr(6)) * 1024;
+    }
+    usage.heapBytes = getHeapBytes();
+    return usage;
+}
+
+void MemoryProfile::start(bool resetPeak) {
+    mPeakResettable = false;
+    if (resetPeak) {
+        // Writing 5 to clear_refs resets VmHWM to the current RSS (Linux 4.0)
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5" << std::flush;
+        mPeakResettable = clearRefs.good();
+    }
+    mStart = mLast = getMemoryUsage();
+    mPeakRssBytes = mStart.rssBytes;
+    mStages.clear();
+    mFileBytes = 0;
+    mStarted = true;
+}
+
+void MemoryProfile::mark(const char* stage) {
+    if (!mStarted) return;
+    auto usage = getMemoryUsage();
+    mStages.push_back({stage, int64_t(usage.rssBytes) - int64_t(mLast.rssBytes),
+                       int64_t(usage.heapBytes) - int64_t(mLast.heapBytes)});
+    mPeakRssBytes = std::max(mPeakRssBytes, usage.rssBytes);
+    if (mPeakResettable) mPeakRssBytes = std::max(mPeakRssBytes, usage.peakRssBytes);
+    mLast = usage;
+}
+
+void MemoryProfile::addFile(const std::string& path) {
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) == 0) mFileBytes += fileStat.st_size;
+}
+
+void MemoryProfile::finish() {
+    if (!mStarted) return;
+    mark("release");
+    mSteadyRssBytes = int64_t(mLast.rssBytes) - int64_t(mStart.rssBytes);
+    mSteadyHeapBytes = int64_t(mLast.heapBytes) - int64_t(mStart.heapBytes);
+    for (const auto& stage : mStages) {
+        ALOGD("%s %s: rss %+.2f MiB, heap %+.2f MiB", __func__, stage.name.c_str(),
+              stage.rssBytes / kMiB, stage.heapBytes / kMiB);
+    }
+    ALOGI("%s peak %.2f MiB%s, steady state rss %.2f MiB heap %.2f MiB, files %.2f MiB", __func__,
+          getPeakBytes() / kMiB, mPeakResettable ? "" : " (sampled)", mSteadyRssBytes / kMiB,
+          mSteadyHeapBytes / kMiB, mFileBytes / kMiB);
+}
+
+int64_t MemoryProfile::getPeakBytes() const {
+    return int64_t(mPeakRssBytes) - int64_t(mStart.rssBytes);
+}
+
+std::string MemoryProfile::toString() const {
+    if (!mStarted) return "not profiled\n";
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(2);
+    out << "peak " << getPeakBytes() / kMiB << " MiB" << (mPeakResettable ? "" : " (sampled)")
+        << ", steady state rss " << mSteadyRssBytes / kMiB << " MiB heap "
+        << mSteadyHeapBytes / kMiB << " MiB, files " << mFileBytes / kMiB << " MiB\n";
+    for (const auto& stage : mStages) {
+        out << "  " << stage.name << ": rss " << std::showpos << stage.rssBytes / kMiB
+            << " MiB, heap " << stage.heapBytes / kMiB << std::noshowpos << " MiB\n";
+    }
+    return out.str();
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,70 @@
+#ifndef ANDROID_ML_NN_MEMORYPROFILE_H
+#define ANDROID_ML_NN_MEMORYPROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Resident set and malloc heap usage of the driver process
+struct MemoryUsage {
+    size_t rssBytes = 0;
+    // VmHWM, the peak RSS since the process started or since it was last reset
+    size_t peakRssBytes = 0;
+    size_t heapBytes = 0;
+};
+
+MemoryUsage getMemoryUsage();
+
+// Records the RSS and heap deltas of each stage of a model preparation, its peak RSS and the
+// footprint left once it completed. The figures are process wide, so concurrent preparations and
+// executions show up in each other's profiles.
+class MemoryProfile {
+public:
+    // With resetPeak, resets the process peak RSS through /proc/self/clear_refs when the kernel
+    // allows it, so that the peak covers this preparation only. That resets the peak of the
+    // whole process, so the driver leaves it to tools owning their process and reports the RSS
+    // sampled at each stage as the peak.
+    void start(bool resetPeak = false);
+    // Closes the stage started by the previous mark, or by start
+    void mark(const char* stage);
+    // Size of a file written while preparing, such as the serialized IR
+    void addFile(const std::string& path);
+    // Logs the profile. Called once the preparation released its temporaries.
+    void finish();
+
+    bool isStarted() const { return mStarted; }
+    // The peak RSS over the preparation, above the RSS when it started
+    int64_t getPeakBytes() const;
+    // The RSS and heap kept by the prepared model, as of finish
+    int64_t getSteadyRssBytes() const { return mSteadyRssBytes; }
+    int64_t getSteadyHeapBytes() const { return mSteadyHeapBytes; }
+    std::string toString() const;
+
+private:
+    struct Stage {
+        std::string name;
+        int64_t rssBytes;
+        int64_t heapBytes;
+    };
+
+    bool mStarted = false;
+    bool mPeakResettable = false;
+    MemoryUsage mStart, mLast;
+    size_t mPeakRssBytes = 0;
+    std::vector<Stage> mStages;
+    size_t mFileBytes = 0;
+    int64_t mSteadyRssBytes = 0, mSteadyHeapBytes = 0;
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_MEMORYPROFILE_H
@@ -8,10 +8,10 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-bool NnapiModelInfo::updateOutputshapes(size_t outputIndex, std::vector<size_t>& outputDims,
-                                        bool isLengthSufficient) {
-    auto& outputShapeDims = mOutputShapes[outputIndex].dimensions;
-    mOutputShapes[outputIndex].isSufficient = isLengthSufficient;
+bool NnapiModelInfo::updateOutputshapes(ExecutionContext& context, size_t outputIndex,
+                                        std::vector<size_t>& outputDims, bool isLengthSufficient) {
+    auto& outputShapeDims = context.outputShapes[outputIndex].dimensions;
+    context.outputShapes[outputIndex].isSufficient = isLengthSufficient;
     if (outputDims.size() < outputShapeDims.size()) {
         return false;
     }
@@ -24,21 +24,47 @@ bool NnapiModelInfo::updateOutputshapes(size_t outputIndex, std::vector<size_t>&
     return true;
 }
 
+void NnapiModelInfo::initOperandTable() {
+    const auto& operands = mSubgraph.operands;
+    const size_t count = operands.size();
+    size_t dimensionsCount = 0;
+    for (const auto& operand : operands) dimensionsCount += operand.dimensions.size();
+
+    mOperandTable.types.reserve(count);
+    mOperandTable.lifetimes.reserve(count);
+    mOperandTable.scales.reserve(count);
+    mOperandTable.zeroPoints.reserve(count);
+    mOperandTable.locations.reserve(count);
+    mOperandTable.dimensionOffsets.reserve(count + 1);
+    mOperandTable.dimensions.reserve(dimensionsCount);
+    for (const auto& operand : operands) {
+        mOperandTable.types.push_back(operand.type);
+        mOperandTable.lifetimes.push_back(operand.lifetime);
+        mOperandTable.scales.push_back(operand.scale);
+        mOperandTable.zeroPoints.push_back(operand.zeroPoint);
+        mOperandTable.locations.push_back(operand.location);
+        mOperandTable.dimensionOffsets.push_back(mOperandTable.dimensions.size());
+        mOperandTable.dimensions.insert(mOperandTable.dimensions.end(),
+                                        operand.dimensions.begin(), operand.dimensions.end());
+    }
+    mOperandTable.dimensionOffsets.push_back(mOperandTable.dimensions.size());
+}
+
 bool NnapiModelInfo::initializeRunTimeOperandInfo() {
     // initialize runtime operand info from model.
-    const size_t count = mModel.main.operands.size();
+    const size_t count = mSubgraph.operands.size();
     ALOGD("Operand size = %zu\n", count);
     if (!count) {
         ALOGE("NNERR:Operand Count is 0");
         return false;
     }
     mOperands.resize(count);
-    mOutputShapes.resize(mModel.main.outputIndexes.size());
+    mOutputShapes.resize(mSubgraph.outputIndexes.size());
 
     // Start by setting the runtime info to what's in the model.
     for (size_t i = 0; i < count; i++) {
-        const Operand& from = mModel.main.operands[i];
-        dumpOperand(i, mModel.main);
+        const Operand& from = mSubgraph.operands[i];
+        dumpOperand(i, mSubgraph);
         RunTimeOperandInfo& to = mOperands[i];
         to.dimensions.resize(from.dimensions.size());
         for (size_t j = 0; j < from.dimensions.size(); j++) {
@@ -73,6 +99,7 @@ bool NnapiModelInfo::initializeRunTimeOperandInfo() {
             case OperandType::TENSOR_QUANT8_ASYMM_SIGNED:
             case OperandType::TENSOR_QUANT8_SYMM:
             case OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL:
+            case OperandType::SUBGRAPH:
                 to.type = from.type;
                 break;
             default:
@@ -105,6 +132,8 @@ bool NnapiModelInfo::initializeRunTimeOperandInfo() {
             case OperandLifeTime::SUBGRAPH_INPUT:
             case OperandLifeTime::SUBGRAPH_OUTPUT:
             case OperandLifeTime::NO_VALUE:
+            // IF and WHILE read their subgraphs through getReferencedModelInfo
+            case OperandLifeTime::SUBGRAPH:
                 to.buffer = nullptr;
                 to.numberOfUsesLeft = 0;
                 break;
@@ -114,8 +143,8 @@ bool NnapiModelInfo::initializeRunTimeOperandInfo() {
         }
     }
 
-    for (uint32_t i = 0; i < mModel.main.outputIndexes.size(); i++) {
-        const uint32_t operandIndex = mModel.main.outputIndexes[i];
+    for (uint32_t i = 0; i < mSubgraph.outputIndexes.size(); i++) {
+        const uint32_t operandIndex = mSubgraph.outputIndexes[i];
         const RunTimeOperandInfo& from = mOperands[operandIndex];
         mOutputShapes[i].dimensions = from.dimensions;
         mOutputShapes[i].isSufficient = true;
@@ -124,6 +153,43 @@ bool NnapiModelInfo::initializeRunTimeOperandInfo() {
     return true;
 }
 
+bool NnapiModelInfo::findLoops() {
+    auto hasLoop = [](const V1_3::Subgraph& subgraph) {
+        for (const auto& operation : subgraph.operations)
+            if (operation.type == OperationType::WHILE) return true;
+        return false;
+    };
+    if (hasLoop(mSubgraph)) return true;
+    for (const auto& subgraph : mModel.referenced)
+        if (hasLoop(subgraph)) return true;
+    return false;
+}
+
+std::shared_ptr<NnapiModelInfo> NnapiModelInfo::getReferencedModelInfo(uint32_t operandIdx) {
+    if (getOperandLifetime(operandIdx) != OperandLifeTime::SUBGRAPH) {
+        ALOGE("%s operand %d is not a subgraph", __func__, operandIdx);
+        return nullptr;
+    }
+    const uint32_t subgraphIndex = getOperandLocation(operandIdx).offset;
+    auto it = mReferencedModelInfos.find(subgraphIndex);
+    if (it != mReferencedModelInfos.end()) return it->second;
+    if (subgraphIndex >= mModel.referenced.size()) {
+        ALOGE("%s operand %d references missing subgraph %d", __func__, operandIdx,
+              subgraphIndex);
+        return nullptr;
+    }
+
+    // Operand locations index the values and pools shared by all the subgraphs of the model, so
+    // the subgraph info reads them from this one's storage instead of copying and mapping them
+    auto modelInfo = std::shared_ptr<NnapiModelInfo>(new NnapiModelInfo(*this, subgraphIndex));
+    if (!mOperands.empty() && !modelInfo->initRuntimeInfo()) {
+        ALOGE("%s failed to initialize subgraph %d", __func__, subgraphIndex);
+        return nullptr;
+    }
+    mReferencedModelInfos[subgraphIndex] = modelInfo;
+    return modelInfo;
+}
+
 // TODO: Move it to Utils class
 template <typename T>
 T NnapiModelInfo::GetConstFromBuffer(const uint8_t* buf, uint32_t len) {
@@ -138,42 +204,45 @@ T NnapiModelInfo::GetConstFromBuffer(const uint8_t* buf, uint32_t len) {
 
 const uint8_t* NnapiModelInfo::GetOperandMemory(int index, uint32_t& lenOut) {
     ALOGV("%s", __func__);
-    const auto op = mModel.main.operands[index];
-    lenOut = op.location.length;
-    if (op.lifetime == OperandLifeTime::CONSTANT_COPY) {
+    const auto lifetime = getOperandLifetime(index);
+    const auto& location = getOperandLocation(index);
+    lenOut = location.length;
+    if (lifetime == OperandLifeTime::CONSTANT_COPY) {
         ALOGV("operand lifetime OperandLifeTime::CONSTANT_COPY");
-        if (op.location.poolIndex != 0) {
+        if (location.poolIndex != 0) {
             // ALOGE("CONSTANT_COPY expects poolIndex to be 0");
             nnAssert(false);
         }
-        return (const_cast<uint8_t*>(&mModel.operandValues[op.location.offset]));
-    } else if (op.lifetime == OperandLifeTime::CONSTANT_REFERENCE) {
+        return (const_cast<uint8_t*>(&mModel.operandValues[location.offset]));
+    } else if (lifetime == OperandLifeTime::CONSTANT_REFERENCE) {
         ALOGV("operand lifetime OperandLifeTime::CONSTANT_REFERENCE");
-        auto poolIndex = op.location.poolIndex;
+        auto poolIndex = location.poolIndex;
         auto& r = mPoolInfos[poolIndex];
-        return (const_cast<uint8_t*>(r.buffer + op.location.offset));
-    } else if (op.lifetime == OperandLifeTime::TEMPORARY_VARIABLE ||
-               op.lifetime == OperandLifeTime::SUBGRAPH_INPUT ||
-               op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT ||
-               op.lifetime == OperandLifeTime::NO_VALUE) {
+        return (const_cast<uint8_t*>(r.buffer + location.offset));
+    } else if (lifetime == OperandLifeTime::TEMPORARY_VARIABLE ||
+               lifetime == OperandLifeTime::SUBGRAPH_INPUT ||
+               lifetime == OperandLifeTime::SUBGRAPH_OUTPUT ||
+               lifetime == OperandLifeTime::NO_VALUE) {
         // ALOGD(
         //     "operand lifetime "
         //     "OperandLifeTime::MODEL_INPUT||MODEL_OUTPUT||NO_VALUE||TEMPORARY_VARIABLE");
-        lenOut = sizeOfData(op.type, op.dimensions);
-        ALOGV("operand lifetime(%d), type(%d), lenOut(%d)", op.lifetime, op.type, lenOut);
+        const auto type = getOperandType(index);
+        lenOut = sizeOfData(type, getOperandDimensions(index).toVector());
+        ALOGV("operand lifetime(%d), type(%d), lenOut(%d)", lifetime, type, lenOut);
         return nullptr;
     }
-    ALOGE("operand is expected to be const, but lifetime is %d", op.lifetime);
+    ALOGE("operand is expected to be const, but lifetime is %d", lifetime);
     nnAssert(false);  // temp fix since some time const operand set as TEMPORARY_VARIABLE
     return nullptr;
 }
 
 V1_3::ErrorStatus NnapiModelInfo::setRunTimePoolInfosFromHidlMemories(
-    const hidl_vec<V1_3::Request::MemoryPool>& pools) {
+    const hidl_vec<V1_3::Request::MemoryPool>& pools, ExecutionContext& context) {
     ALOGD("Number of pools: %zu", pools.size());
-    mRequestPoolInfos.resize(pools.size());
+    context.outputShapes = mOutputShapes;
+    context.requestPoolInfos.resize(pools.size());
     for (size_t i = 0; i < pools.size(); i++) {
-        auto& poolInfo = mRequestPoolInfos[i];
+        auto& poolInfo = context.requestPoolInfos[i];
         switch (pools[i].getDiscriminator()) {
             case V1_3::Request::MemoryPool::hidl_discriminator::hidlMemory:
                 if (!poolInfo.set(pools[i].hidlMemory())) {
@@ -196,12 +265,13 @@ V1_3::ErrorStatus NnapiModelInfo::setRunTimePoolInfosFromHidlMemories(
 }
 
 ErrorStatus NnapiModelInfo::setRunTimePoolInfosFromHidlMemories(
-    const hidl_vec<hidl_memory>& pools) {
+    const hidl_vec<hidl_memory>& pools, ExecutionContext& context) {
     ALOGD("Number of pools: %zu", pools.size());
 
-    mRequestPoolInfos.resize(pools.size());
+    context.outputShapes = mOutputShapes;
+    context.requestPoolInfos.resize(pools.size());
     for (size_t i = 0; i < pools.size(); i++) {
-        auto& poolInfo = mRequestPoolInfos[i];
+        auto& poolInfo = context.requestPoolInfos[i];
         if (!poolInfo.set(pools[i])) {
             ALOGE("Could not map memory pool !!!");
             return ErrorStatus::GENERAL_FAILURE;
@@ -211,61 +281,90 @@ ErrorStatus NnapiModelInfo::setRunTimePoolInfosFromHidlMemories(
     return ErrorStatus::NONE;
 }
 
+// The operands of the model are shared by concurrent executions, the request arguments are
+// only read
 void* NnapiModelInfo::getBlobFromMemoryPoolIn(const Request& request, uint32_t index,
-                                              uint32_t& rBufferLength) {
-    RunTimeOperandInfo& operand = mOperands[mModel.main.inputIndexes[index]];
+                                              uint32_t& rBufferLength,
+                                              const ExecutionContext& context) {
     const V1_0::RequestArgument& arg = request.inputs[index];
     auto poolIndex = arg.location.poolIndex;
-    nnAssert(poolIndex < mRequestPoolInfos.size());
-    auto& r = mRequestPoolInfos[poolIndex];
-
-    if (arg.dimensions.size() > 0) {
-        // It's the responsibility of the caller to validate that
-        // from.dimensions only modifies the dimensions that were
-        // unspecified in the model.  That's the case in SampleDriver.cpp
-        // with the call to validateRequest().
-        operand.dimensions = arg.dimensions;
-    }
+    nnAssert(poolIndex < context.requestPoolInfos.size());
+    auto& r = context.requestPoolInfos[poolIndex];
 
-    operand.buffer = r.buffer + arg.location.offset;
-    operand.length = arg.location.length;
-    ALOGI("%s Operand length:%d pointer:%p offset:%d pool index: %d", __func__, operand.length,
-          (r.buffer + arg.location.offset), arg.location.offset, poolIndex);
-    rBufferLength = operand.length;
+    ALOGI("%s Operand length:%d pointer:%p offset:%d pool index: %d", __func__,
+          arg.location.length, (r.buffer + arg.location.offset), arg.location.offset, poolIndex);
+    rBufferLength = arg.location.length;
 
     return (r.buffer + arg.location.offset);
 }
 
 void* NnapiModelInfo::getBlobFromMemoryPoolOut(const Request& request, uint32_t index,
-                                               uint32_t& rBufferLength) {
-    RunTimeOperandInfo& operand = mOperands[mModel.main.outputIndexes[index]];
+                                               uint32_t& rBufferLength,
+                                               const ExecutionContext& context) {
     const V1_0::RequestArgument& arg = request.outputs[index];
     auto poolIndex = arg.location.poolIndex;
-    nnAssert(poolIndex < mRequestPoolInfos.size());
-    auto& r = mRequestPoolInfos[poolIndex];
-
-    ALOGD("%s lifetime:%d location offset:%d length:%d pool index:%d", __func__, operand.lifetime,
-          arg.location.offset, arg.location.length, poolIndex);
-
-    if (arg.dimensions.size() > 0) {
-        // It's the responsibility of the caller to validate that
-        // from.dimensions only modifies the dimensions that were
-        // unspecified in the model.  That's the case in SampleDriver.cpp
-        // with the call to validateRequest().
-        operand.dimensions = arg.dimensions;
-    }
+    nnAssert(poolIndex < context.requestPoolInfos.size());
+    auto& r = context.requestPoolInfos[poolIndex];
+
+    ALOGD("%s location offset:%d length:%d pool index:%d", __func__, arg.location.offset,
+          arg.location.length, poolIndex);
 
-    operand.buffer = r.buffer + arg.location.offset;
-    operand.length = arg.location.length;
-    rBufferLength = operand.length;
-    ALOGI("%s Operand length:%d pointer:%p", __func__, operand.length,
+    rBufferLength = arg.location.length;
+    ALOGI("%s Operand length:%d pointer:%p", __func__, arg.location.length,
           (r.buffer + arg.location.offset));
     return (r.buffer + arg.location.offset);
 }
 
+bool NnapiModelInfo::mapPools() {
+    if (mStorage->poolsMapped) return true;
+    mPoolInfos.resize(mModel.pools.size());
+    for (size_t i = 0; i < mModel.pools.size(); i++) {
+        auto& poolInfo = mPoolInfos[i];
+        if (!poolInfo.set(mModel.pools[i])) {
+            ALOGE("Could not map pool");
+            return false;
+        }
+    }
+    mStorage->poolsMapped = true;
+    return true;
+}
+
+std::vector<const uint8_t*> NnapiModelInfo::getPoolBuffers() const {
+    std::vector<const uint8_t*> buffers;
+    buffers.reserve(mPoolInfos.size());
+    for (const auto& poolInfo : mPoolInfos) buffers.push_back(poolInfo.buffer);
+    return buffers;
+}
+
+size_t NnapiModelInfo::releaseModelData(bool releaseConstants) {
+    for (auto& operand : mOperands) {
+        if (operand.lifetime == OperandLifeTime::CONSTANT_COPY ||
+            operand.lifetime == OperandLifeTime::CONSTANT_REFERENCE)
+            operand.buffer = nullptr;
+    }
+    auto& model = mStorage->model;
+    model.main.operations = hidl_vec<Operation>();
+    // Subgraph infos refer to the referenced subgraphs, only their operations are released
+    for (auto& subgraph : model.referenced) subgraph.operations = hidl_vec<Operation>();
+    // Constants built from a subgraph keep its model info alive as long as the graph needs it
+    mReferencedModelInfos.clear();
+    if (!releaseConstants) return 0;
+
+    size_t released = model.operandValues.size();
+    for (auto& poolInfo : mPoolInfos) {
+        released += poolInfo.hidlMemory.size();
+        poolInfo.unmap_mem();
+    }
+    // Dropping the IMemory references unmaps the ashmem pools
+    mPoolInfos.clear();
+    model.operandValues = hidl_vec<uint8_t>();
+    model.pools = hidl_vec<hidl_memory>();
+    return released;
+}
+
 bool NnapiModelInfo::isOmittedInput(int operationIndex, uint32_t index) {
-    uint32_t inputIndex = mModel.main.operations[operationIndex].inputs[index];
-    const auto op = mModel.main.operands[inputIndex];
+    uint32_t inputIndex = mSubgraph.operations[operationIndex].inputs[index];
+    const auto op = mSubgraph.operands[inputIndex];
     if (op.lifetime == OperandLifeTime::NO_VALUE) {
         ALOGD("index %d has life time NO_VALUE", index);
         return true;
@@ -5,6 +5,9 @@
 #include <android/log.h>
 #include <hidlmemory/mapping.h>
 #include <log/log.h>
+#include <cstring>
+#include <map>
+#include <memory>
 #include "ie_blob.h"
 
 #include "Driver.h"
@@ -22,41 +25,91 @@ using ::android::hidl::memory::V1_0::IMemory;
 
 using Blob = InferenceEngine::Blob;
 
+// The dimensions of one operand, pointing into the operand table of the NnapiModelInfo it came
+// from
+class OperandDimensions {
+public:
+    OperandDimensions(const uint32_t* data, size_t size) : mData(data), mSize(size) {}
+
+    const uint32_t* begin() const { return mData; }
+    const uint32_t* end() const { return mData + mSize; }
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+    uint32_t operator[](size_t index) const { return mData[index]; }
+    std::vector<uint32_t> toVector() const { return std::vector<uint32_t>(begin(), end()); }
+
+private:
+    const uint32_t* mData;
+    size_t mSize;
+};
+
+// The request memory pools and output shapes of one execution. Each execution has its own, so
+// that the executions of a prepared model can run concurrently. The pools are unmapped when the
+// execution ends.
+struct ExecutionContext {
+    std::vector<RunTimePoolInfo> requestPoolInfos;
+    std::vector<V1_2::OutputShape> outputShapes;
+
+    ExecutionContext() = default;
+    ExecutionContext(const ExecutionContext&) = delete;
+    ExecutionContext& operator=(const ExecutionContext&) = delete;
+    ~ExecutionContext() {
+        for (auto& poolInfo : requestPoolInfos) poolInfo.unmap_mem();
+    }
+};
+
 // Utility class that provides functions and methods around NNAPI Model
 class NnapiModelInfo {
 public:
-    NnapiModelInfo(const Model& model) : mModel(model) {}
+    NnapiModelInfo(const Model& model)
+        : mStorage(std::make_shared<ModelStorage>(model)),
+          mModel(mStorage->model),
+          mSubgraph(mModel.main),
+          mPoolInfos(mStorage->poolInfos) {
+        initOperandTable();
+        mHasLoops = findLoops();
+    }
+
+    // Model info reading the caller's model in place instead of copying it, for support queries
+    // that do not outlive the model.
+    static std::shared_ptr<NnapiModelInfo> createForQuery(const Model& model) {
+        return std::shared_ptr<NnapiModelInfo>(new NnapiModelInfo(model, true));
+    }
+
+    // Maps the model pools, once. Support queries map them too, as validation reads parameters
+    // stored there.
+    bool mapPools();
 
     bool initRuntimeInfo() {
-        mPoolInfos.resize(mModel.pools.size());
-        for (size_t i = 0; i < mModel.pools.size(); i++) {
-            auto& poolInfo = (mPoolInfos)[i];
-            if (!poolInfo.set(mModel.pools[i])) {
-                ALOGE("Could not map pool");
-                return false;
-            }
-        }
+        if (!mapPools()) return false;
         if (!initializeRunTimeOperandInfo()) return false;
 
         return true;
     }
+
+    // One buffer per model pool, mapPools() must have succeeded
+    std::vector<const uint8_t*> getPoolBuffers() const;
     // Copy model input indices to a seperate vector
-    const auto& getModelInputIndexes() { return mModel.main.inputIndexes; }
+    const auto& getModelInputIndexes() { return mSubgraph.inputIndexes; }
 
-    uint32_t getModelInputIndex(uint32_t index) { return mModel.main.inputIndexes[index]; }
+    uint32_t getModelInputIndex(uint32_t index) { return mSubgraph.inputIndexes[index]; }
 
-    uint32_t getModelOutputIndex(uint32_t index) { return mModel.main.outputIndexes[index]; }
+    uint32_t getModelOutputIndex(uint32_t index) { return mSubgraph.outputIndexes[index]; }
 
-    size_t getModelOutputsSize() { return mModel.main.outputIndexes.size(); }
+    size_t getModelOutputsSize() { return mSubgraph.outputIndexes.size(); }
 
     // Index into the operand vector
     V1_3::OperandLifeTime getOperandLifetime(uint32_t operandIdx) {
-        auto tmpOperand = mModel.main.operands[operandIdx];
-        return tmpOperand.lifetime;
+        return mOperandTable.lifetimes[operandIdx];
+    }
+    OperandType getOperandType(uint32_t operandIdx) { return mOperandTable.types[operandIdx]; }
+    OperandDimensions getOperandDimensions(uint32_t operandIdx) {
+        const auto offset = mOperandTable.dimensionOffsets[operandIdx];
+        return OperandDimensions(mOperandTable.dimensions.data() + offset,
+                                 mOperandTable.dimensionOffsets[operandIdx + 1] - offset);
     }
-    OperandType getOperandType(uint32_t operandIdx) {
-        auto tmpOperand = mModel.main.operands[operandIdx];
-        return tmpOperand.type;
+    const V1_0::DataLocation& getOperandLocation(uint32_t operandIdx) {
+        return mOperandTable.locations[operandIdx];
     }
 
     bool isOperandLifeTimeTemp(uint32_t operandIdx) {
@@ -77,51 +130,39 @@ public:
         return GetConstFromBuffer<T>(buf, len);
     }
 
-    const auto& getOperations() { return mModel.main.operations; }
+    const auto& getOperations() { return mSubgraph.operations; }
     const auto& getOperationOutput(int operationIndex, uint32_t outputIndex) {
-        return mModel.main.operations[operationIndex].outputs[outputIndex];
+        return mSubgraph.operations[operationIndex].outputs[outputIndex];
     }
     const auto& getOperationInput(int operationIndex, uint32_t inputIndex) {
-        return mModel.main.operations[operationIndex].inputs[inputIndex];
+        return mSubgraph.operations[operationIndex].inputs[inputIndex];
     }
     size_t getOperationInputsSize(int operationIndex) {
-        return mModel.main.operations[operationIndex].inputs.size();
+        return mSubgraph.operations[operationIndex].inputs.size();
     }
     size_t getOperationOutputsSize(int operationIndex) {
-        return mModel.main.operations[operationIndex].outputs.size();
+        return mSubgraph.operations[operationIndex].outputs.size();
     }
 
-    size_t getOperationsSize() { return mModel.main.operations.size(); }
+    size_t getOperationsSize() { return mSubgraph.operations.size(); }
 
-    const auto& getOperationType(int index) { return mModel.main.operations[index].type; }
+    const auto& getOperationType(int index) { return mSubgraph.operations[index].type; }
 
-    const Operand& getOperand(int index) { return mModel.main.operands[index]; }
+    const Operand& getOperand(int index) { return mSubgraph.operands[index]; }
 
-    size_t getOperandsSize() { return mModel.main.operands.size(); }
+    size_t getOperandsSize() { return mSubgraph.operands.size(); }
 
-    float getOperandScale(int index) {
-        auto operand = getOperand(index);
-        return operand.scale;
-    }
+    float getOperandScale(int index) { return mOperandTable.scales[index]; }
 
-    int32_t getOperandZeroPoint(int index) {
-        auto operand = getOperand(index);
-        return operand.zeroPoint;
-    }
+    int32_t getOperandZeroPoint(int index) { return mOperandTable.zeroPoints[index]; }
 
     RunTimeOperandInfo& getRuntimeOperand(uint32_t index) {
-        return mOperands[mModel.main.inputIndexes[index]];
+        return mOperands[mSubgraph.inputIndexes[index]];
     }
 
     bool isConstOperand(int index) {
-        ALOGD("---------------------------------------------");
-        ALOGD("Operand index: %d", index);
-        const auto op = mModel.main.operands[index];
-        ALOGD(" %s", toString(op).c_str());
-        bool ret = (op.lifetime == OperandLifeTime::CONSTANT_COPY ||
-                    op.lifetime == OperandLifeTime::CONSTANT_REFERENCE);
-        ALOGD("%s", ret ? "Const" : "Non-Const");
-        ALOGD("---------------------------------------------");
+        bool ret = isOperandLifeTimeConst(index);
+        ALOGV("Operand index: %d %s", index, ret ? "Const" : "Non-Const");
         return ret;
     }
 
@@ -129,11 +170,11 @@ public:
 
     template <typename T>
     T ParseOperationInput(int operationIndex, uint32_t index) {
-        uint32_t inputIndex = mModel.main.operations[operationIndex].inputs[index];
-        const auto operand = mModel.main.operands[inputIndex];
+        uint32_t inputIndex = mSubgraph.operations[operationIndex].inputs[index];
+        const auto& operand = mSubgraph.operands[inputIndex];
         const auto value = GetConstOperand<T>(inputIndex);
         ALOGV("Operation input index: %d, operand index: %d", index, inputIndex);
-        ALOGV("Operation: %s", toString(mModel.main.operations[operationIndex]).c_str());
+        ALOGV("Operation: %s", toString(mSubgraph.operations[operationIndex]).c_str());
         printHelper<T>::print(value, toString(operand).c_str());
 
         return value;
@@ -148,11 +189,8 @@ public:
             nnAssert(false);
         }
 
-        std::vector<T> ret;
-        for (int i = 0; i < n; i++) {
-            ret.push_back(*(T*)buf);
-            buf += sizeof(T);
-        }
+        std::vector<T> ret(n);
+        if (n > 0) std::memcpy(ret.data(), buf, len);
         return ret;
     }
 
@@ -167,43 +205,107 @@ public:
     template <typename T>
     T GetConstFromBuffer(const uint8_t* buf, uint32_t len);
 
-    void* getBlobFromMemoryPoolIn(const Request& request, uint32_t index, uint32_t& rBufferLength);
-    void* getBlobFromMemoryPoolOut(const Request& request, uint32_t index, uint32_t& rBufferLength);
+    void* getBlobFromMemoryPoolIn(const Request& request, uint32_t index, uint32_t& rBufferLength,
+                                  const ExecutionContext& context);
+    void* getBlobFromMemoryPoolOut(const Request& request, uint32_t index, uint32_t& rBufferLength,
+                                   const ExecutionContext& context);
 
     Model getModel() { return mModel; }
 
-    ErrorStatus setRunTimePoolInfosFromHidlMemories(const hidl_vec<hidl_memory>& pools);
+    // Model info of the referenced subgraph an IF or WHILE operand of lifetime SUBGRAPH points
+    // to, built on first use. It shares the model copy and mapped pools of this one, and its
+    // runtime info is initialized when this model's is. Returns nullptr when it cannot be built.
+    std::shared_ptr<NnapiModelInfo> getReferencedModelInfo(uint32_t operandIdx);
+
+    // Whether a subgraph of the model has a WHILE operation, making its executions subject to
+    // the loop timeout. Kept once the model data is released.
+    bool hasLoops() { return mHasLoops; }
+
+    // Maps the request pools of an execution into context and resets its output shapes to the
+    // model ones
+    ErrorStatus setRunTimePoolInfosFromHidlMemories(const hidl_vec<hidl_memory>& pools,
+                                                    ExecutionContext& context);
     V1_3::ErrorStatus setRunTimePoolInfosFromHidlMemories(
-        const hidl_vec<V1_3::Request::MemoryPool>& pools);
+        const hidl_vec<V1_3::Request::MemoryPool>& pools, ExecutionContext& context);
 
-    bool updateRequestPoolInfos() {
-        for (auto runtimeInfo : mRequestPoolInfos) {
+    bool updateRequestPoolInfos(ExecutionContext& context) {
+        for (auto& runtimeInfo : context.requestPoolInfos) {
             runtimeInfo.update();
         }
 
         return true;
     }
 
-    std::vector<V1_2::OutputShape> getOutputShapes() { return mOutputShapes; }
-
-    void unmapRuntimeMemPools() {
-        for (auto runtimeInfo : mRequestPoolInfos) {
-            runtimeInfo.unmap_mem();
-        }
-    }
+    // Drops what only building the graph reads: the operations and the referenced subgraph infos,
+    // and with releaseConstants the operand values and the mapped pools the constants were built
+    // from. Only plugins that copy the weights at LoadNetwork can release the constants, the
+    // others may alias them. The operands and the model inputs and outputs stay, executions read
+    // them. Returns the bytes of constants released.
+    size_t releaseModelData(bool releaseConstants);
 
     bool isOmittedInput(int operationIndex, uint32_t index);
-    bool updateOutputshapes(size_t outputIndex, std::vector<size_t>& outputShape,
-                            bool isLengthSufficient = true);
+    bool updateOutputshapes(ExecutionContext& context, size_t outputIndex,
+                            std::vector<size_t>& outputShape, bool isLengthSufficient = true);
 
 private:
+    // Operand metadata laid out per field, so that the lookups done for every operation input
+    // while building the graph and for every request argument neither copy an Operand nor
+    // allocate. Built once with the model info, as support queries never call initRuntimeInfo.
+    struct OperandTable {
+        std::vector<OperandType> types;
+        std::vector<OperandLifeTime> lifetimes;
+        std::vector<float> scales;
+        std::vector<int32_t> zeroPoints;
+        std::vector<V1_0::DataLocation> locations;
+        // The dimensions of operand i are dimensions[dimensionOffsets[i], dimensionOffsets[i + 1])
+        std::vector<uint32_t> dimensionOffsets;
+        std::vector<uint32_t> dimensions;
+    };
+
+    void initOperandTable();
     bool initializeRunTimeOperandInfo();
+    bool findLoops();
+
+    // Copy of the model and its mapped pools. Empty model for a query reading the caller's one.
+    struct ModelStorage {
+        ModelStorage() = default;
+        ModelStorage(const Model& model) : model(model) {}
+
+        Model model;
+        std::vector<RunTimePoolInfo> poolInfos;
+        bool poolsMapped = false;
+    };
+
+    NnapiModelInfo(const Model& model, bool /*borrowed*/)
+        : mStorage(std::make_shared<ModelStorage>()),
+          mModel(model),
+          mSubgraph(mModel.main),
+          mPoolInfos(mStorage->poolInfos) {
+        initOperandTable();
+        mHasLoops = findLoops();
+    }
+
+    // Info of a referenced subgraph, sharing the model and mapped pools of its parent
+    NnapiModelInfo(const NnapiModelInfo& parent, uint32_t subgraphIndex)
+        : mStorage(parent.mStorage),
+          mModel(parent.mModel),
+          mSubgraph(mModel.referenced[subgraphIndex]),
+          mPoolInfos(mStorage->poolInfos) {
+        initOperandTable();
+        mHasLoops = findLoops();
+    }
 
-    Model mModel;  // TODO: Do we need a new copy of model??
-    std::vector<RunTimePoolInfo> mPoolInfos;
+    std::shared_ptr<ModelStorage> mStorage;
+    const Model& mModel;
+    // Main subgraph of mModel, or the referenced subgraph this info was built for
+    const V1_3::Subgraph& mSubgraph;
+    OperandTable mOperandTable;
+    std::vector<RunTimePoolInfo>& mPoolInfos;
     std::vector<RunTimeOperandInfo> mOperands;
-    std::vector<RunTimePoolInfo> mRequestPoolInfos;
     std::vector<V1_2::OutputShape> mOutputShapes;
+    // Keyed by index into mModel.referenced
+    std::map<uint32_t, std::shared_ptr<NnapiModelInfo>> mReferencedModelInfos;
+    bool mHasLoops = false;
 };
 
 }  // namespace nnhal
@@ -0,0 +1,146 @@
+#include "ModelSupportCache.h"
+
+#include <log/log.h>
+
+#undef LOG_TAG
+#define LOG_TAG "ModelSupportCache"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+// 64 bit FNV-1a
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+void hashBytes(uint64_t& hash, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+}
+
+template <typename T>
+void hashValue(uint64_t& hash, const T& value) {
+    hashBytes(hash, &value, sizeof(T));
+}
+
+template <typename T>
+void hashVector(uint64_t& hash, const hidl_vec<T>& values) {
+    hashValue(hash, values.size());
+    if (values.size() > 0) hashBytes(hash, values.data(), values.size() * sizeof(T));
+}
+
+void hashSubgraph(uint64_t& hash, const V1_3::Subgraph& subgraph) {
+    hashValue(hash, subgraph.operands.size());
+    for (const auto& operand : subgraph.operands) {
+        hashValue(hash, operand.type);
+        hashVector(hash, operand.dimensions);
+        hashValue(hash, operand.scale);
+        hashValue(hash, operand.zeroPoint);
+        hashValue(hash, operand.lifetime);
+        hashValue(hash, operand.location.poolIndex);
+        hashValue(hash, operand.location.offset);
+        hashValue(hash, operand.location.length);
+        if (operand.extraParams.getDiscriminator() ==
+            V1_2::Operand::ExtraParams::hidl_discriminator::channelQuant) {
+            hashVector(hash, operand.extraParams.channelQuant().scales);
+            hashValue(hash, operand.extraParams.channelQuant().channelDim);
+        }
+    }
+    hashValue(hash, subgraph.operations.size());
+    for (const auto& operation : subgraph.operations) {
+        hashValue(hash, operation.type);
+        hashVector(hash, operation.inputs);
+        hashVector(hash, operation.outputs);
+    }
+    hashVector(hash, subgraph.inputIndexes);
+    hashVector(hash, subgraph.outputIndexes);
+}
+
+// Operand types of the parameters validation reads (scalars, axes, shapes, paddings, ...)
+bool isParameterType(V1_3::OperandType type) {
+    switch (type) {
+        case V1_3::OperandType::FLOAT16:
+        case V1_3::OperandType::FLOAT32:
+        case V1_3::OperandType::INT32:
+        case V1_3::OperandType::UINT32:
+        case V1_3::OperandType::BOOL:
+        case V1_3::OperandType::TENSOR_INT32:
+        case V1_3::OperandType::TENSOR_BOOL8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void hashPoolParameters(uint64_t& hash, const V1_3::Subgraph& subgraph,
+                        const std::vector<const uint8_t*>& poolBuffers) {
+    for (const auto& operand : subgraph.operands) {
+        if (operand.lifetime != V1_3::OperandLifeTime::CONSTANT_REFERENCE ||
+            !isParameterType(operand.type))
+            continue;
+        const auto& location = operand.location;
+        if (location.poolIndex >= poolBuffers.size() || !poolBuffers[location.poolIndex]) {
+            // Cannot happen for mapped pools, keep such models apart from the rest anyway
+            hashValue(hash, kFnvPrime);
+            continue;
+        }
+        hashBytes(hash, poolBuffers[location.poolIndex] + location.offset, location.length);
+    }
+}
+}  // namespace
+
+uint64_t getModelFingerprint(const V1_3::Model& model,
+                             const std::vector<const uint8_t*>& poolBuffers) {
+    uint64_t hash = kFnvOffsetBasis;
+    hashSubgraph(hash, model.main);
+    hashPoolParameters(hash, model.main, poolBuffers);
+    hashValue(hash, model.referenced.size());
+    for (const auto& subgraph : model.referenced) {
+        hashSubgraph(hash, subgraph);
+        hashPoolParameters(hash, subgraph, poolBuffers);
+    }
+    hashVector(hash, model.operandValues);
+    hashValue(hash, model.pools.size());
+    for (const auto& pool : model.pools) hashValue(hash, pool.size());
+    hashValue(hash, model.relaxComputationFloat32toFloat16);
+    return hash;
+}
+
+bool ModelSupportCache::lookup(uint64_t fingerprint, ModelSupportInfo& info) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        if (it->first == fingerprint) {
+            // Move the entry to the front to keep the most recently used models cached
+            mEntries.splice(mEntries.begin(), mEntries, it);
+            info = mEntries.front().second;
+            mHits.fetch_add(1, std::memory_order_relaxed);
+            ALOGD("%s hit for fingerprint %016llx", __func__, (unsigned long long)fingerprint);
+            return true;
+        }
+    }
+    mMisses.fetch_add(1, std::memory_order_relaxed);
+    ALOGD("%s miss for fingerprint %016llx", __func__, (unsigned long long)fingerprint);
+    return false;
+}
+
+void ModelSupportCache::insert(uint64_t fingerprint, const ModelSupportInfo& info) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        if (it->first == fingerprint) {
+            mEntries.erase(it);
+            break;
+        }
+    }
+    mEntries.emplace_front(fingerprint, info);
+    if (mEntries.size() > mCapacity) mEntries.pop_back();
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
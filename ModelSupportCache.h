@@ -0,0 +1,65 @@
+#ifndef ANDROID_ML_NN_MODELSUPPORTCACHE_H
+#define ANDROID_ML_NN_MODELSUPPORTCACHE_H
+
+#include <android/hardware/neuralnetworks/1.3/types.h>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Cheap structural hash of a NNAPI Model. Covers the operations, operands, CONSTANT_COPY values,
+// pool sizes and the CONSTANT_REFERENCE scalars and integer tensors operation validation reads,
+// found through poolBuffers (one mapped buffer per model pool). Float and quantized tensors in
+// the pools are left out, so that large weight buffers are never read to answer a support query.
+uint64_t getModelFingerprint(const V1_3::Model& model,
+                             const std::vector<const uint8_t*>& poolBuffers);
+
+// Per-operation verdicts of a getSupportedOperations query, kept so that the prepareModel call
+// the runtime issues right after it can skip re-validating the same model. prepareModel still
+// creates the operation objects and parses their parameters when building the graph.
+struct ModelSupportInfo {
+    std::vector<bool> supportedOperations;
+    std::vector<V1_3::OperationType> operationTypes;
+
+    bool isFullySupported() const {
+        for (auto supported : supportedOperations)
+            if (!supported) return false;
+        return true;
+    }
+};
+
+// Small LRU cache of ModelSupportInfo keyed by model fingerprint. Safe to use from concurrent
+// binder threads.
+class ModelSupportCache {
+public:
+    ModelSupportCache(size_t capacity = kDefaultCapacity) : mCapacity(capacity) {}
+
+    bool lookup(uint64_t fingerprint, ModelSupportInfo& info);
+    void insert(uint64_t fingerprint, const ModelSupportInfo& info);
+
+    uint64_t getHits() const { return mHits.load(std::memory_order_relaxed); }
+    uint64_t getMisses() const { return mMisses.load(std::memory_order_relaxed); }
+    size_t getCapacity() const { return mCapacity; }
+
+private:
+    static constexpr size_t kDefaultCapacity = 16;
+
+    size_t mCapacity;
+    std::mutex mMutex;
+    std::list<std::pair<uint64_t, ModelSupportInfo>> mEntries;
+    // Read by the Driver dump without taking mMutex
+    std::atomic<uint64_t> mHits{0};
+    std::atomic<uint64_t> mMisses{0};
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_MODELSUPPORTCACHE_H
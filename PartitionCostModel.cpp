@@ -0,0 +1,202 @@
+#include "PartitionCostModel.h"
+
+#include <log/log.h>
+#include <algorithm>
+#include <cinttypes>
+#include <map>
+#include <numeric>
+#include <set>
+
+#include "utils.h"
+
+#undef LOG_TAG
+#define LOG_TAG "PartitionCostModel"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+constexpr uint32_t kNoProducer = UINT32_MAX;
+
+bool isScalar(OperandType type) {
+    switch (type) {
+        case OperandType::FLOAT32:
+        case OperandType::INT32:
+        case OperandType::UINT32:
+        case OperandType::BOOL:
+        case OperandType::FLOAT16:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isConstant(const Operand& operand) {
+    return operand.lifetime == OperandLifeTime::CONSTANT_COPY ||
+           operand.lifetime == OperandLifeTime::CONSTANT_REFERENCE ||
+           operand.lifetime == OperandLifeTime::NO_VALUE;
+}
+
+bool hasKnownSize(const Operand& operand) {
+    if (operand.dimensions.size() == 0) return isScalar(operand.type);
+    for (auto dimension : operand.dimensions)
+        if (dimension == 0) return false;
+    return true;
+}
+
+uint64_t getElementCount(const hidl_vec<uint32_t>& dimensions) {
+    uint64_t count = 1;
+    for (auto dimension : dimensions) count *= dimension;
+    return count;
+}
+
+uint64_t getOperandBytes(const Operand& operand) {
+    return getElementCount(operand.dimensions) * sizeOfData(operand.type, {});
+}
+
+// Multiply-accumulates of the operations dominated by their weights, the larger of the output
+// and constant input elements for the others
+uint64_t estimateWork(const V1_3::Subgraph& subgraph, const Operation& operation) {
+    auto getDimensions = [&](size_t input) -> const hidl_vec<uint32_t>& {
+        return subgraph.operands[operation.inputs[input]].dimensions;
+    };
+    uint64_t outputElements = 0;
+    for (auto index : operation.outputs)
+        outputElements += getElementCount(subgraph.operands[index].dimensions);
+
+    switch (operation.type) {
+        case OperationType::CONV_2D:
+        case OperationType::GROUPED_CONV_2D: {
+            // Filter [depth_out, height, width, depth_in / groups]
+            const auto& filter = getDimensions(1);
+            if (filter.size() == 4) return outputElements * filter[1] * filter[2] * filter[3];
+            break;
+        }
+        case OperationType::DEPTHWISE_CONV_2D: {
+            // Filter [1, height, width, depth_out]
+            const auto& filter = getDimensions(1);
+            if (filter.size() == 4) return outputElements * filter[1] * filter[2];
+            break;
+        }
+        case OperationType::TRANSPOSE_CONV_2D: {
+            // Filter [depth_out, height, width, depth_in], spread from every input element
+            const auto& filter = getDimensions(1);
+            if (filter.size() == 4)
+                return getElementCount(getDimensions(0)) * filter[0] * filter[1] * filter[2];
+            break;
+        }
+        case OperationType::FULLY_CONNECTED: {
+            // Weights [num_units, input_size]
+            const auto& weights = getDimensions(1);
+            if (weights.size() == 2) return outputElements * weights[1];
+            break;
+        }
+        default:
+            break;
+    }
+
+    uint64_t constantElements = 0;
+    for (auto index : operation.inputs) {
+        const auto& operand = subgraph.operands[index];
+        if (isConstant(operand)) constantElements += getElementCount(operand.dimensions);
+    }
+    return std::max(outputElements, constantElements);
+}
+
+class UnionFind {
+public:
+    explicit UnionFind(size_t size) : mParents(size) {
+        std::iota(mParents.begin(), mParents.end(), 0);
+    }
+    uint32_t find(uint32_t i) {
+        while (mParents[i] != i) i = mParents[i] = mParents[mParents[i]];
+        return i;
+    }
+    void merge(uint32_t a, uint32_t b) { mParents[find(a)] = find(b); }
+
+private:
+    std::vector<uint32_t> mParents;
+};
+}  // namespace
+
+size_t withholdUnprofitableIslands(const Model& model, const IslandThresholds& thresholds,
+                                   std::vector<bool>& supported) {
+    const auto& subgraph = model.main;
+    const auto& operations = subgraph.operations;
+    std::vector<uint32_t> producers(subgraph.operands.size(), kNoProducer);
+    std::vector<std::vector<uint32_t>> consumers(subgraph.operands.size());
+    for (uint32_t i = 0; i < operations.size(); i++) {
+        for (auto index : operations[i].outputs) producers[index] = i;
+        for (auto index : operations[i].inputs) consumers[index].push_back(i);
+    }
+
+    UnionFind islandOf(operations.size());
+    for (uint32_t i = 0; i < operations.size(); i++) {
+        if (!supported[i]) continue;
+        for (auto index : operations[i].inputs) {
+            const uint32_t producer = producers[index];
+            if (producer != kNoProducer && supported[producer]) islandOf.merge(i, producer);
+        }
+    }
+    // Keyed by root, operations in index order
+    std::map<uint32_t, std::vector<uint32_t>> islands;
+    for (uint32_t i = 0; i < operations.size(); i++)
+        if (supported[i]) islands[islandOf.find(i)].push_back(i);
+
+    size_t withheld = 0;
+    for (const auto& island : islands) {
+        const uint32_t root = island.first;
+        const auto& members = island.second;
+        if (members.size() == operations.size()) continue;
+        auto inIsland = [&](uint32_t operation) {
+            return operation != kNoProducer && supported[operation] &&
+                   islandOf.find(operation) == root;
+        };
+
+        bool knownSizes = true;
+        uint64_t work = 0, boundaryBytes = 0;
+        std::set<uint32_t> boundary;
+        for (auto i : members) {
+            const auto& operation = operations[i];
+            work += estimateWork(subgraph, operation);
+            for (auto index : operation.inputs) {
+                const auto& operand = subgraph.operands[index];
+                if (isConstant(operand) || inIsland(producers[index])) continue;
+                if (boundary.insert(index).second) {
+                    knownSizes = knownSizes && hasKnownSize(operand);
+                    boundaryBytes += getOperandBytes(operand);
+                }
+            }
+            for (auto index : operation.outputs) {
+                const auto& operand = subgraph.operands[index];
+                knownSizes = knownSizes && hasKnownSize(operand);
+                bool crosses = operand.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT;
+                for (auto consumer : consumers[index]) crosses = crosses || !inIsland(consumer);
+                if (crosses && boundary.insert(index).second)
+                    boundaryBytes += getOperandBytes(operand);
+            }
+        }
+
+        const char* reason = nullptr;
+        if (members.size() < thresholds.minOperations)
+            reason = "too few operations";
+        else if (knownSizes && work < thresholds.minWorkPerByte * boundaryBytes)
+            reason = "boundary transfers dominate";
+        ALOGI("%s island of %zu operations from index %u (type %d): work %" PRIu64
+              ", boundary %" PRIu64 " bytes%s, %s",
+              __func__, members.size(), members.front(),
+              static_cast<int>(operations[members.front()].type), work, boundaryBytes,
+              knownSizes ? "" : " (unknown sizes)", reason ? reason : "kept");
+        if (reason == nullptr) continue;
+        for (auto i : members) supported[i] = false;
+        withheld += members.size();
+    }
+    return withheld;
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,36 @@
+#ifndef ANDROID_ML_NN_PARTITIONCOSTMODEL_H
+#define ANDROID_ML_NN_PARTITIONCOSTMODEL_H
+
+#include <vector>
+
+#include "Driver.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Islands are the connected groups of supported operations of the main subgraph. The runtime
+// runs each one as a partition of its own, paying a copy of every tensor crossing the island
+// boundary and a scheduling round trip, so an island only pays off when it carries enough work.
+struct IslandThresholds {
+    // Islands with fewer operations are withheld
+    size_t minOperations = 2;
+    // Islands doing fewer multiply-accumulates, or elements for the operations without weights,
+    // per byte crossing their boundary are withheld
+    double minWorkPerByte = 4;
+};
+
+// Clears the support of the islands that fail the thresholds and logs each decision. An island
+// covering every operation is always kept, its transfers happen wherever the model runs. Islands
+// touching tensors of unknown size are only checked against minOperations. Returns the number of
+// operations withheld.
+size_t withholdUnprofitableIslands(const Model& model, const IslandThresholds& thresholds,
+                                   std::vector<bool>& supported);
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_PARTITIONCOSTMODEL_H
@@ -0,0 +1,167 @@
+#include "RequestValidator.h"
+
+#include <log/log.h>
+#include <cinttypes>
+
+#include "ModelManager.h"
+
+#undef LOG_TAG
+#define LOG_TAG "RequestValidator"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+using OperandDescriptor = RequestValidator::OperandDescriptor;
+
+bool isTensor(OperandType type) {
+    switch (type) {
+        case OperandType::FLOAT32:
+        case OperandType::INT32:
+        case OperandType::UINT32:
+        case OperandType::BOOL:
+        case OperandType::FLOAT16:
+            return false;
+        default:
+            return true;
+    }
+}
+
+// The memory types the runtime accepts for request pools
+bool validatePool(const hidl_memory& pool) {
+    const auto& name = pool.name();
+    if (name != "ashmem" && name != "mmap_fd" && name != "hardware_buffer_blob" &&
+        name != "hardware_buffer") {
+        ALOGE("Unsupported memory type %s", name.c_str());
+        return false;
+    }
+    if (pool.handle() == nullptr) {
+        ALOGE("Memory pool of type %s has no handle", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+// The driver does not allocate buffers, so a token never refers to one of its buffers
+bool validatePool(const V1_3::Request::MemoryPool& pool) {
+    if (pool.getDiscriminator() != V1_3::Request::MemoryPool::hidl_discriminator::hidlMemory) {
+        ALOGE("Driver managed buffers are not supported");
+        return false;
+    }
+    return validatePool(pool.hidlMemory());
+}
+
+uint64_t getPoolSize(const hidl_memory& pool) { return pool.size(); }
+
+uint64_t getPoolSize(const V1_3::Request::MemoryPool& pool) { return pool.hidlMemory().size(); }
+
+bool validateDimensions(const V1_0::RequestArgument& argument, const OperandDescriptor& operand,
+                        bool allowUnspecified, const char* type, size_t index) {
+    const auto& dimensions = operand.dimensions;
+    if (argument.dimensions.size() == 0) {
+        if (allowUnspecified) return true;
+        if (isTensor(operand.type) && dimensions.empty()) {
+            ALOGE("%s %zu has unknown rank", type, index);
+            return false;
+        }
+        for (auto dimension : dimensions) {
+            if (dimension == 0) {
+                ALOGE("%s %zu has unspecified dimensions", type, index);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (!dimensions.empty() && argument.dimensions.size() != dimensions.size()) {
+        ALOGE("%s %zu has rank %zu, the model operand rank %zu", type, index,
+              argument.dimensions.size(), dimensions.size());
+        return false;
+    }
+    for (size_t i = 0; i < argument.dimensions.size(); i++) {
+        const uint32_t dimension = argument.dimensions[i];
+        if (!dimensions.empty() && dimensions[i] != 0 && dimensions[i] != dimension) {
+            ALOGE("%s %zu dimension %zu is %u, the model operand has %u", type, index, i,
+                  dimension, dimensions[i]);
+            return false;
+        }
+        if (dimension == 0 && !allowUnspecified) {
+            ALOGE("%s %zu dimension %zu is unspecified", type, index, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T_Pool>
+bool validateArguments(const hidl_vec<V1_0::RequestArgument>& arguments,
+                       const std::vector<OperandDescriptor>& operands,
+                       const hidl_vec<T_Pool>& pools, bool allowUnspecified, const char* type) {
+    if (arguments.size() != operands.size()) {
+        ALOGE("Request has %zu %ss, the model %zu", arguments.size(), type, operands.size());
+        return false;
+    }
+    for (size_t i = 0; i < arguments.size(); i++) {
+        const auto& argument = arguments[i];
+        const auto& location = argument.location;
+        if (argument.hasNoValue) {
+            if (location.poolIndex != 0 || location.offset != 0 || location.length != 0 ||
+                argument.dimensions.size() != 0) {
+                ALOGE("%s %zu has no value but a location or dimensions", type, i);
+                return false;
+            }
+            continue;
+        }
+        if (location.poolIndex >= pools.size()) {
+            ALOGE("%s %zu uses pool %u of %zu", type, i, location.poolIndex, pools.size());
+            return false;
+        }
+        const uint64_t end = static_cast<uint64_t>(location.offset) + location.length;
+        if (end > getPoolSize(pools[location.poolIndex])) {
+            ALOGE("%s %zu ends at %" PRIu64 ", past pool %u", type, i, end, location.poolIndex);
+            return false;
+        }
+        if (!validateDimensions(argument, operands[i], allowUnspecified, type, i)) return false;
+    }
+    return true;
+}
+
+template <typename T_Request>
+bool checkRequest(const T_Request& request, const std::vector<OperandDescriptor>& inputs,
+                  const std::vector<OperandDescriptor>& outputs, bool allowUnspecifiedOutput) {
+    for (const auto& pool : request.pools) {
+        if (!validatePool(pool)) return false;
+    }
+    return validateArguments(request.inputs, inputs, request.pools, false, "input") &&
+           validateArguments(request.outputs, outputs, request.pools, allowUnspecifiedOutput,
+                             "output");
+}
+}  // namespace
+
+RequestValidator::RequestValidator(NnapiModelInfo& modelInfo) {
+    auto getDescriptor = [&modelInfo](uint32_t operandIndex) {
+        const auto dimensions = modelInfo.getOperandDimensions(operandIndex);
+        return OperandDescriptor{modelInfo.getOperandType(operandIndex), dimensions.toVector()};
+    };
+    const auto& inputIndexes = modelInfo.getModelInputIndexes();
+    mInputs.reserve(inputIndexes.size());
+    for (auto index : inputIndexes) mInputs.push_back(getDescriptor(index));
+    mOutputs.reserve(modelInfo.getModelOutputsSize());
+    for (size_t i = 0; i < modelInfo.getModelOutputsSize(); i++)
+        mOutputs.push_back(getDescriptor(modelInfo.getModelOutputIndex(i)));
+}
+
+bool RequestValidator::validate(const Request& request, bool allowUnspecifiedOutput) const {
+    return checkRequest(request, mInputs, mOutputs, allowUnspecifiedOutput);
+}
+
+bool RequestValidator::validate(const V1_3::Request& request, bool allowUnspecifiedOutput) const {
+    return checkRequest(request, mInputs, mOutputs, allowUnspecifiedOutput);
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
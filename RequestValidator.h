@@ -0,0 +1,42 @@
+#ifndef ANDROID_ML_NN_REQUESTVALIDATOR_H
+#define ANDROID_ML_NN_REQUESTVALIDATOR_H
+
+#include <android/hardware/neuralnetworks/1.3/types.h>
+#include <vector>
+
+#include "Driver.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+class NnapiModelInfo;
+
+// Checks execution requests against the model input and output operands captured when the model
+// is prepared. Applies the argument and pool rules of the runtime's validateRequest, in time
+// proportional to the request rather than to the model.
+class RequestValidator {
+public:
+    RequestValidator() = default;
+    explicit RequestValidator(NnapiModelInfo& modelInfo);
+
+    bool validate(const Request& request, bool allowUnspecifiedOutput = true) const;
+    bool validate(const V1_3::Request& request, bool allowUnspecifiedOutput = true) const;
+
+    struct OperandDescriptor {
+        OperandType type;
+        std::vector<uint32_t> dimensions;
+    };
+
+private:
+    std::vector<OperandDescriptor> mInputs;
+    std::vector<OperandDescriptor> mOutputs;
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_REQUESTVALIDATOR_H
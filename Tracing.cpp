@@ -0,0 +1,155 @@
+#include "Tracing.h"
+
+#include <log/log.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+#if __ANDROID__
+#define ATRACE_TAG ATRACE_TAG_NNAPI
+#include <cutils/trace.h>
+#endif
+
+#undef LOG_TAG
+#define LOG_TAG "Tracing"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+// Model id of the innermost event of the thread that has one
+thread_local uint64_t tCurrentModelId = 0;
+
+#if !__ANDROID__
+// Events are formatted as they complete and written in batches of this size
+constexpr size_t kFlushBytes = 64 * 1024;
+
+std::atomic<bool> sEnabled{false};
+std::mutex sMutex;
+FILE* sFile = nullptr;
+std::string sBuffer;
+
+int64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint32_t getThreadId() {
+    thread_local uint32_t threadId = static_cast<uint32_t>(syscall(SYS_gettid));
+    return threadId;
+}
+
+// Called with sMutex held
+void writeBuffer() {
+    if (sFile == nullptr || sBuffer.empty()) return;
+    fwrite(sBuffer.data(), 1, sBuffer.size(), sFile);
+    fflush(sFile);
+    sBuffer.clear();
+}
+#endif
+}  // namespace
+
+#if __ANDROID__
+bool isTracingEnabled() { return ATRACE_ENABLED(); }
+
+void startTracing(const std::string& path) {
+    if (!path.empty()) ALOGI("%s trace_file is ignored, events go to atrace", __func__);
+}
+
+void flushTracing() {}
+#else
+bool isTracingEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+void startTracing(const std::string& path) {
+    if (path.empty()) return;
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (sFile != nullptr) return;
+    sFile = fopen(path.c_str(), "w");
+    if (sFile == nullptr) {
+        ALOGE("%s failed to open %s", __func__, path.c_str());
+        return;
+    }
+    // The JSON array format tolerates the missing closing bracket of a trace cut short
+    fputs("[\n", sFile);
+    std::atexit(flushTracing);
+    sEnabled.store(true, std::memory_order_relaxed);
+    ALOGI("%s writing trace events to %s", __func__, path.c_str());
+}
+
+void flushTracing() {
+    std::lock_guard<std::mutex> lock(sMutex);
+    writeBuffer();
+}
+#endif
+
+TraceEvent::TraceEvent(const char* name, uint64_t modelId, int64_t index)
+    : mName(name), mActive(isTracingEnabled()), mModelId(modelId), mIndex(index) {
+    if (!mActive) return;
+    mEnclosingModelId = tCurrentModelId;
+    if (mModelId != 0)
+        tCurrentModelId = mModelId;
+    else
+        mModelId = mEnclosingModelId;
+#if __ANDROID__
+    if (mModelId == 0 && mIndex < 0) {
+        atrace_begin(ATRACE_TAG, mName);
+        return;
+    }
+    char label[128];
+    if (mIndex < 0)
+        snprintf(label, sizeof(label), "%s model=%" PRIu64, mName, mModelId);
+    else
+        snprintf(label, sizeof(label), "%s model=%" PRIu64 " index=%" PRId64, mName, mModelId,
+                 mIndex);
+    atrace_begin(ATRACE_TAG, label);
+#else
+    mStartUs = nowUs();
+#endif
+}
+
+void TraceEvent::setModelId(uint64_t modelId) {
+    if (!mActive) return;
+    mModelId = modelId;
+    tCurrentModelId = modelId;
+}
+
+TraceEvent::~TraceEvent() { end(); }
+
+void TraceEvent::end() {
+    if (!mActive) return;
+    mActive = false;
+    tCurrentModelId = mEnclosingModelId;
+#if __ANDROID__
+    atrace_end(ATRACE_TAG);
+#else
+    const int64_t durationUs = nowUs() - mStartUs;
+    char event[256];
+    int length = snprintf(event, sizeof(event),
+                          "{\"name\":\"%s\",\"cat\":\"nnhal\",\"ph\":\"X\",\"ts\":%" PRId64
+                          ",\"dur\":%" PRId64 ",\"pid\":%d,\"tid\":%u,\"args\":{\"model\":%" PRIu64,
+                          mName, mStartUs, durationUs, static_cast<int>(getpid()), getThreadId(),
+                          mModelId);
+    if (length < 0 || static_cast<size_t>(length) >= sizeof(event)) return;
+    if (mIndex >= 0)
+        length += snprintf(event + length, sizeof(event) - length, ",\"index\":%" PRId64, mIndex);
+    if (static_cast<size_t>(length) >= sizeof(event)) return;
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    sBuffer.append(event, length);
+    sBuffer.append("}},\n");
+    if (sBuffer.size() >= kFlushBytes) writeBuffer();
+#endif
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,54 @@
+#ifndef ANDROID_ML_NN_TRACING_H
+#define ANDROID_ML_NN_TRACING_H
+
+#include <cstdint>
+#include <string>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Scoped trace events around model preparation and execution. Android builds forward them to
+// atrace under the nnapi category, so that they show up next to the runtime and binder activity
+// in systrace and Perfetto captures. Host builds write them as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev) to the trace_file of the driver config.
+
+// A single relaxed load, events cost nothing more while tracing is off
+bool isTracingEnabled();
+
+// Host builds only: starts appending the events to path, an empty path keeps tracing off. The
+// events are flushed when the buffer fills up, by flushTracing() and at exit.
+void startTracing(const std::string& path);
+void flushTracing();
+
+// Records the time from its construction to its destruction on the calling thread. Events without
+// a model id take the one of the enclosing event on the same thread. index is an optional
+// operation, input or output index, -1 when not relevant.
+class TraceEvent {
+public:
+    explicit TraceEvent(const char* name, uint64_t modelId = 0, int64_t index = -1);
+    ~TraceEvent();
+    TraceEvent(const TraceEvent&) = delete;
+    TraceEvent& operator=(const TraceEvent&) = delete;
+
+    // For events started before the model id is known. atrace only gets the ids known at start.
+    void setModelId(uint64_t modelId);
+    // Ends the event before the end of its scope, for stages that do not have a block of their own
+    void end();
+
+private:
+    const char* mName;
+    bool mActive;
+    uint64_t mModelId;
+    uint64_t mEnclosingModelId = 0;
+    int64_t mIndex;
+    int64_t mStartUs = 0;
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_TRACING_H
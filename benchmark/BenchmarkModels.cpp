@@ -0,0 +1,376 @@
+#include "BenchmarkModels.h"
+
+#include <cstring>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+namespace {
+// NNAPI fused activation and padding codes
+constexpr int32_t kActivationNone = 0;
+constexpr int32_t kActivationRelu = 1;
+constexpr int32_t kActivationRelu6 = 3;
+constexpr int32_t kActivationTanh = 4;
+constexpr int32_t kPaddingSame = 1;
+
+// xorshift, so that every run benchmarks the same values
+uint32_t nextRandom() {
+    static uint32_t state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+size_t getElementSize(OperandType type) {
+    switch (type) {
+        case OperandType::TENSOR_QUANT8_ASYMM:
+        case OperandType::TENSOR_QUANT8_ASYMM_SIGNED:
+        case OperandType::TENSOR_QUANT8_SYMM:
+        case OperandType::TENSOR_BOOL8:
+        case OperandType::BOOL:
+            return 1;
+        case OperandType::TENSOR_FLOAT16:
+        case OperandType::FLOAT16:
+        case OperandType::TENSOR_QUANT16_SYMM:
+        case OperandType::TENSOR_QUANT16_ASYMM:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+size_t getElementCount(const std::vector<uint32_t>& dims) {
+    size_t count = 1;
+    for (auto dim : dims) count *= dim;
+    return count;
+}
+
+struct QuantParams {
+    float scale;
+    int32_t zeroPoint;
+};
+
+// Adds a CONV_2D with SAME padding, the weights and bias being random constants. quant is only
+// used for TENSOR_QUANT8_ASYMM inputs and holds the scale of the output. Operand references are
+// invalidated by adding operands, so the input attributes are copied first.
+uint32_t addConv2d(ModelBuilder& builder, uint32_t input, uint32_t outChannels, uint32_t kernel,
+                   uint32_t stride, int32_t activation, QuantParams quant = {0.f, 0}) {
+    const auto& in = builder.getOperand(input);
+    const auto type = in.type;
+    const uint32_t batch = in.dimensions[0], height = in.dimensions[1], width = in.dimensions[2],
+                   inChannels = in.dimensions[3];
+    const bool quantized = type == OperandType::TENSOR_QUANT8_ASYMM;
+    const float inScale = in.scale;
+
+    uint32_t filter, bias, output;
+    const std::vector<uint32_t> outDims = {batch, (height + stride - 1) / stride,
+                                           (width + stride - 1) / stride, outChannels};
+    if (quantized) {
+        const float filterScale = 0.01f;
+        filter = builder.addRandomConstant(type, {outChannels, kernel, kernel, inChannels}, 0.f,
+                                           filterScale, 128);
+        bias = builder.addRandomConstant(OperandType::TENSOR_INT32, {outChannels}, 0.f,
+                                         inScale * filterScale, 0);
+        output = builder.addOperand(type, outDims, quant.scale, quant.zeroPoint);
+    } else {
+        filter = builder.addRandomConstant(type, {outChannels, kernel, kernel, inChannels});
+        bias = builder.addRandomConstant(type, {outChannels});
+        output = builder.addOperand(type, outDims);
+    }
+    builder.addOperation(OperationType::CONV_2D,
+                         {input, filter, bias, builder.addInt32(kPaddingSame),
+                          builder.addInt32(stride), builder.addInt32(stride),
+                          builder.addInt32(activation)},
+                         {output});
+    return output;
+}
+
+uint32_t addDepthwiseConv2d(ModelBuilder& builder, uint32_t input, uint32_t stride,
+                            int32_t activation) {
+    const auto& in = builder.getOperand(input);
+    const auto type = in.type;
+    const uint32_t batch = in.dimensions[0], height = in.dimensions[1], width = in.dimensions[2],
+                   channels = in.dimensions[3];
+
+    auto filter = builder.addRandomConstant(type, {1, 3, 3, channels});
+    auto bias = builder.addRandomConstant(type, {channels});
+    auto output = builder.addOperand(
+        type, {batch, (height + stride - 1) / stride, (width + stride - 1) / stride, channels});
+    builder.addOperation(OperationType::DEPTHWISE_CONV_2D,
+                         {input, filter, bias, builder.addInt32(kPaddingSame),
+                          builder.addInt32(stride), builder.addInt32(stride), builder.addInt32(1),
+                          builder.addInt32(activation)},
+                         {output});
+    return output;
+}
+
+uint32_t addFullyConnected(ModelBuilder& builder, uint32_t input, uint32_t units,
+                           int32_t activation, QuantParams quant = {0.f, 0}) {
+    const auto& in = builder.getOperand(input);
+    const auto type = in.type;
+    const uint32_t batch = in.dimensions[0], inputSize = in.dimensions[1];
+    const float inScale = in.scale;
+
+    uint32_t weights, bias, output;
+    if (type == OperandType::TENSOR_QUANT8_ASYMM) {
+        const float weightsScale = 0.01f;
+        weights = builder.addRandomConstant(type, {units, inputSize}, 0.f, weightsScale, 128);
+        bias = builder.addRandomConstant(OperandType::TENSOR_INT32, {units}, 0.f,
+                                         inScale * weightsScale, 0);
+        output = builder.addOperand(type, {batch, units}, quant.scale, quant.zeroPoint);
+    } else {
+        weights = builder.addRandomConstant(type, {units, inputSize});
+        bias = builder.addRandomConstant(type, {units});
+        output = builder.addOperand(type, {batch, units});
+    }
+    builder.addOperation(OperationType::FULLY_CONNECTED,
+                         {input, weights, bias, builder.addInt32(activation)}, {output});
+    return output;
+}
+
+// 224x224 input, a strided 3x3 convolution followed by four 3x3 convolutions at 112x112
+Model createConvStack(bool quantized) {
+    ModelBuilder builder;
+    const auto type = quantized ? OperandType::TENSOR_QUANT8_ASYMM : OperandType::TENSOR_FLOAT32;
+    const QuantParams activations = {0.05f, 0};
+    auto output = builder.addInput(type, {1, 224, 224, 3}, quantized ? 0.0078125f : 0.f,
+                                   quantized ? 128 : 0);
+    output = addConv2d(builder, output, 32, 3, 2, kActivationRelu, activations);
+    for (int i = 0; i < 4; i++)
+        output = addConv2d(builder, output, 32, 3, 1, kActivationRelu, activations);
+
+    // The model output is produced by a final 1x1 convolution so that it is not a temporary
+    const std::vector<uint32_t> dims = builder.getOperand(output).dimensions;
+    auto result = builder.addOutput(type, dims, activations.scale, activations.zeroPoint);
+    uint32_t filter, bias;
+    if (quantized) {
+        filter = builder.addRandomConstant(type, {32, 1, 1, 32}, 0.f, 0.01f, 128);
+        bias = builder.addRandomConstant(OperandType::TENSOR_INT32, {32}, 0.f,
+                                         activations.scale * 0.01f, 0);
+    } else {
+        filter = builder.addRandomConstant(type, {32, 1, 1, 32});
+        bias = builder.addRandomConstant(type, {32});
+    }
+    builder.addOperation(OperationType::CONV_2D,
+                         {output, filter, bias, builder.addInt32(kPaddingSame), builder.addInt32(1),
+                          builder.addInt32(1), builder.addInt32(kActivationNone)},
+                         {result});
+    return builder.build();
+}
+
+// Two MobileNet v1 depthwise separable blocks at 112x112, the second one strided
+Model createMobileNetBlock() {
+    ModelBuilder builder;
+    const auto type = OperandType::TENSOR_FLOAT32;
+    auto output = builder.addInput(type, {1, 112, 112, 32});
+    output = addDepthwiseConv2d(builder, output, 1, kActivationRelu6);
+    output = addConv2d(builder, output, 64, 1, 1, kActivationRelu6);
+    output = addDepthwiseConv2d(builder, output, 2, kActivationRelu6);
+
+    auto filter = builder.addRandomConstant(type, {128, 1, 1, 64});
+    auto bias = builder.addRandomConstant(type, {128});
+    auto result = builder.addOutput(type, {1, 56, 56, 128});
+    builder.addOperation(OperationType::CONV_2D,
+                         {output, filter, bias, builder.addInt32(kPaddingSame), builder.addInt32(1),
+                          builder.addInt32(1), builder.addInt32(kActivationRelu6)},
+                         {result});
+    return builder.build();
+}
+
+// 1024 -> 2048 -> 2048 -> 1000 fully connected layers, dominated by weight bandwidth
+Model createFcHeavy(bool quantized) {
+    ModelBuilder builder;
+    const auto type = quantized ? OperandType::TENSOR_QUANT8_ASYMM : OperandType::TENSOR_FLOAT32;
+    const QuantParams activations = {0.05f, 0};
+    auto output = builder.addInput(type, {1, 1024}, quantized ? 0.0078125f : 0.f,
+                                   quantized ? 128 : 0);
+    output = addFullyConnected(builder, output, 2048, kActivationRelu, activations);
+    output = addFullyConnected(builder, output, 2048, kActivationRelu, activations);
+
+    uint32_t weights, bias;
+    if (quantized) {
+        weights = builder.addRandomConstant(type, {1000, 2048}, 0.f, 0.01f, 128);
+        bias = builder.addRandomConstant(OperandType::TENSOR_INT32, {1000}, 0.f,
+                                         activations.scale * 0.01f, 0);
+    } else {
+        weights = builder.addRandomConstant(type, {1000, 2048});
+        bias = builder.addRandomConstant(type, {1000});
+    }
+    auto result = builder.addOutput(type, {1, 1000}, 0.1f, 128);
+    builder.addOperation(OperationType::FULLY_CONNECTED,
+                         {output, weights, bias, builder.addInt32(kActivationNone)}, {result});
+    return builder.build();
+}
+
+// One step of a speech recognition sized LSTM: 80 features, 512 units, no peephole or
+// projection, the states being model inputs and outputs
+Model createLstm() {
+    ModelBuilder builder;
+    const auto type = OperandType::TENSOR_FLOAT32;
+    const uint32_t batch = 1, inputSize = 80, numUnits = 512;
+
+    std::vector<uint32_t> inputs;
+    inputs.push_back(builder.addInput(type, {batch, inputSize}));
+    // input to input/forget/cell/output weights
+    for (int i = 0; i < 4; i++)
+        inputs.push_back(builder.addRandomConstant(type, {numUnits, inputSize}));
+    // recurrent to input/forget/cell/output weights
+    for (int i = 0; i < 4; i++)
+        inputs.push_back(builder.addRandomConstant(type, {numUnits, numUnits}));
+    // no peephole
+    for (int i = 0; i < 3; i++) inputs.push_back(builder.addNoValue(type));
+    // input/forget/cell/output gate bias
+    for (int i = 0; i < 4; i++) inputs.push_back(builder.addRandomConstant(type, {numUnits}));
+    // no projection
+    inputs.push_back(builder.addNoValue(type));
+    inputs.push_back(builder.addNoValue(type));
+    // output and cell state in
+    inputs.push_back(builder.addInput(type, {batch, numUnits}));
+    inputs.push_back(builder.addInput(type, {batch, numUnits}));
+    inputs.push_back(builder.addInt32(kActivationTanh));
+    inputs.push_back(builder.addFloat32(0.f));
+    inputs.push_back(builder.addFloat32(0.f));
+
+    auto scratchBuffer = builder.addOutput(type, {batch, numUnits * 4});
+    auto outputState = builder.addOutput(type, {batch, numUnits});
+    auto cellState = builder.addOutput(type, {batch, numUnits});
+    auto output = builder.addOutput(type, {batch, numUnits});
+    builder.addOperation(OperationType::LSTM, inputs,
+                         {scratchBuffer, outputState, cellState, output});
+    return builder.build();
+}
+}  // namespace
+
+uint32_t ModelBuilder::addOperand(OperandType type, const std::vector<uint32_t>& dims, float scale,
+                                  int32_t zeroPoint) {
+    Operand operand = {};
+    operand.type = type;
+    operand.dimensions = dims;
+    operand.scale = scale;
+    operand.zeroPoint = zeroPoint;
+    operand.lifetime = OperandLifeTime::TEMPORARY_VARIABLE;
+    mOperands.push_back(operand);
+    return mOperands.size() - 1;
+}
+
+uint32_t ModelBuilder::addInput(OperandType type, const std::vector<uint32_t>& dims, float scale,
+                                int32_t zeroPoint) {
+    auto index = addOperand(type, dims, scale, zeroPoint);
+    mOperands[index].lifetime = OperandLifeTime::SUBGRAPH_INPUT;
+    mInputs.push_back(index);
+    return index;
+}
+
+uint32_t ModelBuilder::addOutput(OperandType type, const std::vector<uint32_t>& dims, float scale,
+                                 int32_t zeroPoint) {
+    auto index = addOperand(type, dims, scale, zeroPoint);
+    mOperands[index].lifetime = OperandLifeTime::SUBGRAPH_OUTPUT;
+    mOutputs.push_back(index);
+    return index;
+}
+
+uint32_t ModelBuilder::addNoValue(OperandType type) {
+    auto index = addOperand(type, {});
+    mOperands[index].lifetime = OperandLifeTime::NO_VALUE;
+    return index;
+}
+
+uint32_t ModelBuilder::addConstant(OperandType type, const std::vector<uint32_t>& dims,
+                                   const void* data, size_t length, float scale,
+                                   int32_t zeroPoint) {
+    auto index = addOperand(type, dims, scale, zeroPoint);
+    auto& operand = mOperands[index];
+    // Keep every value 4 byte aligned, as the runtime does
+    const size_t offset = (mValues.size() + 3) & ~size_t(3);
+    mValues.resize(offset + length);
+    std::memcpy(mValues.data() + offset, data, length);
+    operand.lifetime = OperandLifeTime::CONSTANT_COPY;
+    operand.location = {.poolIndex = 0, .offset = uint32_t(offset), .length = uint32_t(length)};
+    return index;
+}
+
+uint32_t ModelBuilder::addInt32(int32_t value) {
+    return addConstant(OperandType::INT32, {}, &value, sizeof(value));
+}
+
+uint32_t ModelBuilder::addFloat32(float value) {
+    return addConstant(OperandType::FLOAT32, {}, &value, sizeof(value));
+}
+
+uint32_t ModelBuilder::addRandomConstant(OperandType type, const std::vector<uint32_t>& dims,
+                                         float range, float scale, int32_t zeroPoint) {
+    const size_t count = getElementCount(dims);
+    switch (type) {
+        case OperandType::TENSOR_QUANT8_ASYMM: {
+            std::vector<uint8_t> values(count);
+            for (auto& value : values) value = nextRandom() & 0xff;
+            return addConstant(type, dims, values.data(), values.size(), scale, zeroPoint);
+        }
+        case OperandType::TENSOR_INT32: {
+            std::vector<int32_t> values(count);
+            for (auto& value : values) value = int32_t(nextRandom() % 2048) - 1024;
+            return addConstant(type, dims, values.data(), values.size() * sizeof(int32_t), scale,
+                               zeroPoint);
+        }
+        default: {
+            std::vector<float> values(count);
+            for (auto& value : values) value = range * (float(nextRandom() % 20001) / 10000 - 1);
+            return addConstant(type, dims, values.data(), values.size() * sizeof(float), scale,
+                               zeroPoint);
+        }
+    }
+}
+
+void ModelBuilder::addOperation(OperationType type, const std::vector<uint32_t>& inputs,
+                                const std::vector<uint32_t>& outputs) {
+    Operation operation = {};
+    operation.type = type;
+    operation.inputs = inputs;
+    operation.outputs = outputs;
+    mOperations.push_back(operation);
+}
+
+Model ModelBuilder::build() {
+    for (auto& operand : mOperands) operand.numberOfConsumers = 0;
+    for (const auto& operation : mOperations) {
+        for (auto input : operation.inputs) mOperands[input].numberOfConsumers++;
+    }
+
+    Model model = {};
+    model.main.operands = mOperands;
+    model.main.operations = mOperations;
+    model.main.inputIndexes = mInputs;
+    model.main.outputIndexes = mOutputs;
+    model.operandValues = mValues;
+    model.relaxComputationFloat32toFloat16 = false;
+    return model;
+}
+
+size_t getOperandByteSize(const Operand& operand) {
+    return getElementCount(operand.dimensions) * getElementSize(operand.type);
+}
+
+std::vector<Workload> getWorkloads() {
+    return {
+        {"conv_stack", "5x CONV_2D 3x3 + CONV_2D 1x1, 224x224x3 input, float32",
+         createConvStack(false)},
+        {"conv_stack_quant", "5x CONV_2D 3x3 + CONV_2D 1x1, 224x224x3 input, quant8 asymm",
+         createConvStack(true)},
+        {"mobilenet_block", "2x DEPTHWISE_CONV_2D + CONV_2D 1x1, 112x112x32 input, float32",
+         createMobileNetBlock()},
+        {"fc_heavy", "3x FULLY_CONNECTED 1024-2048-2048-1000, float32", createFcHeavy(false)},
+        {"fc_heavy_quant", "3x FULLY_CONNECTED 1024-2048-2048-1000, quant8 asymm",
+         createFcHeavy(true)},
+        {"lstm", "LSTM step, 80 inputs, 512 units, float32", createLstm()},
+    };
+}
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,68 @@
+#ifndef ANDROID_ML_NN_BENCHMARKMODELS_H
+#define ANDROID_ML_NN_BENCHMARKMODELS_H
+
+#include <string>
+#include <vector>
+
+#include "Driver.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+// Builds a V1_3 Model the way the NNAPI runtime hands it to the driver: constants are stored as
+// CONSTANT_COPY in operandValues and numberOfConsumers is computed when the model is built.
+class ModelBuilder {
+public:
+    uint32_t addOperand(OperandType type, const std::vector<uint32_t>& dims, float scale = 0.f,
+                        int32_t zeroPoint = 0);
+    uint32_t addInput(OperandType type, const std::vector<uint32_t>& dims, float scale = 0.f,
+                      int32_t zeroPoint = 0);
+    uint32_t addOutput(OperandType type, const std::vector<uint32_t>& dims, float scale = 0.f,
+                       int32_t zeroPoint = 0);
+    // An omitted optional operand
+    uint32_t addNoValue(OperandType type);
+    uint32_t addConstant(OperandType type, const std::vector<uint32_t>& dims, const void* data,
+                         size_t length, float scale = 0.f, int32_t zeroPoint = 0);
+    uint32_t addInt32(int32_t value);
+    uint32_t addFloat32(float value);
+    // Filled with deterministic pseudo random values in [-range, range], or over the whole
+    // quantized range for 8 bit types
+    uint32_t addRandomConstant(OperandType type, const std::vector<uint32_t>& dims,
+                               float range = 0.1f, float scale = 0.f, int32_t zeroPoint = 0);
+
+    void addOperation(OperationType type, const std::vector<uint32_t>& inputs,
+                      const std::vector<uint32_t>& outputs);
+
+    const Operand& getOperand(uint32_t index) const { return mOperands[index]; }
+    Model build();
+
+private:
+    std::vector<Operand> mOperands;
+    std::vector<Operation> mOperations;
+    std::vector<uint32_t> mInputs, mOutputs;
+    std::vector<uint8_t> mValues;
+};
+
+struct Workload {
+    std::string name;
+    std::string description;
+    Model model;
+};
+
+// Representative workloads: a conv stack, a MobileNet depthwise block, an FC heavy network and
+// an LSTM step, plus 8 bit quantized variants of the conv stack and the FC network.
+std::vector<Workload> getWorkloads();
+
+// The size in bytes of a model input or output operand
+size_t getOperandByteSize(const Operand& operand);
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_BENCHMARKMODELS_H
@@ -0,0 +1,211 @@
+#include "BenchmarkRunner.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+#include "BenchmarkModels.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+namespace {
+const V1_2::Timing kNoTiming = {.timeOnDevice = UINT64_MAX, .timeInDriver = UINT64_MAX};
+
+class PreparedModelCallback : public V1_3::IPreparedModelCallback {
+public:
+    Return<void> notify(V1_0::ErrorStatus status,
+                        const sp<V1_0::IPreparedModel>& preparedModel) override {
+        mResult.set_value(
+            {nn::convertToV1_3(status), V1_3::IPreparedModel::castFrom(preparedModel)});
+        return Void();
+    }
+    Return<void> notify_1_2(V1_0::ErrorStatus status,
+                            const sp<V1_2::IPreparedModel>& preparedModel) override {
+        mResult.set_value(
+            {nn::convertToV1_3(status), V1_3::IPreparedModel::castFrom(preparedModel)});
+        return Void();
+    }
+    Return<void> notify_1_3(V1_3::ErrorStatus status,
+                            const sp<V1_3::IPreparedModel>& preparedModel) override {
+        mResult.set_value({status, preparedModel});
+        return Void();
+    }
+    std::pair<V1_3::ErrorStatus, sp<V1_3::IPreparedModel>> get() {
+        return mResult.get_future().get();
+    }
+
+private:
+    std::promise<std::pair<V1_3::ErrorStatus, sp<V1_3::IPreparedModel>>> mResult;
+};
+
+class ExecutionCallback : public V1_3::IExecutionCallback {
+public:
+    Return<void> notify(V1_0::ErrorStatus status) override {
+        mResult.set_value({nn::convertToV1_3(status), kNoTiming});
+        return Void();
+    }
+    Return<void> notify_1_2(V1_0::ErrorStatus status, const hidl_vec<V1_2::OutputShape>&,
+                            const V1_2::Timing& timing) override {
+        mResult.set_value({nn::convertToV1_3(status), timing});
+        return Void();
+    }
+    Return<void> notify_1_3(V1_3::ErrorStatus status, const hidl_vec<V1_2::OutputShape>&,
+                            const V1_2::Timing& timing) override {
+        mResult.set_value({status, timing});
+        return Void();
+    }
+    std::pair<V1_3::ErrorStatus, V1_2::Timing> get() { return mResult.get_future().get(); }
+
+private:
+    std::promise<std::pair<V1_3::ErrorStatus, V1_2::Timing>> mResult;
+};
+
+void addTimeOnDevice(const V1_2::Timing& timing, double& deviceMs) {
+    if (timing.timeOnDevice != UINT64_MAX) deviceMs += timing.timeOnDevice / 1000.0;
+}
+
+// Lays the model inputs or outputs out back to back in one pool
+hidl_vec<V1_0::RequestArgument> createArguments(const Model& model,
+                                                const hidl_vec<uint32_t>& indexes,
+                                                uint32_t poolIndex, size_t& poolSize) {
+    hidl_vec<V1_0::RequestArgument> arguments(indexes.size());
+    poolSize = 0;
+    for (size_t i = 0; i < indexes.size(); i++) {
+        const size_t length = getOperandByteSize(model.main.operands[indexes[i]]);
+        arguments[i] = {.hasNoValue = false,
+                        .location = {.poolIndex = poolIndex,
+                                     .offset = uint32_t(poolSize),
+                                     .length = uint32_t(length)},
+                        .dimensions = {}};
+        poolSize += (length + 63) & ~size_t(63);
+    }
+    return arguments;
+}
+}  // namespace
+
+const char* getExecutionModeName(ExecutionMode mode) {
+    switch (mode) {
+        case ExecutionMode::SYNC:
+            return "sync";
+        case ExecutionMode::ASYNC:
+            return "async";
+        case ExecutionMode::BURST:
+            return "burst";
+    }
+    return "";
+}
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    size_t index = std::ceil(p * values.size());
+    return values[std::min(values.size(), std::max<size_t>(index, 1)) - 1];
+}
+
+SharedMemory::SharedMemory(size_t size) : mSize(std::max<size_t>(size, 1)) {
+    mFd = memfd_create("nnhal_benchmark", 0);
+    if (mFd < 0 || ftruncate(mFd, mSize) != 0) return;
+    void* buffer = mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+    if (buffer == MAP_FAILED) return;
+    mBuffer = static_cast<uint8_t*>(buffer);
+    // fd, then the protection and the 64 bit offset as ints
+    mHandle = native_handle_create(1, 3);
+    mHandle->data[0] = mFd;
+    mHandle->data[1] = PROT_READ | PROT_WRITE;
+    mHandle->data[2] = 0;
+    mHandle->data[3] = 0;
+}
+
+SharedMemory::~SharedMemory() {
+    if (mBuffer) munmap(mBuffer, mSize);
+    if (mHandle) native_handle_delete(mHandle);
+    if (mFd >= 0) close(mFd);
+}
+
+hidl_memory SharedMemory::getHidlMemory() const { return hidl_memory("mmap_fd", mHandle, mSize); }
+
+std::string ModelRunner::prepare(const sp<V1_3::IDevice>& device, const Model& model,
+                                 V1_1::ExecutionPreference preference, double& prepareMs) {
+    sp<PreparedModelCallback> callback = new PreparedModelCallback();
+    auto start = Clock::now();
+    auto status = device->prepareModel_1_3(model, preference, V1_3::Priority::MEDIUM, {}, {}, {},
+                                           {}, callback);
+    if (!status.isOk() || static_cast<V1_3::ErrorStatus>(status) != V1_3::ErrorStatus::NONE)
+        return "prepareModel_1_3 failed";
+    auto prepared = callback->get();
+    prepareMs = elapsedMs(start);
+    if (prepared.first != V1_3::ErrorStatus::NONE || prepared.second == nullptr)
+        return "model preparation failed";
+    return attach(prepared.second, model);
+}
+
+std::string ModelRunner::attach(const sp<V1_3::IPreparedModel>& preparedModel,
+                                const Model& model) {
+    mPreparedModel = preparedModel;
+    mRequest.inputs = createArguments(model, model.main.inputIndexes, 0, mInputPoolSize);
+    mRequest.outputs = createArguments(model, model.main.outputIndexes, 1, mOutputPoolSize);
+    mInputs = std::make_unique<SharedMemory>(mInputPoolSize);
+    mOutputs = std::make_unique<SharedMemory>(mOutputPoolSize);
+    if (!mInputs->isValid() || !mOutputs->isValid()) return "shared memory allocation failed";
+    mRequest.pools.resize(2);
+    mRequest.pools[0].hidlMemory(mInputs->getHidlMemory());
+    mRequest.pools[1].hidlMemory(mOutputs->getHidlMemory());
+    return "";
+}
+
+bool ModelRunner::execute(double& deviceMs, ExecutionMode mode) {
+    if (mode == ExecutionMode::ASYNC) return executeAsync(deviceMs);
+    if (mode == ExecutionMode::BURST) return executeBurst(deviceMs);
+
+    bool success = false;
+    mPreparedModel->executeSynchronously_1_3(
+        mRequest, V1_2::MeasureTiming::YES, {}, {},
+        [&](V1_3::ErrorStatus status, const hidl_vec<V1_2::OutputShape>&, V1_2::Timing timing) {
+            success = status == V1_3::ErrorStatus::NONE;
+            addTimeOnDevice(timing, deviceMs);
+        });
+    return success;
+}
+
+bool ModelRunner::executeAsync(double& deviceMs) {
+    sp<ExecutionCallback> callback = new ExecutionCallback();
+    auto status = mPreparedModel->execute_1_3(mRequest, V1_2::MeasureTiming::YES, {}, {},
+                                              callback);
+    if (!status.isOk() || static_cast<V1_3::ErrorStatus>(status) != V1_3::ErrorStatus::NONE)
+        return false;
+    auto result = callback->get();
+    addTimeOnDevice(result.second, deviceMs);
+    return result.first == V1_3::ErrorStatus::NONE;
+}
+
+bool ModelRunner::executeBurst(double& deviceMs) {
+    if (mBurst == nullptr) {
+        // No polling, like the runtime when the burst isn't configured for low latency
+        mBurst = nn::ExecutionBurstController::create(mPreparedModel,
+                                                      std::chrono::microseconds{0});
+        if (mBurst == nullptr) return false;
+    }
+    // The pools are cached on the driver side under these identifiers
+    const std::vector<intptr_t> memoryIds = {reinterpret_cast<intptr_t>(mInputs.get()),
+                                             reinterpret_cast<intptr_t>(mOutputs.get())};
+    auto result =
+        mBurst->compute(nn::convertToV1_0(mRequest), V1_2::MeasureTiming::YES, memoryIds);
+    addTimeOnDevice(std::get<2>(result), deviceMs);
+    return std::get<0>(result) == ANEURALNETWORKS_NO_ERROR;
+}
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
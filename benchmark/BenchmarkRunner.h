@@ -0,0 +1,91 @@
+#ifndef ANDROID_ML_NN_BENCHMARKRUNNER_H
+#define ANDROID_ML_NN_BENCHMARKRUNNER_H
+
+#include <cutils/native_handle.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Driver.h"
+#include "ExecutionBurstController.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start);
+// The nearest rank percentile, p in [0, 1]
+double percentile(std::vector<double> values, double p);
+
+// A shared memory pool passed as "mmap_fd", which RunTimePoolInfo maps on the driver side
+class SharedMemory {
+public:
+    explicit SharedMemory(size_t size);
+    ~SharedMemory();
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    bool isValid() const { return mBuffer != nullptr; }
+    uint8_t* getBuffer() const { return mBuffer; }
+    hidl_memory getHidlMemory() const;
+
+private:
+    size_t mSize;
+    int mFd = -1;
+    uint8_t* mBuffer = nullptr;
+    native_handle_t* mHandle = nullptr;
+};
+
+// executeSynchronously_1_3, execute_1_3 waiting for its callback, or an execution burst
+enum class ExecutionMode { SYNC, ASYNC, BURST };
+
+const char* getExecutionModeName(ExecutionMode mode);
+
+// Prepares a model on the device, or attaches to an already prepared one, and executes it, the
+// model inputs and outputs being laid out back to back in one input and one output pool. Several
+// runners attached to the same prepared model act as independent clients of it.
+class ModelRunner {
+public:
+    // Returns an empty string on success, or the step that failed. prepareMs is the time spent in
+    // prepareModel_1_3 until the callback is notified.
+    std::string prepare(const sp<V1_3::IDevice>& device, const Model& model,
+                        V1_1::ExecutionPreference preference, double& prepareMs);
+    std::string attach(const sp<V1_3::IPreparedModel>& preparedModel, const Model& model);
+    // Adds the timeOnDevice reported by the driver, if any, to deviceMs. The burst is configured
+    // by the first BURST execution.
+    bool execute(double& deviceMs, ExecutionMode mode = ExecutionMode::SYNC);
+
+    const sp<V1_3::IPreparedModel>& getPreparedModel() const { return mPreparedModel; }
+
+    uint8_t* getInput(size_t index) const {
+        return mInputs->getBuffer() + mRequest.inputs[index].location.offset;
+    }
+    const uint8_t* getOutput(size_t index) const {
+        return mOutputs->getBuffer() + mRequest.outputs[index].location.offset;
+    }
+    size_t getInputPoolSize() const { return mInputPoolSize; }
+    size_t getOutputPoolSize() const { return mOutputPoolSize; }
+
+private:
+    bool executeAsync(double& deviceMs);
+    bool executeBurst(double& deviceMs);
+
+    sp<V1_3::IPreparedModel> mPreparedModel;
+    V1_3::Request mRequest;
+    size_t mInputPoolSize = 0, mOutputPoolSize = 0;
+    std::unique_ptr<SharedMemory> mInputs, mOutputs;
+    std::unique_ptr<nn::ExecutionBurstController> mBurst;
+};
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_BENCHMARKRUNNER_H
@@ -0,0 +1,154 @@
+#include "ConcurrencyBenchmark.h"
+
+#include <sys/resource.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+namespace {
+// User and system CPU time of the process, which includes the driver
+double getCpuMs() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    auto toMs = [](const timeval& time) { return time.tv_sec * 1000.0 + time.tv_usec / 1000.0; };
+    return toMs(usage.ru_utime) + toMs(usage.ru_stime);
+}
+
+// Different inputs per client, so that an output computed from another client's request is
+// detected
+void fillInputs(ModelRunner& runner, size_t client) {
+    for (size_t i = 0; i < runner.getInputPoolSize(); i++)
+        runner.getInput(0)[i] = (i * 31 + client * 7) & 0x3f;
+}
+
+ConcurrencyResult runClients(const std::vector<sp<V1_3::IPreparedModel>>& preparedModels,
+                             const Workload& workload, ExecutionMode mode, size_t clients,
+                             const ConcurrencyOptions& options) {
+    ConcurrencyResult result;
+    result.workload = workload.name;
+    result.mode = mode;
+    result.models = preparedModels.size();
+    result.clients = clients;
+
+    // The reference outputs of each client are computed before the clients run concurrently
+    std::vector<ModelRunner> runners(clients);
+    std::vector<std::vector<uint8_t>> expected(clients);
+    for (size_t c = 0; c < clients; c++) {
+        result.error = runners[c].attach(preparedModels[c % preparedModels.size()], workload.model);
+        if (!result.error.empty()) return result;
+        fillInputs(runners[c], c);
+        double deviceMs = 0;
+        if (!runners[c].execute(deviceMs)) {
+            result.error = "execution failed";
+            return result;
+        }
+        expected[c].assign(runners[c].getOutput(0),
+                           runners[c].getOutput(0) + runners[c].getOutputPoolSize());
+    }
+
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> started{false};
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<size_t> failures(clients, 0), mismatches(clients, 0);
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < clients; c++) {
+        threads.emplace_back([&, c] {
+            auto& runner = runners[c];
+            double deviceMs = 0;
+            for (size_t i = 0; i < options.warmup; i++) runner.execute(deviceMs, mode);
+            ready++;
+            while (!started) std::this_thread::yield();
+
+            latencies[c].reserve(options.iterations);
+            for (size_t i = 0; i < options.iterations; i++) {
+                auto start = Clock::now();
+                if (!runner.execute(deviceMs, mode)) {
+                    failures[c]++;
+                    continue;
+                }
+                latencies[c].push_back(elapsedMs(start));
+                if (std::memcmp(runner.getOutput(0), expected[c].data(), expected[c].size()))
+                    mismatches[c]++;
+            }
+        });
+    }
+    while (ready < clients) std::this_thread::yield();
+    const double cpuStart = getCpuMs();
+    const auto start = Clock::now();
+    started = true;
+    for (auto& thread : threads) thread.join();
+    result.totalMs = elapsedMs(start);
+    result.cpuCores = (getCpuMs() - cpuStart) / result.totalMs;
+
+    for (size_t c = 0; c < clients; c++) {
+        result.latenciesMs.insert(result.latenciesMs.end(), latencies[c].begin(),
+                                  latencies[c].end());
+        result.failures += failures[c];
+        result.mismatches += mismatches[c];
+    }
+    if (result.failures > 0)
+        result.error = "executions failed";
+    else if (result.mismatches > 0)
+        result.error = "outputs differ from the single client run";
+    return result;
+}
+}  // namespace
+
+std::vector<ConcurrencyResult> runConcurrency(const sp<V1_3::IDevice>& device,
+                                              const Workload& workload,
+                                              const ConcurrencyOptions& options) {
+    std::vector<ConcurrencyResult> results;
+    std::vector<sp<V1_3::IPreparedModel>> preparedModels;
+    for (size_t i = 0; i < std::max<size_t>(options.models, 1); i++) {
+        ModelRunner runner;
+        double prepareMs;
+        const auto error = runner.prepare(device, workload.model, options.preference, prepareMs);
+        if (!error.empty()) {
+            ConcurrencyResult result;
+            result.workload = workload.name;
+            result.error = error;
+            results.push_back(result);
+            return results;
+        }
+        preparedModels.push_back(runner.getPreparedModel());
+    }
+
+    std::vector<size_t> clientCounts;
+    for (size_t clients = 1; clients < options.maxClients; clients *= 2)
+        clientCounts.push_back(clients);
+    clientCounts.push_back(std::max<size_t>(options.maxClients, 1));
+
+    for (auto mode : options.modes) {
+        double baseline = 0, previous = 0;
+        bool stopped = false;
+        for (auto clients : clientCounts) {
+            auto result = runClients(preparedModels, workload, mode, clients, options);
+            if (result.latenciesMs.empty() || result.totalMs <= 0) {
+                results.push_back(result);
+                continue;
+            }
+            const double throughput = result.latenciesMs.size() * 1000.0 / result.totalMs;
+            if (baseline == 0) baseline = throughput;
+            result.speedup = throughput / baseline;
+            if (!stopped && previous > 0 && throughput < previous * 1.1) {
+                result.scalingStopped = true;
+                stopped = true;
+            }
+            previous = throughput;
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,59 @@
+#ifndef ANDROID_ML_NN_CONCURRENCYBENCHMARK_H
+#define ANDROID_ML_NN_CONCURRENCYBENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkModels.h"
+#include "BenchmarkRunner.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+struct ConcurrencyOptions {
+    std::vector<ExecutionMode> modes = {ExecutionMode::SYNC, ExecutionMode::ASYNC,
+                                        ExecutionMode::BURST};
+    // Clients are run in powers of two up to maxClients, client i using prepared model i % models
+    size_t maxClients = 8;
+    size_t models = 1;
+    // Executions per client
+    size_t iterations = 100;
+    size_t warmup = 10;
+    V1_1::ExecutionPreference preference = V1_1::ExecutionPreference::FAST_SINGLE_ANSWER;
+};
+
+struct ConcurrencyResult {
+    std::string workload;
+    ExecutionMode mode = ExecutionMode::SYNC;
+    size_t models = 0;
+    size_t clients = 0;
+    std::string error;
+    size_t failures = 0;
+    // Executions whose outputs differ from the same client's inputs run alone, which happens
+    // when clients overwrite per prepared model state
+    size_t mismatches = 0;
+    std::vector<double> latenciesMs;
+    double totalMs = 0;
+    // Process CPU time over the run, in cores
+    double cpuCores = 0;
+    // Throughput relative to the single client run of the same mode
+    double speedup = 0;
+    // Set on the first run where doubling the clients raised the throughput by less than 10%
+    bool scalingStopped = false;
+};
+
+// Runs every mode with 1, 2, 4 ... maxClients concurrent clients
+std::vector<ConcurrencyResult> runConcurrency(const sp<V1_3::IDevice>& device,
+                                              const Workload& workload,
+                                              const ConcurrencyOptions& options);
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_CONCURRENCYBENCHMARK_H
@@ -0,0 +1,1265 @@
+#include "OperationBenchmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+#include "BenchmarkModels.h"
+#include "BenchmarkRunner.h"
+#include "DriverConfig.h"
+#include "ModelManager.h"
+#include "NgraphNetworkCreator.hpp"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+namespace {
+using Tensor = std::vector<float>;
+using Dims = std::vector<uint32_t>;
+
+// NNAPI fused activation and padding codes
+constexpr int32_t kActivationNone = 0;
+constexpr int32_t kActivationRelu = 1;
+constexpr int32_t kActivationTanh = 4;
+constexpr int32_t kPaddingSame = 1;
+
+// Quantized outputs may be one step away from the rounded reference, as the reference rounds the
+// exact value while the kernels round their own float or int32 accumulation
+constexpr float kQuantizedTolerance = 1.f;
+
+// xorshift, so that every run checks the same values
+uint32_t nextRandom() {
+    static uint32_t state = 88675123u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+Tensor randomValues(size_t count, float min, float max) {
+    Tensor values(count);
+    for (auto& value : values) value = min + (max - min) * (nextRandom() % 65536) / 65535.f;
+    return values;
+}
+
+std::vector<uint8_t> randomQuant8Values(size_t count) {
+    std::vector<uint8_t> values(count);
+    for (auto& value : values) value = nextRandom() & 0xff;
+    return values;
+}
+
+Tensor dequantize(const uint8_t* values, size_t count, float scale, int32_t zeroPoint) {
+    Tensor real(count);
+    for (size_t i = 0; i < count; i++) real[i] = (int32_t(values[i]) - zeroPoint) * scale;
+    return real;
+}
+
+// Quantization of the product of the input and weights scales
+std::vector<int32_t> randomBiasValues(size_t count) {
+    std::vector<int32_t> values(count);
+    for (auto& value : values) value = int32_t(nextRandom() % 2001) - 1000;
+    return values;
+}
+
+size_t getElementCount(const Dims& dims) {
+    size_t count = 1;
+    for (auto dim : dims) count *= dim;
+    return count;
+}
+
+std::string getCaseName(OperationType type, const std::string& typeName, const Dims& dims,
+                        const std::string& variant = "") {
+    std::string name = toString(type) + "." + typeName + ".";
+    for (size_t i = 0; i < dims.size(); i++) name += (i ? "x" : "") + std::to_string(dims[i]);
+    return variant.empty() ? name : name + "." + variant;
+}
+
+uint32_t addBool(ModelBuilder& builder, bool value) {
+    const uint8_t byte = value;
+    return builder.addConstant(OperandType::BOOL, {}, &byte, sizeof(byte));
+}
+
+uint32_t addFloatTensor(ModelBuilder& builder, const Dims& dims, const Tensor& values) {
+    return builder.addConstant(OperandType::TENSOR_FLOAT32, dims, values.data(),
+                               values.size() * sizeof(float));
+}
+
+uint32_t addInt32Tensor(ModelBuilder& builder, const std::vector<int32_t>& values) {
+    return builder.addConstant(OperandType::TENSOR_INT32, {uint32_t(values.size())},
+                               values.data(), values.size() * sizeof(int32_t));
+}
+
+float relu(float value) { return std::max(value, 0.f); }
+
+// Indexes a 4D tensor given by its NHWC sizes, stored as NHWC or NCHW
+struct Layout {
+    uint32_t height, width, channels;
+    bool nchw;
+
+    size_t at(uint32_t n, uint32_t y, uint32_t x, uint32_t c) const {
+        return nchw ? ((size_t(n) * channels + c) * height + y) * width + x
+                    : ((size_t(n) * height + y) * width + x) * channels + c;
+    }
+    Dims getDims(uint32_t batch) const {
+        return nchw ? Dims{batch, channels, height, width} : Dims{batch, height, width, channels};
+    }
+};
+
+// The leading SAME padding of a dimension, the trailing one taking the remainder
+uint32_t getSamePadding(uint32_t size, uint32_t stride, uint32_t kernel) {
+    const uint32_t outSize = (size + stride - 1) / stride;
+    const int32_t total = int32_t((outSize - 1) * stride + kernel) - int32_t(size);
+    return std::max(total, 0) / 2;
+}
+
+// ADD, SUB, MUL, DIV, or MAXIMUM and MINIMUM which take no activation when activation < 0. The
+// second input either has the shape of the first one or is broadcast along its last dimension.
+OperationCase createBinaryCase(OperationType type, const Dims& dims, const Dims& secondDims,
+                               int32_t activation, std::function<float(float, float)> function,
+                               float inputMin = -1.f, float inputMax = 1.f) {
+    ModelBuilder builder;
+    std::vector<uint32_t> inputs = {builder.addInput(OperandType::TENSOR_FLOAT32, dims),
+                                    builder.addInput(OperandType::TENSOR_FLOAT32, secondDims)};
+    if (activation >= 0) inputs.push_back(builder.addInt32(activation));
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, dims);
+    builder.addOperation(type, inputs, {output});
+
+    std::string variant = secondDims == dims ? "" : "broadcast";
+    if (activation == kActivationRelu) variant += variant.empty() ? "relu" : ".relu";
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, "float32", dims, variant);
+    operationCase.type = type;
+    operationCase.model = builder.build();
+    operationCase.reference = [function, activation](const std::vector<Tensor>& inputs) {
+        Tensor output(inputs[0].size());
+        for (size_t i = 0; i < output.size(); i++) {
+            output[i] = function(inputs[0][i], inputs[1][i % inputs[1].size()]);
+            if (activation == kActivationRelu) output[i] = relu(output[i]);
+        }
+        return std::vector<Tensor>{output};
+    };
+    operationCase.inputMin = inputMin;
+    operationCase.inputMax = inputMax;
+    return operationCase;
+}
+
+// ADD with both inputs and the output quantized
+OperationCase createQuant8AddCase(const Dims& dims) {
+    ModelBuilder builder;
+    auto first = builder.addInput(OperandType::TENSOR_QUANT8_ASYMM, dims, 0.05f, 128);
+    auto second = builder.addInput(OperandType::TENSOR_QUANT8_ASYMM, dims, 0.05f, 128);
+    auto output = builder.addOutput(OperandType::TENSOR_QUANT8_ASYMM, dims, 0.1f, 128);
+    builder.addOperation(OperationType::ADD,
+                         {first, second, builder.addInt32(kActivationNone)}, {output});
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::ADD, "quant8", dims);
+    operationCase.type = OperationType::ADD;
+    operationCase.model = builder.build();
+    operationCase.quantized = true;
+    operationCase.reference = [](const std::vector<Tensor>& inputs) {
+        Tensor output(inputs[0].size());
+        for (size_t i = 0; i < output.size(); i++) output[i] = inputs[0][i] + inputs[1][i];
+        return std::vector<Tensor>{output};
+    };
+    operationCase.tolerance = kQuantizedTolerance;
+    return operationCase;
+}
+
+OperationCase createUnaryCase(OperationType type, const Dims& dims,
+                              std::function<float(float)> function, float inputMin,
+                              float inputMax) {
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, dims);
+    builder.addOperation(type, {input}, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, "float32", dims);
+    operationCase.type = type;
+    operationCase.model = builder.build();
+    operationCase.reference = [function](const std::vector<Tensor>& inputs) {
+        Tensor output(inputs[0].size());
+        std::transform(inputs[0].begin(), inputs[0].end(), output.begin(), function);
+        return std::vector<Tensor>{output};
+    };
+    operationCase.inputMin = inputMin;
+    operationCase.inputMax = inputMax;
+    return operationCase;
+}
+
+// CONV_2D, or DEPTHWISE_CONV_2D with a depth multiplier of outChannels / channels, with SAME
+// padding and a fused RELU. The layout operand is only passed for NCHW, NHWC being the default.
+// The reference of quantized cases runs on the dequantized weights.
+OperationCase createConvCase(bool depthwise, const Dims& nhwc, uint32_t outChannels,
+                             uint32_t kernel, uint32_t stride, bool nchw, bool quantized) {
+    const auto type = depthwise ? OperationType::DEPTHWISE_CONV_2D : OperationType::CONV_2D;
+    const uint32_t batch = nhwc[0], channels = nhwc[3];
+    const Layout in = {nhwc[1], nhwc[2], channels, nchw};
+    const Layout out = {(in.height + stride - 1) / stride, (in.width + stride - 1) / stride,
+                        outChannels, nchw};
+    const Dims filterDims = depthwise ? Dims{1, kernel, kernel, outChannels}
+                                      : Dims{outChannels, kernel, kernel, channels};
+
+    ModelBuilder builder;
+    uint32_t input, filter, bias, output;
+    Tensor filterValues, biasValues;
+    if (quantized) {
+        const auto operandType = OperandType::TENSOR_QUANT8_ASYMM;
+        const float inputScale = 0.0078125f, filterScale = 0.01f;
+        const auto filterData = randomQuant8Values(getElementCount(filterDims));
+        const auto biasData = randomBiasValues(outChannels);
+        filterValues = dequantize(filterData.data(), filterData.size(), filterScale, 128);
+        for (auto value : biasData) biasValues.push_back(value * inputScale * filterScale);
+        input = builder.addInput(operandType, in.getDims(batch), inputScale, 128);
+        filter = builder.addConstant(operandType, filterDims, filterData.data(),
+                                     filterData.size(), filterScale, 128);
+        bias = builder.addConstant(OperandType::TENSOR_INT32, {outChannels}, biasData.data(),
+                                   biasData.size() * sizeof(int32_t), inputScale * filterScale);
+        output = builder.addOutput(operandType, out.getDims(batch), 0.05f, 0);
+    } else {
+        filterValues = randomValues(getElementCount(filterDims), -0.1f, 0.1f);
+        biasValues = randomValues(outChannels, -0.1f, 0.1f);
+        input = builder.addInput(OperandType::TENSOR_FLOAT32, in.getDims(batch));
+        filter = addFloatTensor(builder, filterDims, filterValues);
+        bias = addFloatTensor(builder, {outChannels}, biasValues);
+        output = builder.addOutput(OperandType::TENSOR_FLOAT32, out.getDims(batch));
+    }
+    std::vector<uint32_t> inputs = {input,
+                                    filter,
+                                    bias,
+                                    builder.addInt32(kPaddingSame),
+                                    builder.addInt32(stride),
+                                    builder.addInt32(stride)};
+    if (depthwise) inputs.push_back(builder.addInt32(outChannels / channels));
+    inputs.push_back(builder.addInt32(kActivationRelu));
+    if (nchw) inputs.push_back(addBool(builder, true));
+    builder.addOperation(type, inputs, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, quantized ? "quant8" : "float32", nhwc,
+                                     nchw ? "nchw" : "nhwc");
+    operationCase.type = type;
+    operationCase.model = builder.build();
+    operationCase.quantized = quantized;
+
+    const uint32_t padTop = getSamePadding(in.height, stride, kernel);
+    const uint32_t padLeft = getSamePadding(in.width, stride, kernel);
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        const auto& x = inputs[0];
+        Tensor y(getElementCount(out.getDims(batch)));
+        for (uint32_t n = 0; n < batch; n++)
+            for (uint32_t oy = 0; oy < out.height; oy++)
+                for (uint32_t ox = 0; ox < out.width; ox++)
+                    for (uint32_t oc = 0; oc < outChannels; oc++) {
+                        float sum = biasValues[oc];
+                        for (uint32_t ky = 0; ky < kernel; ky++) {
+                            const int32_t iy = int32_t(oy * stride + ky) - int32_t(padTop);
+                            if (iy < 0 || iy >= int32_t(in.height)) continue;
+                            for (uint32_t kx = 0; kx < kernel; kx++) {
+                                const int32_t ix = int32_t(ox * stride + kx) - int32_t(padLeft);
+                                if (ix < 0 || ix >= int32_t(in.width)) continue;
+                                if (depthwise) {
+                                    const uint32_t ic = oc / (outChannels / channels);
+                                    sum += x[in.at(n, iy, ix, ic)] *
+                                           filterValues[(ky * kernel + kx) * outChannels + oc];
+                                    continue;
+                                }
+                                for (uint32_t ic = 0; ic < channels; ic++)
+                                    sum += x[in.at(n, iy, ix, ic)] *
+                                           filterValues[((oc * kernel + ky) * kernel + kx) *
+                                                            channels +
+                                                        ic];
+                            }
+                        }
+                        y[out.at(n, oy, ox, oc)] = relu(sum);
+                    }
+        return std::vector<Tensor>{y};
+    };
+    operationCase.tolerance = quantized ? kQuantizedTolerance : 1e-3f;
+    return operationCase;
+}
+
+// AVERAGE_POOL_2D or MAX_POOL_2D with SAME padding, the average excluding the padding
+OperationCase createPoolCase(OperationType type, const Dims& nhwc, uint32_t kernel,
+                             uint32_t stride, bool nchw) {
+    const uint32_t batch = nhwc[0];
+    const Layout in = {nhwc[1], nhwc[2], nhwc[3], nchw};
+    const Layout out = {(in.height + stride - 1) / stride, (in.width + stride - 1) / stride,
+                        in.channels, nchw};
+
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, in.getDims(batch));
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, out.getDims(batch));
+    std::vector<uint32_t> inputs = {input,
+                                    builder.addInt32(kPaddingSame),
+                                    builder.addInt32(stride),
+                                    builder.addInt32(stride),
+                                    builder.addInt32(kernel),
+                                    builder.addInt32(kernel),
+                                    builder.addInt32(kActivationNone)};
+    if (nchw) inputs.push_back(addBool(builder, true));
+    builder.addOperation(type, inputs, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, "float32", nhwc, nchw ? "nchw" : "nhwc");
+    operationCase.type = type;
+    operationCase.model = builder.build();
+
+    const bool average = type == OperationType::AVERAGE_POOL_2D;
+    const uint32_t padTop = getSamePadding(in.height, stride, kernel);
+    const uint32_t padLeft = getSamePadding(in.width, stride, kernel);
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        const auto& x = inputs[0];
+        Tensor y(getElementCount(out.getDims(batch)));
+        for (uint32_t n = 0; n < batch; n++)
+            for (uint32_t oy = 0; oy < out.height; oy++)
+                for (uint32_t ox = 0; ox < out.width; ox++)
+                    for (uint32_t c = 0; c < in.channels; c++) {
+                        float value = average ? 0.f : -INFINITY;
+                        uint32_t count = 0;
+                        for (uint32_t ky = 0; ky < kernel; ky++) {
+                            const int32_t iy = int32_t(oy * stride + ky) - int32_t(padTop);
+                            if (iy < 0 || iy >= int32_t(in.height)) continue;
+                            for (uint32_t kx = 0; kx < kernel; kx++) {
+                                const int32_t ix = int32_t(ox * stride + kx) - int32_t(padLeft);
+                                if (ix < 0 || ix >= int32_t(in.width)) continue;
+                                const float element = x[in.at(n, iy, ix, c)];
+                                value = average ? value + element : std::max(value, element);
+                                count++;
+                            }
+                        }
+                        y[out.at(n, oy, ox, c)] = average ? value / count : value;
+                    }
+        return std::vector<Tensor>{y};
+    };
+    return operationCase;
+}
+
+// The reference of quantized cases runs on the dequantized weights
+OperationCase createFullyConnectedCase(uint32_t batch, uint32_t inputSize, uint32_t units,
+                                       bool quantized) {
+    ModelBuilder builder;
+    uint32_t input, weights, bias, output;
+    Tensor weightValues, biasValues;
+    if (quantized) {
+        const auto operandType = OperandType::TENSOR_QUANT8_ASYMM;
+        const float inputScale = 0.0078125f, weightsScale = 0.01f;
+        const auto weightsData = randomQuant8Values(size_t(units) * inputSize);
+        const auto biasData = randomBiasValues(units);
+        weightValues = dequantize(weightsData.data(), weightsData.size(), weightsScale, 128);
+        for (auto value : biasData) biasValues.push_back(value * inputScale * weightsScale);
+        input = builder.addInput(operandType, {batch, inputSize}, inputScale, 128);
+        weights = builder.addConstant(operandType, {units, inputSize}, weightsData.data(),
+                                      weightsData.size(), weightsScale, 128);
+        bias = builder.addConstant(OperandType::TENSOR_INT32, {units}, biasData.data(),
+                                   biasData.size() * sizeof(int32_t), inputScale * weightsScale);
+        output = builder.addOutput(operandType, {batch, units}, 0.05f, 0);
+    } else {
+        weightValues = randomValues(size_t(units) * inputSize, -0.1f, 0.1f);
+        biasValues = randomValues(units, -0.1f, 0.1f);
+        input = builder.addInput(OperandType::TENSOR_FLOAT32, {batch, inputSize});
+        weights = addFloatTensor(builder, {units, inputSize}, weightValues);
+        bias = addFloatTensor(builder, {units}, biasValues);
+        output = builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, units});
+    }
+    builder.addOperation(OperationType::FULLY_CONNECTED,
+                         {input, weights, bias, builder.addInt32(kActivationRelu)}, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::FULLY_CONNECTED,
+                                     quantized ? "quant8" : "float32", {batch, inputSize},
+                                     std::to_string(units));
+    operationCase.type = OperationType::FULLY_CONNECTED;
+    operationCase.model = builder.build();
+    operationCase.quantized = quantized;
+
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y(size_t(batch) * units);
+        for (uint32_t b = 0; b < batch; b++)
+            for (uint32_t u = 0; u < units; u++) {
+                float sum = biasValues[u];
+                for (uint32_t i = 0; i < inputSize; i++)
+                    sum += inputs[0][size_t(b) * inputSize + i] *
+                           weightValues[size_t(u) * inputSize + i];
+                y[size_t(b) * units + u] = relu(sum);
+            }
+        return std::vector<Tensor>{y};
+    };
+    operationCase.tolerance = quantized ? kQuantizedTolerance : 1e-3f;
+    return operationCase;
+}
+
+// SOFTMAX, LOG_SOFTMAX or L2_NORMALIZATION along the last dimension
+OperationCase createNormalizationCase(OperationType type, const Dims& dims) {
+    ModelBuilder builder;
+    std::vector<uint32_t> inputs = {builder.addInput(OperandType::TENSOR_FLOAT32, dims)};
+    if (type != OperationType::L2_NORMALIZATION) inputs.push_back(builder.addFloat32(1.f));
+    if (type == OperationType::LOG_SOFTMAX) inputs.push_back(builder.addInt32(-1));
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, dims);
+    builder.addOperation(type, inputs, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, "float32", dims);
+    operationCase.type = type;
+    operationCase.model = builder.build();
+    const uint32_t depth = dims.back();
+    const bool softmax = type != OperationType::L2_NORMALIZATION;
+    const bool logSoftmax = type == OperationType::LOG_SOFTMAX;
+    operationCase.reference = [depth, softmax, logSoftmax](const std::vector<Tensor>& inputs) {
+        const auto& x = inputs[0];
+        Tensor y(x.size());
+        for (size_t offset = 0; offset < x.size(); offset += depth) {
+            const auto begin = x.begin() + offset, end = begin + depth;
+            const float max = *std::max_element(begin, end);
+            float sum = 0;
+            for (auto it = begin; it != end; it++)
+                sum += softmax ? std::exp(*it - max) : *it * *it;
+            for (uint32_t i = 0; i < depth; i++)
+                y[offset + i] = logSoftmax ? x[offset + i] - max - std::log(sum)
+                                : softmax    ? std::exp(x[offset + i] - max) / sum
+                                             : x[offset + i] / std::sqrt(sum);
+        }
+        return std::vector<Tensor>{y};
+    };
+    return operationCase;
+}
+
+// MEAN, REDUCE_SUM, REDUCE_PROD, REDUCE_MAX or REDUCE_MIN over the spatial dimensions of an NHWC
+// tensor, keeping them
+OperationCase createReduceCase(OperationType type, const Dims& dims) {
+    const uint32_t batch = dims[0], spatial = dims[1] * dims[2], channels = dims[3];
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, 1, 1, channels});
+    const bool keepDims = true;
+    // MEAN takes keep_dims as an INT32, the other reductions as a BOOL
+    builder.addOperation(type,
+                         {input, addInt32Tensor(builder, {1, 2}),
+                          type == OperationType::MEAN ? builder.addInt32(keepDims)
+                                                      : addBool(builder, keepDims)},
+                         {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, "float32", dims);
+    operationCase.type = type;
+    operationCase.model = builder.build();
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y(size_t(batch) * channels);
+        for (uint32_t n = 0; n < batch; n++)
+            for (uint32_t c = 0; c < channels; c++) {
+                float value = type == OperationType::REDUCE_MAX   ? -INFINITY
+                              : type == OperationType::REDUCE_MIN ? INFINITY
+                              : type == OperationType::REDUCE_PROD ? 1.f
+                                                                   : 0.f;
+                for (uint32_t i = 0; i < spatial; i++) {
+                    const float element = inputs[0][(size_t(n) * spatial + i) * channels + c];
+                    switch (type) {
+                        case OperationType::REDUCE_MAX:
+                            value = std::max(value, element);
+                            break;
+                        case OperationType::REDUCE_MIN:
+                            value = std::min(value, element);
+                            break;
+                        case OperationType::REDUCE_PROD:
+                            value *= element;
+                            break;
+                        default:
+                            value += element;
+                    }
+                }
+                y[size_t(n) * channels + c] = type == OperationType::MEAN ? value / spatial : value;
+            }
+        return std::vector<Tensor>{y};
+    };
+    operationCase.tolerance = 1e-3f;
+    // Keeps the product of the spatial elements within the float range
+    if (type == OperationType::REDUCE_PROD) {
+        operationCase.inputMin = 0.99f;
+        operationCase.inputMax = 1.01f;
+    }
+    return operationCase;
+}
+
+// Two inputs concatenated along the last dimension
+OperationCase createConcatenationCase(const Dims& dims) {
+    Dims outDims = dims;
+    outDims.back() *= 2;
+    ModelBuilder builder;
+    auto first = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto second = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, outDims);
+    builder.addOperation(OperationType::CONCATENATION,
+                         {first, second, builder.addInt32(dims.size() - 1)}, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::CONCATENATION, "float32", dims);
+    operationCase.type = OperationType::CONCATENATION;
+    operationCase.model = builder.build();
+    const uint32_t depth = dims.back();
+    operationCase.reference = [depth](const std::vector<Tensor>& inputs) {
+        Tensor y;
+        y.reserve(inputs[0].size() * 2);
+        for (size_t offset = 0; offset < inputs[0].size(); offset += depth) {
+            for (const auto& input : inputs)
+                y.insert(y.end(), input.begin() + offset, input.begin() + offset + depth);
+        }
+        return std::vector<Tensor>{y};
+    };
+    return operationCase;
+}
+
+// NHWC to NCHW
+OperationCase createTransposeCase(const Dims& dims) {
+    const Layout in = {dims[1], dims[2], dims[3], false};
+    const Layout out = {dims[1], dims[2], dims[3], true};
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, out.getDims(dims[0]));
+    builder.addOperation(OperationType::TRANSPOSE, {input, addInt32Tensor(builder, {0, 3, 1, 2})},
+                         {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::TRANSPOSE, "float32", dims);
+    operationCase.type = OperationType::TRANSPOSE;
+    operationCase.model = builder.build();
+    const uint32_t batch = dims[0];
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y(inputs[0].size());
+        for (uint32_t n = 0; n < batch; n++)
+            for (uint32_t h = 0; h < in.height; h++)
+                for (uint32_t w = 0; w < in.width; w++)
+                    for (uint32_t c = 0; c < in.channels; c++)
+                        y[out.at(n, h, w, c)] = inputs[0][in.at(n, h, w, c)];
+        return std::vector<Tensor>{y};
+    };
+    return operationCase;
+}
+
+// Merges the two middle dimensions of a 4D tensor
+OperationCase createReshapeCase(const Dims& dims) {
+    const Dims outDims = {dims[0], dims[1] * dims[2], dims[3]};
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, outDims);
+    builder.addOperation(
+        OperationType::RESHAPE,
+        {input, addInt32Tensor(builder, {int32_t(outDims[0]), -1, int32_t(outDims[2])})},
+        {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::RESHAPE, "float32", dims);
+    operationCase.type = OperationType::RESHAPE;
+    operationCase.model = builder.build();
+    operationCase.reference = [](const std::vector<Tensor>& inputs) {
+        return std::vector<Tensor>{inputs[0]};
+    };
+    return operationCase;
+}
+
+// QUANTIZE of float32 values or DEQUANTIZE of quant8 ones, the reference being the real values
+OperationCase createQuantizeCase(OperationType type, const Dims& dims) {
+    const bool quantize = type == OperationType::QUANTIZE;
+    ModelBuilder builder;
+    auto input = quantize ? builder.addInput(OperandType::TENSOR_FLOAT32, dims)
+                          : builder.addInput(OperandType::TENSOR_QUANT8_ASYMM, dims, 0.05f, 128);
+    auto output = quantize
+                      ? builder.addOutput(OperandType::TENSOR_QUANT8_ASYMM, dims, 1.f / 64, 128)
+                      : builder.addOutput(OperandType::TENSOR_FLOAT32, dims);
+    builder.addOperation(type, {input}, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, quantize ? "float32" : "quant8", dims);
+    operationCase.type = type;
+    operationCase.model = builder.build();
+    operationCase.reference = [](const std::vector<Tensor>& inputs) {
+        return std::vector<Tensor>{inputs[0]};
+    };
+    if (quantize) operationCase.tolerance = kQuantizedTolerance;
+    operationCase.inputMin = -2.f;
+    operationCase.inputMax = 2.f;
+    return operationCase;
+}
+
+// Bilinear interpolation in a feature map, the neighbours past its last row or column being the
+// last row or column
+float interpolate(const Tensor& values, const Layout& layout, uint32_t n, float y, float x,
+                  uint32_t c) {
+    const uint32_t y0 = uint32_t(y), x0 = uint32_t(x);
+    const uint32_t y1 = std::min(y0 + 1, layout.height - 1);
+    const uint32_t x1 = std::min(x0 + 1, layout.width - 1);
+    const float dy = y - y0, dx = x - x0;
+    return (1 - dy) * ((1 - dx) * values[layout.at(n, y0, x0, c)] +
+                       dx * values[layout.at(n, y0, x1, c)]) +
+           dy * ((1 - dx) * values[layout.at(n, y1, x0, c)] + dx * values[layout.at(n, y1, x1, c)]);
+}
+
+// RESIZE_BILINEAR or RESIZE_NEAREST_NEIGHBOR of an NHWC tensor to twice its size, given as the
+// output size, with neither align_corners nor half_pixel_centers
+OperationCase createResizeCase(OperationType type, const Dims& dims) {
+    const uint32_t batch = dims[0];
+    const Layout in = {dims[1], dims[2], dims[3], false};
+    const Layout out = {in.height * 2, in.width * 2, in.channels, false};
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, out.getDims(batch));
+    builder.addOperation(
+        type, {input, builder.addInt32(out.width), builder.addInt32(out.height)}, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(type, "float32", dims);
+    operationCase.type = type;
+    operationCase.model = builder.build();
+    const bool bilinear = type == OperationType::RESIZE_BILINEAR;
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        const auto& x = inputs[0];
+        Tensor y(getElementCount(out.getDims(batch)));
+        // The source coordinates are the output ones times the input to output size ratio
+        const float scaleY = float(in.height) / out.height, scaleX = float(in.width) / out.width;
+        for (uint32_t n = 0; n < batch; n++)
+            for (uint32_t oy = 0; oy < out.height; oy++)
+                for (uint32_t ox = 0; ox < out.width; ox++)
+                    for (uint32_t c = 0; c < in.channels; c++) {
+                        const float sy = oy * scaleY, sx = ox * scaleX;
+                        y[out.at(n, oy, ox, c)] =
+                            bilinear ? interpolate(x, in, n, sy, sx, c)
+                                     : x[in.at(n, uint32_t(sy), uint32_t(sx), c)];
+                    }
+        return std::vector<Tensor>{y};
+    };
+    operationCase.tolerance = 1e-3f;
+    return operationCase;
+}
+
+// GATHER of the last, first and middle rows of an NHWC tensor, the indices being a constant
+OperationCase createGatherCase(const Dims& dims) {
+    const std::vector<int32_t> indices = {int32_t(dims[1]) - 1, 0, int32_t(dims[1]) / 2};
+    Dims outDims = dims;
+    outDims[1] = indices.size();
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, outDims);
+    builder.addOperation(OperationType::GATHER,
+                         {input, builder.addInt32(1), addInt32Tensor(builder, indices)}, {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::GATHER, "float32", dims);
+    operationCase.type = OperationType::GATHER;
+    operationCase.model = builder.build();
+    const size_t rowSize = size_t(dims[2]) * dims[3], batchSize = rowSize * dims[1];
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y;
+        y.reserve(getElementCount(outDims));
+        for (size_t offset = 0; offset < inputs[0].size(); offset += batchSize)
+            for (auto index : indices) {
+                const auto row = inputs[0].begin() + offset + index * rowSize;
+                y.insert(y.end(), row, row + rowSize);
+            }
+        return std::vector<Tensor>{y};
+    };
+    return operationCase;
+}
+
+// PAD of an NHWC tensor with one zero row and two zero columns on each side
+OperationCase createPadCase(const Dims& dims) {
+    const uint32_t batch = dims[0];
+    const Layout in = {dims[1], dims[2], dims[3], false};
+    const Layout out = {in.height + 2, in.width + 4, in.channels, false};
+    const std::vector<int32_t> paddings = {0, 0, 1, 1, 2, 2, 0, 0};
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, out.getDims(batch));
+    builder.addOperation(OperationType::PAD,
+                         {input, builder.addConstant(OperandType::TENSOR_INT32, {4, 2},
+                                                     paddings.data(),
+                                                     paddings.size() * sizeof(int32_t))},
+                         {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::PAD, "float32", dims);
+    operationCase.type = OperationType::PAD;
+    operationCase.model = builder.build();
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y(getElementCount(out.getDims(batch)), 0.f);
+        for (uint32_t n = 0; n < batch; n++)
+            for (uint32_t h = 0; h < in.height; h++)
+                for (uint32_t w = 0; w < in.width; w++)
+                    for (uint32_t c = 0; c < in.channels; c++)
+                        y[out.at(n, h + 1, w + 2, c)] = inputs[0][in.at(n, h, w, c)];
+        return std::vector<Tensor>{y};
+    };
+    return operationCase;
+}
+
+// SPLIT of the channels in two halves
+OperationCase createSplitCase(const Dims& dims) {
+    Dims outDims = dims;
+    outDims.back() /= 2;
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto first = builder.addOutput(OperandType::TENSOR_FLOAT32, outDims);
+    auto second = builder.addOutput(OperandType::TENSOR_FLOAT32, outDims);
+    builder.addOperation(OperationType::SPLIT,
+                         {input, builder.addInt32(dims.size() - 1), builder.addInt32(2)},
+                         {first, second});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::SPLIT, "float32", dims);
+    operationCase.type = OperationType::SPLIT;
+    operationCase.model = builder.build();
+    const uint32_t depth = outDims.back();
+    operationCase.reference = [depth](const std::vector<Tensor>& inputs) {
+        std::vector<Tensor> y(2);
+        for (size_t offset = 0; offset < inputs[0].size(); offset += 2 * depth) {
+            for (size_t i = 0; i < y.size(); i++) {
+                const auto begin = inputs[0].begin() + offset + i * depth;
+                y[i].insert(y[i].end(), begin, begin + depth);
+            }
+        }
+        return y;
+    };
+    return operationCase;
+}
+
+// TOPK_V2 of each row. Equal values may come in any order, so only the values are checked and not
+// their indices.
+OperationCase createTopkCase(uint32_t rows, uint32_t columns, uint32_t k) {
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, {rows, columns});
+    auto values = builder.addOutput(OperandType::TENSOR_FLOAT32, {rows, k});
+    auto indices = builder.addOutput(OperandType::TENSOR_INT32, {rows, k});
+    builder.addOperation(OperationType::TOPK_V2, {input, builder.addInt32(k)}, {values, indices});
+
+    OperationCase operationCase;
+    operationCase.name =
+        getCaseName(OperationType::TOPK_V2, "float32", {rows, columns}, std::to_string(k));
+    operationCase.type = OperationType::TOPK_V2;
+    operationCase.model = builder.build();
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y;
+        for (size_t offset = 0; offset < inputs[0].size(); offset += columns) {
+            Tensor row(inputs[0].begin() + offset, inputs[0].begin() + offset + columns);
+            std::partial_sort(row.begin(), row.begin() + k, row.end(), std::greater<float>());
+            y.insert(y.end(), row.begin(), row.begin() + k);
+        }
+        return std::vector<Tensor>{y, Tensor()};
+    };
+    return operationCase;
+}
+
+// ROI_ALIGN of two boxes inside an NHWC feature map into 2x2 bins of 2x2 samples. The boxes are an
+// input, as they are when a detection model computes them.
+OperationCase createRoiAlignCase(const Dims& dims) {
+    const Layout in = {dims[1], dims[2], dims[3], false};
+    const uint32_t bins = 2, samples = 2;
+    const Tensor boxes = {1.f, 1.f, 5.f, 6.f, 2.5f, 0.5f, in.width - 2.f, in.height - 2.5f};
+    const uint32_t boxCount = boxes.size() / 4;
+    const Layout out = {bins, bins, in.channels, false};
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto rois = builder.addInput(OperandType::TENSOR_FLOAT32, {boxCount, 4});
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, out.getDims(boxCount));
+    builder.addOperation(OperationType::ROI_ALIGN,
+                         {input, rois, addInt32Tensor(builder, std::vector<int32_t>(boxCount, 0)),
+                          builder.addInt32(bins), builder.addInt32(bins), builder.addFloat32(1.f),
+                          builder.addFloat32(1.f), builder.addInt32(samples),
+                          builder.addInt32(samples), addBool(builder, false)},
+                         {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::ROI_ALIGN, "float32", dims);
+    operationCase.type = OperationType::ROI_ALIGN;
+    operationCase.model = builder.build();
+    operationCase.inputValues = {Tensor(), boxes};
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y(getElementCount(out.getDims(boxCount)));
+        for (uint32_t r = 0; r < boxCount; r++) {
+            const float* box = &boxes[r * 4];
+            const float binWidth = std::max(box[2] - box[0], 1.f) / bins;
+            const float binHeight = std::max(box[3] - box[1], 1.f) / bins;
+            for (uint32_t by = 0; by < bins; by++)
+                for (uint32_t bx = 0; bx < bins; bx++)
+                    for (uint32_t c = 0; c < in.channels; c++) {
+                        float sum = 0;
+                        for (uint32_t sy = 0; sy < samples; sy++)
+                            for (uint32_t sx = 0; sx < samples; sx++)
+                                sum += interpolate(
+                                    inputs[0], in, 0,
+                                    box[1] + binHeight * (by + (sy + 0.5f) / samples),
+                                    box[0] + binWidth * (bx + (sx + 0.5f) / samples), c);
+                        y[out.at(r, by, bx, c)] = sum / (samples * samples);
+                    }
+        }
+        return std::vector<Tensor>{y};
+    };
+    operationCase.tolerance = 1e-3f;
+    return operationCase;
+}
+
+// ROI_POOLING of two boxes with integer corners into 2x2 bins that divide them evenly
+OperationCase createRoiPoolingCase(const Dims& dims) {
+    const Layout in = {dims[1], dims[2], dims[3], false};
+    const uint32_t bins = 2;
+    const Tensor boxes = {0.f, 0.f, 3.f, 3.f, 2.f, 1.f, 5.f, 4.f};
+    const uint32_t boxCount = boxes.size() / 4;
+    const Layout out = {bins, bins, in.channels, false};
+    ModelBuilder builder;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, dims);
+    auto rois = builder.addInput(OperandType::TENSOR_FLOAT32, {boxCount, 4});
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, out.getDims(boxCount));
+    builder.addOperation(OperationType::ROI_POOLING,
+                         {input, rois, addInt32Tensor(builder, std::vector<int32_t>(boxCount, 0)),
+                          builder.addInt32(bins), builder.addInt32(bins), builder.addFloat32(1.f),
+                          builder.addFloat32(1.f), addBool(builder, false)},
+                         {output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::ROI_POOLING, "float32", dims);
+    operationCase.type = OperationType::ROI_POOLING;
+    operationCase.model = builder.build();
+    operationCase.inputValues = {Tensor(), boxes};
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y(getElementCount(out.getDims(boxCount)));
+        for (uint32_t r = 0; r < boxCount; r++) {
+            // The corners are included in the box
+            const uint32_t x0 = boxes[r * 4], y0 = boxes[r * 4 + 1];
+            const uint32_t binWidth = (uint32_t(boxes[r * 4 + 2]) - x0 + 1) / bins;
+            const uint32_t binHeight = (uint32_t(boxes[r * 4 + 3]) - y0 + 1) / bins;
+            for (uint32_t by = 0; by < bins; by++)
+                for (uint32_t bx = 0; bx < bins; bx++)
+                    for (uint32_t c = 0; c < in.channels; c++) {
+                        float value = -INFINITY;
+                        for (uint32_t h = 0; h < binHeight; h++)
+                            for (uint32_t w = 0; w < binWidth; w++)
+                                value = std::max(value,
+                                                 inputs[0][in.at(0, y0 + by * binHeight + h,
+                                                                 x0 + bx * binWidth + w, c)]);
+                        y[out.at(r, by, bx, c)] = value;
+                    }
+        }
+        return std::vector<Tensor>{y};
+    };
+    return operationCase;
+}
+
+float sigmoid(float value) { return 1.f / (1.f + std::exp(-value)); }
+
+uint32_t addRandomWeights(ModelBuilder& builder, const Dims& dims, Tensor& values) {
+    values = randomValues(getElementCount(dims), -0.1f, 0.1f);
+    return addFloatTensor(builder, dims, values);
+}
+
+// weights * input + recurrentWeights * state + bias, of one batch entry
+Tensor getGateValues(const Tensor& weights, const Tensor& recurrentWeights, const Tensor& bias,
+                     const float* input, const float* state) {
+    const size_t units = bias.size(), inputSize = weights.size() / units;
+    const size_t stateSize = recurrentWeights.size() / units;
+    Tensor values(bias);
+    for (size_t u = 0; u < units; u++) {
+        for (size_t i = 0; i < inputSize; i++) values[u] += weights[u * inputSize + i] * input[i];
+        for (size_t i = 0; i < stateSize; i++)
+            values[u] += recurrentWeights[u * stateSize + i] * state[i];
+    }
+    return values;
+}
+
+// RNN step with a RELU activation. Both the output and hidden_state_out are checked.
+OperationCase createRnnCase(uint32_t batch, uint32_t inputSize, uint32_t units) {
+    ModelBuilder builder;
+    Tensor weights, recurrentWeights, bias;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, {batch, inputSize});
+    std::vector<uint32_t> inputs = {input,
+                                    addRandomWeights(builder, {units, inputSize}, weights),
+                                    addRandomWeights(builder, {units, units}, recurrentWeights),
+                                    addRandomWeights(builder, {units}, bias),
+                                    builder.addInput(OperandType::TENSOR_FLOAT32, {batch, units}),
+                                    builder.addInt32(kActivationRelu)};
+    auto hiddenState = builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, units});
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, units});
+    builder.addOperation(OperationType::RNN, inputs, {hiddenState, output});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::RNN, "float32", {batch, inputSize},
+                                     std::to_string(units));
+    operationCase.type = OperationType::RNN;
+    operationCase.model = builder.build();
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y;
+        for (uint32_t b = 0; b < batch; b++) {
+            auto values = getGateValues(weights, recurrentWeights, bias,
+                                        &inputs[0][size_t(b) * inputSize],
+                                        &inputs[1][size_t(b) * units]);
+            std::transform(values.begin(), values.end(), std::back_inserter(y), relu);
+        }
+        return std::vector<Tensor>{y, y};
+    };
+    operationCase.tolerance = 1e-3f;
+    return operationCase;
+}
+
+// UNIDIRECTIONAL_SEQUENCE_RNN of batch major inputs with a RELU activation, also checking
+// hidden_state_out
+OperationCase createSequenceRnnCase(uint32_t batch, uint32_t maxTime, uint32_t inputSize,
+                                    uint32_t units) {
+    ModelBuilder builder;
+    Tensor weights, recurrentWeights, bias;
+    auto input = builder.addInput(OperandType::TENSOR_FLOAT32, {batch, maxTime, inputSize});
+    std::vector<uint32_t> inputs = {input,
+                                    addRandomWeights(builder, {units, inputSize}, weights),
+                                    addRandomWeights(builder, {units, units}, recurrentWeights),
+                                    addRandomWeights(builder, {units}, bias),
+                                    builder.addInput(OperandType::TENSOR_FLOAT32, {batch, units}),
+                                    builder.addInt32(kActivationRelu),
+                                    builder.addInt32(0)};
+    auto output = builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, maxTime, units});
+    auto hiddenState = builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, units});
+    builder.addOperation(OperationType::UNIDIRECTIONAL_SEQUENCE_RNN, inputs,
+                         {output, hiddenState});
+
+    OperationCase operationCase;
+    operationCase.name = getCaseName(OperationType::UNIDIRECTIONAL_SEQUENCE_RNN, "float32",
+                                     {batch, maxTime, inputSize}, std::to_string(units));
+    operationCase.type = OperationType::UNIDIRECTIONAL_SEQUENCE_RNN;
+    operationCase.model = builder.build();
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor y, hidden;
+        for (uint32_t b = 0; b < batch; b++) {
+            const auto initialState = inputs[1].begin() + size_t(b) * units;
+            Tensor state(initialState, initialState + units);
+            for (uint32_t t = 0; t < maxTime; t++) {
+                state = getGateValues(weights, recurrentWeights, bias,
+                                      &inputs[0][(size_t(b) * maxTime + t) * inputSize],
+                                      state.data());
+                std::transform(state.begin(), state.end(), state.begin(), relu);
+                y.insert(y.end(), state.begin(), state.end());
+            }
+            hidden.insert(hidden.end(), state.begin(), state.end());
+        }
+        return std::vector<Tensor>{y, hidden};
+    };
+    operationCase.tolerance = 1e-3f;
+    return operationCase;
+}
+
+// LSTM step without CIFG, peephole or clipping, with a tanh activation, projected to
+// projectionSize outputs without a bias when projectionSize is not 0. The scratch buffer is not
+// checked, NNAPI leaving its content unspecified.
+OperationCase createLstmCase(uint32_t batch, uint32_t inputSize, uint32_t units,
+                             uint32_t projectionSize = 0) {
+    const uint32_t outputSize = projectionSize ? projectionSize : units;
+    ModelBuilder builder;
+    // The input, forget, cell and output gates, in the order of the operation inputs
+    std::vector<Tensor> weights(4), recurrentWeights(4), biases(4);
+    Tensor projectionWeights;
+    std::vector<uint32_t> inputs = {builder.addInput(OperandType::TENSOR_FLOAT32,
+                                                     {batch, inputSize})};
+    for (auto& values : weights)
+        inputs.push_back(addRandomWeights(builder, {units, inputSize}, values));
+    for (auto& values : recurrentWeights)
+        inputs.push_back(addRandomWeights(builder, {units, outputSize}, values));
+    for (int i = 0; i < 3; i++) inputs.push_back(builder.addNoValue(OperandType::TENSOR_FLOAT32));
+    for (auto& values : biases) inputs.push_back(addRandomWeights(builder, {units}, values));
+    inputs.push_back(projectionSize
+                         ? addRandomWeights(builder, {outputSize, units}, projectionWeights)
+                         : builder.addNoValue(OperandType::TENSOR_FLOAT32));
+    inputs.push_back(builder.addNoValue(OperandType::TENSOR_FLOAT32));
+    inputs.push_back(builder.addInput(OperandType::TENSOR_FLOAT32, {batch, outputSize}));
+    inputs.push_back(builder.addInput(OperandType::TENSOR_FLOAT32, {batch, units}));
+    inputs.push_back(builder.addInt32(kActivationTanh));
+    inputs.push_back(builder.addFloat32(0.f));
+    inputs.push_back(builder.addFloat32(0.f));
+    const std::vector<uint32_t> outputs = {
+        builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, units * 4}),
+        builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, outputSize}),
+        builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, units}),
+        builder.addOutput(OperandType::TENSOR_FLOAT32, {batch, outputSize})};
+    builder.addOperation(OperationType::LSTM, inputs, outputs);
+
+    OperationCase operationCase;
+    operationCase.name =
+        getCaseName(OperationType::LSTM, "float32", {batch, inputSize},
+                    std::to_string(units) + (projectionSize ? "x" + std::to_string(projectionSize)
+                                                            : ""));
+    operationCase.type = OperationType::LSTM;
+    operationCase.model = builder.build();
+    operationCase.reference = [=](const std::vector<Tensor>& inputs) {
+        Tensor outputState, cellState;
+        for (uint32_t b = 0; b < batch; b++) {
+            std::vector<Tensor> gates;
+            for (size_t g = 0; g < weights.size(); g++)
+                gates.push_back(getGateValues(weights[g], recurrentWeights[g], biases[g],
+                                              &inputs[0][size_t(b) * inputSize],
+                                              &inputs[1][size_t(b) * outputSize]));
+            Tensor output;
+            for (uint32_t u = 0; u < units; u++) {
+                const float cell = sigmoid(gates[1][u]) * inputs[2][size_t(b) * units + u] +
+                                   sigmoid(gates[0][u]) * std::tanh(gates[2][u]);
+                cellState.push_back(cell);
+                output.push_back(sigmoid(gates[3][u]) * std::tanh(cell));
+            }
+            for (uint32_t p = 0; projectionSize && p < outputSize; p++) {
+                float value = 0;
+                for (uint32_t u = 0; u < units; u++)
+                    value += projectionWeights[size_t(p) * units + u] * output[u];
+                outputState.push_back(value);
+            }
+            if (!projectionSize)
+                outputState.insert(outputState.end(), output.begin(), output.end());
+        }
+        return std::vector<Tensor>{Tensor(), outputState, cellState, outputState};
+    };
+    operationCase.tolerance = 1e-3f;
+    return operationCase;
+}
+
+struct UnaryOperation {
+    OperationType type;
+    float (*function)(float);
+    float inputMin, inputMax;
+};
+
+const std::vector<UnaryOperation>& getUnaryOperations() {
+    static const std::vector<UnaryOperation> operations = {
+        {OperationType::RELU, [](float x) { return relu(x); }, -1.f, 1.f},
+        {OperationType::RELU1, [](float x) { return std::min(std::max(x, -1.f), 1.f); }, -2.f,
+         2.f},
+        {OperationType::RELU6, [](float x) { return std::min(std::max(x, 0.f), 6.f); }, -2.f,
+         8.f},
+        {OperationType::LOGISTIC, [](float x) { return 1.f / (1.f + std::exp(-x)); }, -4.f, 4.f},
+        {OperationType::TANH, [](float x) { return std::tanh(x); }, -4.f, 4.f},
+        {OperationType::ABS, [](float x) { return std::abs(x); }, -1.f, 1.f},
+        {OperationType::EXP, [](float x) { return std::exp(x); }, -2.f, 2.f},
+        {OperationType::LOG, [](float x) { return std::log(x); }, 0.1f, 4.f},
+        {OperationType::NEG, [](float x) { return -x; }, -1.f, 1.f},
+        {OperationType::SQRT, [](float x) { return std::sqrt(x); }, 0.f, 4.f},
+        {OperationType::RSQRT, [](float x) { return 1.f / std::sqrt(x); }, 0.1f, 4.f},
+        {OperationType::SIN, [](float x) { return std::sin(x); }, -3.f, 3.f},
+        {OperationType::FLOOR, [](float x) { return std::floor(x); }, -4.f, 4.f},
+        {OperationType::HARD_SWISH,
+         [](float x) { return x * std::min(std::max(x + 3.f, 0.f), 6.f) / 6.f; }, -4.f, 4.f},
+    };
+    return operations;
+}
+}  // namespace
+
+// The supported operations without a case, as the runner only fills and checks float32 and quant8
+// tensors or the builder only builds a single graph:
+// - EQUAL, GREATER, GREATER_EQUAL, LESS, LESS_EQUAL, NOT_EQUAL, LOGICAL_AND, LOGICAL_NOT,
+//   LOGICAL_OR, REDUCE_ALL, REDUCE_ANY and SELECT take or produce TENSOR_BOOL8
+// - ARGMAX, ARGMIN and CAST produce or take integer tensors
+// - IF and WHILE reference subgraphs, which ModelBuilder does not build
+// - BIDIRECTIONAL_SEQUENCE_RNN is lowered as two UNIDIRECTIONAL_SEQUENCE_RNN recurrences and
+//   EMBEDDING_LOOKUP as the Gather of GATHER
+// - BATCH_TO_SPACE_ND, SPACE_TO_BATCH_ND, DEPTH_TO_SPACE, SPACE_TO_DEPTH, CHANNEL_SHUFFLE,
+//   EXPAND_DIMS, SQUEEZE, STRIDED_SLICE and PAD_V2 only move data, as TRANSPOSE, RESHAPE and PAD
+// - GROUPED_CONV_2D, TRANSPOSE_CONV_2D, L2_POOL_2D and INSTANCE_NORMALIZATION have no reference
+//   written yet
+std::vector<OperationCase> getOperationCases() {
+    std::vector<OperationCase> cases;
+    const std::vector<Dims> shapes = {{1, 8, 8, 16}, {1, 56, 56, 64}};
+    for (const auto& dims : shapes) {
+        const Dims channels = {dims.back()};
+        cases.push_back(createBinaryCase(OperationType::ADD, dims, dims, kActivationNone,
+                                         std::plus<float>()));
+        cases.push_back(createBinaryCase(OperationType::ADD, dims, channels, kActivationRelu,
+                                         std::plus<float>()));
+        cases.push_back(createBinaryCase(OperationType::SUB, dims, dims, kActivationNone,
+                                         std::minus<float>()));
+        cases.push_back(createBinaryCase(OperationType::MUL, dims, dims, kActivationNone,
+                                         std::multiplies<float>()));
+        cases.push_back(createBinaryCase(OperationType::MUL, dims, channels, kActivationRelu,
+                                         std::multiplies<float>()));
+        cases.push_back(createBinaryCase(OperationType::DIV, dims, dims, kActivationNone,
+                                         std::divides<float>(), 0.5f, 2.f));
+        cases.push_back(createBinaryCase(OperationType::MAXIMUM, dims, dims, -1,
+                                         [](float a, float b) { return std::max(a, b); }));
+        cases.push_back(createBinaryCase(OperationType::MINIMUM, dims, dims, -1,
+                                         [](float a, float b) { return std::min(a, b); }));
+        cases.push_back(createBinaryCase(
+            OperationType::POW, dims, dims, -1, [](float a, float b) { return std::pow(a, b); },
+            0.5f, 2.f));
+        cases.push_back(createBinaryCase(
+            OperationType::PRELU, dims, channels, -1,
+            [](float x, float alpha) { return x < 0 ? alpha * x : x; }));
+        cases.push_back(createQuant8AddCase(dims));
+
+        for (const auto& unary : getUnaryOperations())
+            cases.push_back(createUnaryCase(unary.type, dims, unary.function, unary.inputMin,
+                                            unary.inputMax));
+
+        for (bool nchw : {false, true}) {
+            cases.push_back(createConvCase(false, dims, dims.back(), 3, 1, nchw, false));
+            cases.push_back(createConvCase(true, dims, dims.back(), 3, 1, nchw, false));
+            cases.push_back(createPoolCase(OperationType::MAX_POOL_2D, dims, 3, 2, nchw));
+            cases.push_back(createPoolCase(OperationType::AVERAGE_POOL_2D, dims, 2, 2, nchw));
+        }
+        cases.push_back(createConvCase(false, dims, dims.back(), 3, 1, false, true));
+        cases.push_back(createConvCase(true, dims, dims.back(), 3, 1, false, true));
+
+        for (auto type :
+             {OperationType::MEAN, OperationType::REDUCE_SUM, OperationType::REDUCE_PROD,
+              OperationType::REDUCE_MAX, OperationType::REDUCE_MIN})
+            cases.push_back(createReduceCase(type, dims));
+        for (auto type : {OperationType::SOFTMAX, OperationType::LOG_SOFTMAX,
+                          OperationType::L2_NORMALIZATION})
+            cases.push_back(createNormalizationCase(type, dims));
+        cases.push_back(createConcatenationCase(dims));
+        cases.push_back(createTransposeCase(dims));
+        cases.push_back(createReshapeCase(dims));
+        cases.push_back(createQuantizeCase(OperationType::QUANTIZE, dims));
+        cases.push_back(createQuantizeCase(OperationType::DEQUANTIZE, dims));
+        cases.push_back(createResizeCase(OperationType::RESIZE_BILINEAR, dims));
+        cases.push_back(createResizeCase(OperationType::RESIZE_NEAREST_NEIGHBOR, dims));
+        cases.push_back(createGatherCase(dims));
+        cases.push_back(createPadCase(dims));
+        cases.push_back(createSplitCase(dims));
+        cases.push_back(createRoiAlignCase(dims));
+        cases.push_back(createRoiPoolingCase(dims));
+    }
+
+    cases.push_back(createNormalizationCase(OperationType::SOFTMAX, {1, 1000}));
+    for (bool quantized : {false, true}) {
+        cases.push_back(createFullyConnectedCase(1, 1024, 256, quantized));
+        cases.push_back(createFullyConnectedCase(8, 256, 128, quantized));
+    }
+    cases.push_back(createTopkCase(1, 1000, 5));
+    cases.push_back(createTopkCase(8, 256, 4));
+    cases.push_back(createRnnCase(1, 256, 128));
+    cases.push_back(createSequenceRnnCase(2, 16, 64, 64));
+    // Sequence length sweep: the recurrence is a TensorIterator over a single step, so the node
+    // count and the generateGraph and prepare times are expected to stay flat as maxTime grows
+    for (uint32_t maxTime : {4, 64, 256, 1024})
+        cases.push_back(createSequenceRnnCase(1, maxTime, 64, 64));
+    cases.push_back(createLstmCase(1, 256, 128));
+    cases.push_back(createLstmCase(4, 64, 64));
+    // Projections the fused cell takes and the one that keeps the decomposed graph
+    cases.push_back(createLstmCase(1, 256, 128, 96));
+    cases.push_back(createLstmCase(1, 256, 128, 32));
+    return cases;
+}
+
+OperationResult runOperationCase(const sp<V1_3::IDevice>& device, IntelDeviceType deviceType,
+                                 const OperationCase& operationCase, size_t iterations,
+                                 size_t warmup, V1_1::ExecutionPreference preference) {
+    OperationResult result;
+    result.name = operationCase.name;
+    result.quantized = operationCase.quantized;
+    result.lowPrecision = operationCase.quantized && getDriverConfig().lowPrecision;
+    const auto& model = operationCase.model;
+
+    device->getSupportedOperations_1_3(
+        model, [&](V1_3::ErrorStatus status, const hidl_vec<bool>& supported) {
+            result.supported = status == V1_3::ErrorStatus::NONE && supported.size() == 1 &&
+                               supported[0];
+        });
+    if (!result.supported) return result;
+
+    // The graph builder alone, as the prepared models run it
+    auto modelInfo = std::make_shared<NnapiModelInfo>(model);
+    if (!modelInfo->initRuntimeInfo()) {
+        result.error = "initRuntimeInfo failed";
+        return result;
+    }
+    auto start = Clock::now();
+    NgraphNetworkCreator creator(modelInfo, deviceType, result.lowPrecision);
+    const bool valid = creator.validateOperations();
+    result.validateMs = elapsedMs(start);
+    if (!valid) {
+        result.error = "validateOperations failed";
+        return result;
+    }
+    start = Clock::now();
+    auto function = creator.generateGraph();
+    result.createNodeMs = elapsedMs(start);
+    if (function == nullptr) {
+        result.error = "generateGraph failed";
+        return result;
+    }
+    result.nodes = function->get_ops().size();
+
+    ModelRunner runner;
+    result.error = runner.prepare(device, model, preference, result.prepareMs);
+    if (!result.error.empty()) return result;
+
+    std::vector<Tensor> inputs;
+    for (size_t i = 0; i < model.main.inputIndexes.size(); i++) {
+        const auto& operand = model.main.operands[model.main.inputIndexes[i]];
+        const size_t length = getOperandByteSize(operand);
+        if (operand.type == OperandType::TENSOR_QUANT8_ASYMM) {
+            const auto values = randomQuant8Values(length);
+            std::memcpy(runner.getInput(i), values.data(), length);
+            inputs.push_back(dequantize(values.data(), length, operand.scale, operand.zeroPoint));
+            continue;
+        }
+        if (operand.type != OperandType::TENSOR_FLOAT32) {
+            for (size_t j = 0; j < length; j++) runner.getInput(i)[j] = (j * 31) & 0x3f;
+            continue;
+        }
+        if (i < operationCase.inputValues.size() && !operationCase.inputValues[i].empty()) {
+            inputs.push_back(operationCase.inputValues[i]);
+        } else {
+            inputs.push_back(randomValues(length / sizeof(float), operationCase.inputMin,
+                                          operationCase.inputMax));
+        }
+        std::memcpy(runner.getInput(i), inputs.back().data(), length);
+    }
+
+    double deviceMs = 0;
+    if (!runner.execute(deviceMs)) {
+        result.error = "execution failed";
+        return result;
+    }
+    if (operationCase.reference) {
+        const auto expected = operationCase.reference(inputs);
+        for (size_t i = 0; i < expected.size(); i++) {
+            // Outputs without a reference, such as the TOPK_V2 indices, are not checked
+            if (expected[i].empty()) continue;
+            const auto& operand = model.main.operands[model.main.outputIndexes[i]];
+            const bool quantized = operand.type == OperandType::TENSOR_QUANT8_ASYMM;
+            const auto* output = reinterpret_cast<const float*>(runner.getOutput(i));
+            const auto* quantizedOutput = runner.getOutput(i);
+            for (size_t j = 0; j < expected[i].size(); j++) {
+                float error;
+                if (quantized) {
+                    // In quantization steps from the rounded reference
+                    const float step = std::min(
+                        std::max(std::round(expected[i][j] / operand.scale) + operand.zeroPoint,
+                                 0.f),
+                        255.f);
+                    error = std::abs(quantizedOutput[j] - step);
+                } else {
+                    error = std::abs(output[j] - expected[i][j]) /
+                            std::max(1.f, std::abs(expected[i][j]));
+                }
+                // A NaN output never compares greater than the tolerance
+                result.maxError = std::isnan(error) ? INFINITY : std::max(result.maxError, error);
+            }
+        }
+        result.checked = true;
+        if (result.maxError > operationCase.tolerance) {
+            result.error = "output mismatch against the reference";
+            return result;
+        }
+    }
+
+    for (size_t i = 0; i < warmup; i++) runner.execute(deviceMs);
+    result.latenciesMs.reserve(iterations);
+    for (size_t i = 0; i < iterations; i++) {
+        start = Clock::now();
+        if (!runner.execute(deviceMs)) {
+            result.error = "execution failed";
+            return result;
+        }
+        result.latenciesMs.push_back(elapsedMs(start));
+    }
+    return result;
+}
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
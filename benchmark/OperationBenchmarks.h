@@ -0,0 +1,75 @@
+#ifndef ANDROID_ML_NN_OPERATIONBENCHMARKS_H
+#define ANDROID_ML_NN_OPERATIONBENCHMARKS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Driver.h"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+namespace benchmark {
+
+// A model holding a single operation and the reference its outputs are checked against
+struct OperationCase {
+    // <OPERATION>.<type>.<shape>[.<variant>], e.g. CONV_2D.float32.1x56x56x64.nchw
+    std::string name;
+    OperationType type;
+    Model model;
+    // 8 bit quantized inputs and outputs, run both dequantized to float32 and as FakeQuantize
+    bool quantized = false;
+    // Computes the model outputs from its inputs, the real values of quantized ones. Empty for
+    // the cases that are only timed, and an empty output is not checked.
+    std::function<std::vector<std::vector<float>>(const std::vector<std::vector<float>>&)>
+        reference;
+    // Largest error allowed against the reference. Relative above 1 and absolute below for float
+    // outputs, in quantization steps for quantized ones.
+    float tolerance = 1e-4f;
+    // Range of the random float inputs
+    float inputMin = -1.f, inputMax = 1.f;
+    // Values of float inputs by input position, such as the boxes of the ROI operations. The
+    // inputs without values are random.
+    std::vector<std::vector<float>> inputValues;
+};
+
+struct OperationResult {
+    std::string name;
+    std::string error;
+    bool supported = false;
+    // Quantized cases only, whether they ran as FakeQuantize rather than float32 graphs
+    bool quantized = false;
+    bool lowPrecision = false;
+    // NgraphNetworkCreator construction and validateOperations, then generateGraph
+    double validateMs = 0, createNodeMs = 0;
+    size_t nodes = 0;
+    double prepareMs = 0;
+    bool checked = false;
+    float maxError = 0;
+    std::vector<double> latenciesMs;
+};
+
+// The float32 cases across two shapes, NHWC and NCHW layouts for the convolutions and pools and
+// broadcast binary operations, plus 8 bit quantized variants of the common operations and the
+// recurrent, TOPK_V2 and fully connected cases of their own shapes, with a sequence length sweep
+// of the sequence RNN. The supported operations without a case are listed with the reason in
+// OperationBenchmarks.cpp.
+std::vector<OperationCase> getOperationCases();
+
+// Times the graph builder on the host, then prepares the case on the device, checks it against
+// its reference and measures the single operation inference latency. A mismatch sets the error
+// and skips the timing. Quantized cases are lowered as the low_precision setting of
+// getDriverConfig() selects.
+OperationResult runOperationCase(const sp<V1_3::IDevice>& device, IntelDeviceType deviceType,
+                                 const OperationCase& operationCase, size_t iterations,
+                                 size_t warmup, V1_1::ExecutionPreference preference);
+
+}  // namespace benchmark
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_ML_NN_OPERATIONBENCHMARKS_H
@@ -0,0 +1,449 @@
+// Host benchmark driving the Intel NN HAL in-process, through the non-Android
+// V1_0::IDevice::getService of service.cpp. For each workload it measures getSupportedOperations,
+// model preparation, the first inference and the steady state latency distribution and
+// throughput of executeSynchronously_1_3, and writes the results as JSON.
+//
+// With --operations it runs the single operation cases of OperationBenchmarks.cpp instead,
+// timing validateOperations and generateGraph on the host, checking the cases against a
+// reference implementation and measuring the single operation inference latency. Quantized cases
+// run both dequantized to float32 and as FakeQuantize graphs, to compare the two lowerings.
+//
+// With --concurrency it runs each workload with 1, 2, 4 ... --clients concurrent clients sharing
+// --models prepared models, for the sync, async and burst execution paths, and reports the
+// throughput, the latency percentiles, the CPU usage and where the throughput stops scaling.
+//
+// --preference all runs each workload once per ExecutionPreference, to compare the profiles.
+//
+//   nnhal_benchmark [--device CPU|GNA] [--workload NAME]... [--iterations N] [--warmup N]
+//                   [--preference latency|throughput|low-power|all] [--output FILE] [--list]
+//   nnhal_benchmark --operations [--operation NAME]... [--device CPU|GNA] [--iterations N] ...
+//   nnhal_benchmark --concurrency [--clients N] [--models N] [--mode sync|async|burst]...
+//                   [--workload NAME]... [--device CPU|GNA] [--iterations N] ...
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#include "BenchmarkModels.h"
+#include "BenchmarkRunner.h"
+#include "ConcurrencyBenchmark.h"
+#include "DriverConfig.h"
+#include "IENetwork.h"
+#include "MemoryProfile.h"
+#include "OperationBenchmarks.h"
+
+using namespace android::hardware::neuralnetworks::nnhal;
+using namespace android::hardware::neuralnetworks::nnhal::benchmark;
+using android::sp;
+using android::hardware::hidl_vec;
+
+namespace {
+struct Options {
+    std::string device = "CPU";
+    std::vector<std::string> workloads;
+    bool operations = false;
+    // OperationType names such as CONV_2D, every operation when empty
+    std::vector<std::string> operationTypes;
+    bool concurrency = false;
+    size_t clients = 8;
+    size_t models = 1;
+    // Every mode when empty
+    std::vector<ExecutionMode> modes;
+    size_t iterations = 100;
+    size_t warmup = 10;
+    V1_1::ExecutionPreference preference = V1_1::ExecutionPreference::FAST_SINGLE_ANSWER;
+    // Workloads only, run with every preference instead
+    bool allPreferences = false;
+    std::string output;
+};
+
+const V1_1::ExecutionPreference kPreferences[] = {V1_1::ExecutionPreference::FAST_SINGLE_ANSWER,
+                                                  V1_1::ExecutionPreference::SUSTAINED_SPEED,
+                                                  V1_1::ExecutionPreference::LOW_POWER};
+
+struct Result {
+    std::string workload;
+    std::string description;
+    V1_1::ExecutionPreference preference;
+    std::string error;
+    size_t operations = 0;
+    size_t supportedOperations = 0;
+    double supportMs = 0, supportCachedMs = 0, prepareMs = 0, firstInferenceMs = 0;
+    // Process RSS over the preparation, at its peak and once the model is prepared
+    int64_t preparePeakBytes = 0, prepareRssBytes = 0;
+    std::vector<double> latenciesMs;
+    // Sum of the timeOnDevice reported by the driver over the steady state iterations
+    double deviceMs = 0;
+    double totalMs = 0;
+};
+
+Result runWorkload(const sp<V1_3::IDevice>& device, const Workload& workload,
+                   const Options& options) {
+    Result result;
+    result.workload = workload.name;
+    result.description = workload.description;
+    result.preference = options.preference;
+    result.operations = workload.model.main.operations.size();
+
+    // The second query is answered from the driver's support cache
+    auto start = Clock::now();
+    device->getSupportedOperations_1_3(
+        workload.model, [&](V1_3::ErrorStatus status, const hidl_vec<bool>& supported) {
+            if (status != V1_3::ErrorStatus::NONE) return;
+            result.supportedOperations = std::count(supported.begin(), supported.end(), true);
+        });
+    result.supportMs = elapsedMs(start);
+    start = Clock::now();
+    device->getSupportedOperations_1_3(workload.model,
+                                       [](V1_3::ErrorStatus, const hidl_vec<bool>&) {});
+    result.supportCachedMs = elapsedMs(start);
+    if (result.supportedOperations != result.operations) {
+        result.error = "not all operations are supported";
+        return result;
+    }
+
+    ModelRunner runner;
+    MemoryProfile memoryProfile;
+    // The benchmark is the only user of its process, resetting the peak RSS is harmless
+    memoryProfile.start(true);
+    result.error = runner.prepare(device, workload.model, options.preference, result.prepareMs);
+    if (!result.error.empty()) return result;
+    memoryProfile.finish();
+    result.preparePeakBytes = memoryProfile.getPeakBytes();
+    result.prepareRssBytes = memoryProfile.getSteadyRssBytes();
+    for (size_t i = 0; i < runner.getInputPoolSize(); i++) runner.getInput(0)[i] = (i * 31) & 0x3f;
+
+    double deviceMs = 0;
+    start = Clock::now();
+    if (!runner.execute(deviceMs)) {
+        result.error = "execution failed";
+        return result;
+    }
+    result.firstInferenceMs = elapsedMs(start);
+
+    for (size_t i = 0; i < options.warmup; i++) runner.execute(deviceMs);
+
+    deviceMs = 0;
+    result.latenciesMs.reserve(options.iterations);
+    auto total = Clock::now();
+    for (size_t i = 0; i < options.iterations; i++) {
+        start = Clock::now();
+        if (!runner.execute(deviceMs)) {
+            result.error = "execution failed";
+            return result;
+        }
+        result.latenciesMs.push_back(elapsedMs(start));
+    }
+    result.totalMs = elapsedMs(total);
+    result.deviceMs = deviceMs;
+    return result;
+}
+
+std::string toJson(const Options& options, const std::vector<Result>& results) {
+    std::ostringstream json;
+    json.precision(4);
+    json << std::fixed;
+    json << "{\n  \"device\": \"" << options.device << "\",\n  \"preference\": \""
+         << (options.allPreferences ? "all" : getExecutionProfileName(options.preference))
+         << "\",\n  \"iterations\": " << options.iterations
+         << ",\n  \"warmup\": " << options.warmup << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        const size_t count = r.latenciesMs.size();
+        json << "    {\"workload\": \"" << r.workload << "\", \"description\": \""
+             << r.description << "\", \"preference\": \""
+             << getExecutionProfileName(r.preference) << "\", \"operations\": " << r.operations
+             << ", \"supported_operations\": " << r.supportedOperations
+             << ", \"status\": \"" << (r.error.empty() ? "ok" : r.error) << "\""
+             << ", \"supported_operations_ms\": " << r.supportMs
+             << ", \"supported_operations_cached_ms\": " << r.supportCachedMs
+             << ", \"prepare_ms\": " << r.prepareMs
+             << ", \"prepare_peak_mb\": " << r.preparePeakBytes / (1024.0 * 1024.0)
+             << ", \"prepare_rss_mb\": " << r.prepareRssBytes / (1024.0 * 1024.0)
+             << ", \"first_inference_ms\": " << r.firstInferenceMs;
+        if (count > 0) {
+            json << ", \"latency_ms\": {\"min\": " << percentile(r.latenciesMs, 0)
+                 << ", \"p50\": " << percentile(r.latenciesMs, 0.5)
+                 << ", \"p90\": " << percentile(r.latenciesMs, 0.9)
+                 << ", \"p99\": " << percentile(r.latenciesMs, 0.99)
+                 << ", \"max\": " << percentile(r.latenciesMs, 1)
+                 << ", \"mean\": " << r.totalMs / count << "}"
+                 << ", \"device_mean_ms\": " << r.deviceMs / count
+                 << ", \"throughput_ips\": " << count * 1000.0 / r.totalMs;
+        }
+        json << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+std::string toJson(const Options& options, const std::vector<OperationResult>& results) {
+    std::ostringstream json;
+    json.precision(4);
+    json << std::fixed;
+    json << "{\n  \"device\": \"" << options.device << "\",\n  \"preference\": \""
+         << getExecutionProfileName(options.preference) << "\",\n  \"iterations\": "
+         << options.iterations << ",\n  \"warmup\": " << options.warmup
+         << ",\n  \"operations\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        json << "    {\"case\": \"" << r.name << "\", \"status\": \""
+             << (!r.supported ? "unsupported" : r.error.empty() ? "ok" : r.error) << "\"";
+        if (r.quantized) {
+            json << ", \"lowering\": \"" << (r.lowPrecision ? "fake_quantize" : "float32")
+                 << "\"";
+        }
+        if (r.supported) {
+            json << ", \"validate_ms\": " << r.validateMs << ", \"create_node_ms\": "
+                 << r.createNodeMs << ", \"nodes\": " << r.nodes
+                 << ", \"prepare_ms\": " << r.prepareMs;
+        }
+        if (r.checked) json << ", \"max_error\": " << r.maxError;
+        if (!r.latenciesMs.empty()) {
+            json << ", \"latency_ms\": {\"min\": " << percentile(r.latenciesMs, 0)
+                 << ", \"p50\": " << percentile(r.latenciesMs, 0.5)
+                 << ", \"p90\": " << percentile(r.latenciesMs, 0.9)
+                 << ", \"max\": " << percentile(r.latenciesMs, 1) << "}";
+        }
+        json << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+std::string toJson(const Options& options, const std::vector<ConcurrencyResult>& results) {
+    std::ostringstream json;
+    json.precision(4);
+    json << std::fixed;
+    json << "{\n  \"device\": \"" << options.device << "\",\n  \"preference\": \""
+         << getExecutionProfileName(options.preference) << "\",\n  \"iterations\": "
+         << options.iterations << ",\n  \"warmup\": " << options.warmup
+         << ",\n  \"cores\": " << std::thread::hardware_concurrency()
+         << ",\n  \"concurrency\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        const size_t count = r.latenciesMs.size();
+        json << "    {\"workload\": \"" << r.workload << "\", \"mode\": \""
+             << getExecutionModeName(r.mode) << "\", \"models\": " << r.models
+             << ", \"clients\": " << r.clients << ", \"status\": \""
+             << (r.error.empty() ? "ok" : r.error) << "\", \"failures\": " << r.failures
+             << ", \"mismatches\": " << r.mismatches;
+        if (count > 0) {
+            json << ", \"throughput_ips\": " << count * 1000.0 / r.totalMs
+                 << ", \"speedup\": " << r.speedup
+                 << ", \"latency_ms\": {\"p50\": " << percentile(r.latenciesMs, 0.5)
+                 << ", \"p99\": " << percentile(r.latenciesMs, 0.99) << "}"
+                 << ", \"cpu_cores\": " << r.cpuCores << ", \"cpu_utilization\": "
+                 << r.cpuCores / std::max(1u, std::thread::hardware_concurrency())
+                 << ", \"scaling_stopped\": " << (r.scalingStopped ? "true" : "false");
+        }
+        json << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+// Rejects malformed and out of range counts instead of throwing
+bool parseCount(const std::string& value, size_t min, size_t& count) {
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) return false;
+    errno = 0;
+    const unsigned long long parsed = std::strtoull(value.c_str(), nullptr, 10);
+    if (errno == ERANGE || parsed > std::numeric_limits<size_t>::max() || parsed < min)
+        return false;
+    count = static_cast<size_t>(parsed);
+    return true;
+}
+
+bool parseExecutionMode(const std::string& name, std::vector<ExecutionMode>& modes) {
+    for (auto mode : {ExecutionMode::SYNC, ExecutionMode::ASYNC, ExecutionMode::BURST}) {
+        if (name == getExecutionModeName(mode)) {
+            modes.push_back(mode);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parsePreference(const std::string& name, V1_1::ExecutionPreference& preference) {
+    for (auto candidate : kPreferences) {
+        if (name == getExecutionProfileName(candidate)) {
+            preference = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void usage(const char* program) {
+    std::cerr << "usage: " << program
+              << " [--device CPU|GNA] [--workload NAME]... [--iterations N] [--warmup N]\n"
+                 "       [--preference latency|throughput|low-power|all] [--output FILE]\n"
+                 "       [--list]\n"
+              << "       " << program
+              << " --operations [--operation NAME]... [--device CPU|GNA] [--iterations N]\n"
+                 "       [--warmup N] [--preference latency|throughput|low-power]\n"
+                 "       [--output FILE]\n"
+              << "       " << program
+              << " --concurrency [--clients N] [--models N] [--mode sync|async|burst]...\n"
+                 "       [--workload NAME]... [--device CPU|GNA] [--iterations N] [--warmup N]\n"
+                 "       [--preference latency|throughput|low-power] [--output FILE]\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    const auto workloads = getWorkloads();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--list") {
+            for (const auto& workload : workloads)
+                std::cout << workload.name << ": " << workload.description << "\n";
+            return 0;
+        }
+        if (arg == "--operations") {
+            options.operations = true;
+            continue;
+        }
+        if (arg == "--concurrency") {
+            options.concurrency = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--device") {
+            options.device = value;
+        } else if (arg == "--workload") {
+            options.workloads.push_back(value);
+        } else if (arg == "--operation") {
+            options.operationTypes.push_back(value);
+        } else if (arg == "--clients" && parseCount(value, 1, options.clients)) {
+            continue;
+        } else if (arg == "--models" && parseCount(value, 1, options.models)) {
+            continue;
+        } else if (arg == "--mode" && parseExecutionMode(value, options.modes)) {
+            continue;
+        } else if (arg == "--iterations" && parseCount(value, 1, options.iterations)) {
+            continue;
+        } else if (arg == "--warmup" && parseCount(value, 0, options.warmup)) {
+            continue;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--preference" && value == "all") {
+            options.allPreferences = true;
+        } else if (arg == "--preference" && parsePreference(value, options.preference)) {
+            continue;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    sp<V1_3::IDevice> device = V1_3::IDevice::castFrom(V1_0::IDevice::getService(options.device));
+    if (device == nullptr) {
+        std::cerr << "no NN HAL 1.3 device for " << options.device << "\n";
+        return 1;
+    }
+
+    std::string json;
+    bool failed = false;
+    if (options.operations) {
+        const auto deviceType =
+            options.device == "GNA" ? IntelDeviceType::GNA : IntelDeviceType::CPU;
+        const auto driverConfig = getDriverConfig();
+        std::vector<OperationResult> results;
+        for (const auto& operationCase : getOperationCases()) {
+            if (!options.operationTypes.empty() &&
+                std::find(options.operationTypes.begin(), options.operationTypes.end(),
+                          toString(operationCase.type)) == options.operationTypes.end())
+                continue;
+            for (bool lowPrecision : {false, true}) {
+                if (lowPrecision && !operationCase.quantized) break;
+                auto config = driverConfig;
+                config.lowPrecision = lowPrecision;
+                setDriverConfig(config);
+                std::cerr << "running " << operationCase.name
+                          << (lowPrecision ? " as FakeQuantize" : "") << "\n";
+                results.push_back(runOperationCase(device, deviceType, operationCase,
+                                                   options.iterations, options.warmup,
+                                                   options.preference));
+                if (!results.back().error.empty()) {
+                    std::cerr << operationCase.name << ": " << results.back().error << "\n";
+                    failed = true;
+                }
+            }
+            const size_t count = results.size();
+            if (operationCase.quantized && !results[count - 2].latenciesMs.empty() &&
+                !results[count - 1].latenciesMs.empty()) {
+                std::cerr << operationCase.name << ": p50 float32 "
+                          << percentile(results[count - 2].latenciesMs, 0.5)
+                          << " ms, fake_quantize "
+                          << percentile(results[count - 1].latenciesMs, 0.5) << " ms\n";
+            }
+        }
+        setDriverConfig(driverConfig);
+        json = toJson(options, results);
+    } else if (options.concurrency) {
+        ConcurrencyOptions concurrencyOptions;
+        if (!options.modes.empty()) concurrencyOptions.modes = options.modes;
+        concurrencyOptions.maxClients = options.clients;
+        concurrencyOptions.models = options.models;
+        concurrencyOptions.iterations = options.iterations;
+        concurrencyOptions.warmup = options.warmup;
+        concurrencyOptions.preference = options.preference;
+        std::vector<ConcurrencyResult> results;
+        for (const auto& workload : workloads) {
+            if (!options.workloads.empty() &&
+                std::find(options.workloads.begin(), options.workloads.end(), workload.name) ==
+                    options.workloads.end())
+                continue;
+            std::cerr << "running " << workload.name << "\n";
+            for (const auto& result : runConcurrency(device, workload, concurrencyOptions)) {
+                if (!result.error.empty()) {
+                    std::cerr << workload.name << " " << getExecutionModeName(result.mode)
+                              << " x" << result.clients << ": " << result.error << "\n";
+                    failed = true;
+                }
+                results.push_back(result);
+            }
+        }
+        json = toJson(options, results);
+    } else {
+        std::vector<Result> results;
+        for (const auto& workload : workloads) {
+            if (!options.workloads.empty() &&
+                std::find(options.workloads.begin(), options.workloads.end(), workload.name) ==
+                    options.workloads.end())
+                continue;
+            for (auto preference : kPreferences) {
+                if (!options.allPreferences && preference != options.preference) continue;
+                auto workloadOptions = options;
+                workloadOptions.preference = preference;
+                std::cerr << "running " << workload.name << " ("
+                          << getExecutionProfileName(preference) << ")\n";
+                results.push_back(runWorkload(device, workload, workloadOptions));
+                if (!results.back().error.empty()) {
+                    std::cerr << workload.name << ": " << results.back().error << "\n";
+                    failed = true;
+                }
+            }
+        }
+        json = toJson(options, results);
+    }
+
+    if (options.output.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream(options.output) << json;
+    }
+
+    return failed ? 1 : 0;
+}
@@ -4,6 +4,7 @@
 #include <log/log.h>
 #include <fstream>
 #include <thread>
+#include "DriverConfig.h"
 #include "ExecutionBurstServer.h"
 #include "ValidateHal.h"
 #include "utils.h"
@@ -20,40 +21,54 @@ namespace nnhal {
 
 void CpuPreparedModel::deinitialize() {
     ALOGV("Entering %s", __func__);
-    mModelInfo->unmapRuntimeMemPools();
-
+    // The request pools are owned by each execution's ExecutionContext and unmapped with it
     ALOGV("Exiting %s", __func__);
 }
 
 bool CpuPreparedModel::initialize() {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("initialize", mModelId);
     if (!mModelInfo->initRuntimeInfo()) {
         ALOGE("Failed to initialize Model runtime parameters!!");
         return false;
     }
-    mNgraphNetCreator = std::make_shared<NgraphNetworkCreator>(mModelInfo, mTargetDevice);
+    mMemoryProfile.mark("runtime_info");
+    mNgraphNetCreator = std::make_shared<NgraphNetworkCreator>(mModelInfo, mTargetDevice,
+                                                               getDriverConfig().lowPrecision);
 
-    if (!mNgraphNetCreator->validateOperations()) return false;
+    if (!mOperationsValidated && !mNgraphNetCreator->validateOperations()) return false;
+    mMemoryProfile.mark("validate");
+    const auto& driverConfig = getDriverConfig();
+    if (driverConfig.statefulModels) mStateful = mNgraphNetCreator->enableStatefulModel() > 0;
     ALOGI("Generating IR Graph");
     auto ngraph_function = mNgraphNetCreator->generateGraph();
     if (ngraph_function == nullptr) {
         ALOGE("%s ngraph generation failed", __func__);
         return false;
     }
+    mMemoryProfile.mark("ngraph");
+    mNgraphNetCreator->optimizeGraph(ngraph_function, driverConfig.graphPassesConfigured
+                                                          ? driverConfig.graphPasses
+                                                          : GraphOptimizer::getDefaultPasses());
+    mMemoryProfile.mark("optimize");
     try {
         cnnNetworkPtr = std::make_shared<InferenceEngine::CNNNetwork>(ngraph_function);
-#if __ANDROID__
-        cnnNetworkPtr->serialize("/data/vendor/neuralnetworks/ngraph_ir.xml",
-                                 "/data/vendor/neuralnetworks/ngraph_ir.bin");
-#else
-        cnnNetworkPtr->serialize("/tmp/ngraph_ir.xml", "/tmp/ngraph_ir.bin");
-#endif
-        mPlugin = std::make_shared<IENetwork>(cnnNetworkPtr);
+        mMemoryProfile.mark("cnn_network");
+        const auto& irDumpDir = getDriverConfig().irDumpDir;
+        cnnNetworkPtr->serialize(irDumpDir + "/ngraph_ir.xml", irDumpDir + "/ngraph_ir.bin");
+        mMemoryProfile.addFile(irDumpDir + "/ngraph_ir.xml");
+        mMemoryProfile.addFile(irDumpDir + "/ngraph_ir.bin");
+        mMemoryProfile.mark("serialize_ir");
+        mPlugin = std::make_shared<IENetwork>(cnnNetworkPtr, mTargetDevice, mPreference);
         mPlugin->loadNetwork();
+        mMemoryProfile.mark("load_network");
     } catch (const std::exception& ex) {
         ALOGE("%s Exception !!! %s", __func__, ex.what());
         return false;
     }
+    ngraph_function.reset();
+    // The CPU plugin copies the weights into its own memory at LoadNetwork
+    releaseBuildData(true);
 
     ALOGV("Exiting %s", __func__);
     return true;
@@ -6,6 +6,7 @@
 #include <log/log.h>
 #include <fstream>
 #include <thread>
+#include "DriverConfig.h"
 #include "ExecutionBurstServer.h"
 #include "ValidateHal.h"
 #include "utils.h"
@@ -19,35 +20,55 @@ namespace nnhal {
 
 void GnaPreparedModel::deinitialize() {
     ALOGV("Entering %s", __func__);
-    mModelInfo->unmapRuntimeMemPools();
-
+    // The request pools are owned by each execution's ExecutionContext and unmapped with it
     ALOGV("Exiting %s", __func__);
 }
 
 bool GnaPreparedModel::initialize() {
     ALOGV("Entering %s", __func__);
+    TraceEvent trace("initialize", mModelId);
     if (!mModelInfo->initRuntimeInfo()) {
         ALOGE("Failed to initialize Model runtime parameters!!");
         return false;
     }
+    mMemoryProfile.mark("runtime_info");
     mNgraphNetCreator = std::make_shared<NgraphNetworkCreator>(mModelInfo, mTargetDevice);
 
-    if (!mNgraphNetCreator->validateOperations()) return false;
+    if (!mOperationsValidated && !mNgraphNetCreator->validateOperations()) return false;
+    mMemoryProfile.mark("validate");
+    const auto& driverConfig = getDriverConfig();
+    // The plugin has no Select on a boolean input, so the state inputs of requests are ignored
+    if (driverConfig.statefulModels)
+        mStateful = mNgraphNetCreator->enableStatefulModel(true) > 0;
     ALOGI("Generating IR Graph");
     auto ngraph_function = mNgraphNetCreator->generateGraph();
     if (ngraph_function == nullptr) {
         ALOGE("%s ngraph generation failed", __func__);
         return false;
     }
-    auto ngraph_net = std::make_shared<InferenceEngine::CNNNetwork>(ngraph_function);
-#if __ANDROID__
-    ngraph_net->serialize("/data/vendor/neuralnetworks/ngraph_ir.xml",
-                          "/data/vendor/neuralnetworks/ngraph_ir.bin");
-#else
-    ngraph_net->serialize("/tmp/ngraph_ir.xml", "/tmp/ngraph_ir.bin");
-#endif
-    mPlugin = std::make_shared<IENetwork>(ngraph_net);
-    mPlugin->loadNetwork();
+    mMemoryProfile.mark("ngraph");
+    // The passes were only validated against the CPU plugin, GNA runs them when configured
+    if (driverConfig.graphPassesConfigured)
+        mNgraphNetCreator->optimizeGraph(ngraph_function, driverConfig.graphPasses);
+    mMemoryProfile.mark("optimize");
+    try {
+        auto ngraph_net = std::make_shared<InferenceEngine::CNNNetwork>(ngraph_function);
+        mMemoryProfile.mark("cnn_network");
+        const auto& irDumpDir = getDriverConfig().irDumpDir;
+        ngraph_net->serialize(irDumpDir + "/ngraph_ir.xml", irDumpDir + "/ngraph_ir.bin");
+        mMemoryProfile.addFile(irDumpDir + "/ngraph_ir.xml");
+        mMemoryProfile.addFile(irDumpDir + "/ngraph_ir.bin");
+        mMemoryProfile.mark("serialize_ir");
+        mPlugin = std::make_shared<IENetwork>(ngraph_net, mTargetDevice, mPreference);
+        mPlugin->loadNetwork();
+        mMemoryProfile.mark("load_network");
+    } catch (const std::exception& ex) {
+        ALOGE("%s Exception !!! %s", __func__, ex.what());
+        return false;
+    }
+    ngraph_function.reset();
+    // The layers HETERO leaves to the CPU plugin are copied, the GNA ones may alias the constants
+    releaseBuildData(false);
 
     ALOGV("Exiting %s", __func__);
     return true;
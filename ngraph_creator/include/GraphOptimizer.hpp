@@ -0,0 +1,47 @@
+#pragma once
+
+#include <log/log.h>
+#include <ngraph/ngraph.hpp>
+#include <string>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Cleans up the function generated by NgraphNetworkCreator before it is handed to the plugin.
+// Passes run in the configured order, each one logging its time and node count delta:
+//   constant_folding - evaluates nodes whose inputs are all constants
+//   convert_chains   - drops same-type Converts and lossless intermediate Converts
+//   reshape_chains   - merges chains of Reshape/Squeeze/Unsqueeze into a single Reshape
+//   nop_elimination  - removes shape ops and Transposes that don't change their input
+//   cse              - merges nodes of the same type, attributes and inputs
+class GraphOptimizer {
+private:
+    std::vector<std::string> mPasses;
+    // Dequantization of 8 bit weights is left to the plugin's low precision transformations
+    bool mKeepQuantizedWeights;
+
+    size_t foldConstants(std::shared_ptr<ngraph::Function> function);
+    size_t collapseConvertChains(std::shared_ptr<ngraph::Function> function);
+    size_t collapseReshapeChains(std::shared_ptr<ngraph::Function> function);
+    size_t eliminateNops(std::shared_ptr<ngraph::Function> function);
+    size_t eliminateCommonSubexpressions(std::shared_ptr<ngraph::Function> function);
+
+public:
+    GraphOptimizer(const std::vector<std::string>& passes, bool keepQuantizedWeights);
+
+    // Every pass, in the default order. Validated against the CPU plugin only: the low precision
+    // and quantization flows of the other plugins may depend on the Converts and constants the
+    // passes rewrite, so the driver runs none on them unless configured.
+    static const std::vector<std::string>& getDefaultPasses();
+    static bool isKnownPass(const std::string& pass);
+
+    void run(std::shared_ptr<ngraph::Function> function);
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
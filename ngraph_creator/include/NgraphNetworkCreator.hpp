@@ -1,5 +1,6 @@
 #pragma once
 
+#include <GraphOptimizer.hpp>
 #include <NgraphNodes.hpp>
 #include <OperationsFactory.hpp>
 #include <ngraph/node.hpp>
@@ -18,17 +19,49 @@ private:
     std::shared_ptr<NgraphNodes> mNgraphNodes;
     OperationsFactory mOpFactoryInstance;
     bool createInputParams();
+    bool connectOperations();
     bool initializeModel();
 
 public:
-    NgraphNetworkCreator(std::shared_ptr<NnapiModelInfo> modelInfo, IntelDeviceType deviceType);
+    // lowPrecision keeps 8 bit quantized activations as FakeQuantize outputs, see GraphMetadata
+    NgraphNetworkCreator(std::shared_ptr<NnapiModelInfo> modelInfo, IntelDeviceType deviceType,
+                         bool lowPrecision = false);
     ~NgraphNetworkCreator();
     void getSupportedOperations(std::vector<bool>& supportedOperations);
+    // Variant for support queries without NgraphNodes: each operation object is created, validated
+    // and dropped in turn. The objects keep no parsed parameters, they read them from the model
+    // in validate() and createNode(), so only the verdicts are worth keeping for prepareModel.
+    static void querySupportedOperations(std::shared_ptr<NnapiModelInfo> modelInfo,
+                                         IntelDeviceType deviceType,
+                                         std::vector<bool>& supportedOperations);
     bool validateOperations();
+    // Whether every operation of a referenced subgraph of IF or WHILE is supported
+    static bool validateSubgraph(std::shared_ptr<NnapiModelInfo> modelInfo,
+                                 IntelDeviceType deviceType);
+    // Keeps the recurrent state inputs and outputs of LSTM/RNN operations that are model inputs
+    // and outputs in plugin state variables: an omitted state input reads the state assigned by
+    // the previous execution. With internalStates, for plugins without Select on a boolean input
+    // such as GNA, the state inputs are ignored and the state is only ever read from its
+    // variable, which IIENetwork::resetState() zeroes. Must be called before generateGraph,
+    // returns the number of state variables.
+    size_t enableStatefulModel(bool internalStates = false);
 
     const std::string& getNodeName(uint32_t index);
+    // The boolean input set to whether a request passes the state input index, "" for other
+    // Operands
+    const std::string& getStateSelector(uint32_t index);
 
     std::shared_ptr<ngraph::Function> generateGraph();
+    // Builds the operations of a referenced subgraph of IF or WHILE on the given values of its
+    // inputs instead of Parameters, in the representation getInputNode returns without
+    // dequantizing. Returns the values of its outputs, empty on failure.
+    ngraph::OutputVector connectSubgraph(const ngraph::OutputVector& inputs);
+    // Drops the operation objects and the nodes once the network is loaded. The node names of
+    // the model inputs and outputs and the state variables stay available.
+    void releaseGraph();
+    // Runs the GraphOptimizer passes on a function returned by generateGraph
+    void optimizeGraph(std::shared_ptr<ngraph::Function> function,
+                       const std::vector<std::string>& passes);
 };
 
 }  // namespace nnhal
@@ -18,11 +18,31 @@ private:
     // mForcedNchw flag tracks whether a forced conversion to NCHW has been done at ngraph_creator
     // in the path to current Operand.
     std::vector<bool> mForcedNchw;
+    // mDequantizedOutput flag tracks whether a quantized Operand is held as dequantized float
+    // values (low precision mode) rather than as its integer representation.
+    std::vector<bool> mDequantizedOutput;
     std::vector<std::shared_ptr<ngraph::opset3::Parameter>> mInputParams;
-    std::vector<std::shared_ptr<ngraph::Node>> mResultNodes;
+    ngraph::ResultVector mResults;
+    // The Result of each model output Operand, which getNodeName resolves the output name from
+    std::map<size_t, std::shared_ptr<ngraph::opset3::Result>> mResultAtOperandIndex;
     // mNodeNames are only populated when requested, as only Inputs and Result NodeNames are
     // required.
     std::map<int, std::string> mNodeNames;
+    // Nodes created for constant operands, keyed by operand index and whether they were
+    // dequantized, so that an operand feeding several operations is added to the graph once.
+    std::map<std::pair<size_t, bool>, std::shared_ptr<ngraph::Node>> mConstantNodes;
+    // Variable ids of the state input and output Operands of a stateful model. The state output
+    // is also written to an Assign node, the state input reads the ReadValue of the variable
+    // unless the request passes it.
+    std::map<size_t, std::string> mStateVariables;
+    // Names of the boolean Parameters that tell whether a request passed a state input
+    std::map<size_t, std::string> mStateSelectors;
+    // The state inputs only read their variable, without a Parameter or a selector
+    bool mInternalStates = false;
+    ngraph::SinkVector mSinks;
+    // Layout propagation statistics, reported when the graph is generated
+    size_t mElidedTransposes = 0;
+    size_t mNchwOperations = 0;
 
 public:
     NgraphNodes(size_t operandsSize, size_t resultsSize);
@@ -31,9 +51,35 @@ public:
     void addInputParam(std::shared_ptr<ngraph::opset3::Parameter> inParam);
     void setOutputAtOperandIndex(size_t index, ngraph::Output<ngraph::Node> output);
     ngraph::Output<ngraph::Node> getOperationOutput(size_t index);
-    void setResultNode(size_t outputIndex, std::shared_ptr<ngraph::Node> resultNode);
+    void setDequantizedOutput(size_t index) { mDequantizedOutput[index] = true; }
+    bool isDequantizedOutput(size_t index) { return mDequantizedOutput[index]; }
+    // The NHWC output of a forced NCHW Operand is a Transpose of its NCHW value, which consumers
+    // that work in NCHW take directly instead of transposing it back.
+    void setForcedNchw(size_t index) { mForcedNchw[index] = true; }
+    bool isForcedNchw(size_t index) { return mForcedNchw[index]; }
+    void addElidedTranspose() { mElidedTransposes++; }
+    void addNchwOperation() { mNchwOperations++; }
+    std::shared_ptr<ngraph::Node> getConstantNode(size_t index, bool dequantized);
+    void setConstantNode(size_t index, bool dequantized, std::shared_ptr<ngraph::Node> node);
+    void setResultNode(size_t outputIndex, ngraph::Output<ngraph::Node> output);
 
+    // The InferRequest blob name of an input or output Operand. An output is named after the
+    // node feeding its Result, with a ".<output index>" suffix when that node has several outputs.
     const std::string& getNodeName(size_t index);
+    // Drops the nodes once the network is loaded, keeping the names of operandIndexes
+    void releaseGraph(const std::vector<uint32_t>& operandIndexes);
+    // Pairs a state input Operand with the state output Operand that feeds it back
+    void addStateVariable(size_t inputIndex, size_t outputIndex);
+    // The variable id of a state Operand, "" for other Operands
+    const std::string& getStateVariable(size_t index);
+    // Feeds a state input Operand from inputParam when the request passes it, and from the
+    // state variable when the request omits it. With internal states, the Operand always reads
+    // the state variable and inputParam is not added to the graph.
+    void addStateInput(size_t index, std::shared_ptr<ngraph::opset3::Parameter> inputParam);
+    void setInternalStates(bool internalStates) { mInternalStates = internalStates; }
+    // The boolean input selecting between a passed state input and the state variable, ""
+    // for other Operands
+    const std::string& getStateSelector(size_t index);
     void removeInputParameter(std::string name, size_t index);
 
     std::shared_ptr<ngraph::Function> generateGraph();
@@ -26,6 +26,7 @@
 #include <GreaterEqual.hpp>
 #include <GroupedConv2d.hpp>
 #include <HardSwish.hpp>
+#include <If.hpp>
 #include <InstanceNormalization.hpp>
 #include <L2Normalization.hpp>
 #include <L2Pooling2D.hpp>
@@ -81,6 +82,7 @@
 #include <Transpose.hpp>
 #include <TransposeConv2D.hpp>
 #include <UnidirectionalSequenceRNN.hpp>
+#include <While.hpp>
 
 namespace android {
 namespace hardware {
@@ -89,14 +91,16 @@ namespace nnhal {
 
 class OperationsFactory {
 private:
-    std::shared_ptr<NgraphNodes> mNgraphNodes;
+    GraphMetadata mGraphMetadata;
 
 public:
+    // lowPrecision is only honored on CPU, whose plugin runs the FakeQuantize graphs in int8
     OperationsFactory(IntelDeviceType deviceType, std::shared_ptr<NnapiModelInfo> modelInfo,
-                      std::shared_ptr<NgraphNodes> nodes);
+                      std::shared_ptr<NgraphNodes> nodes, bool lowPrecision = false);
     ~OperationsFactory();
     std::shared_ptr<OperationsBase> getOperation(int operationIndex,
                                                  const OperationType& operationType);
+    const GraphMetadata& getGraphMetadata() { return mGraphMetadata; }
 };
 
 }  // namespace nnhal
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Abs : public OperationsBase {
 public:
-    Abs(int operationIndex);
+    Abs(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Add : public OperationsBase {
 public:
-    Add(int operationIndex);
+    Add(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
     std::shared_ptr<ngraph::Node> createNodeForPlugin() override;
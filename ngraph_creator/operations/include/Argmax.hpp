@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Argmax : public OperationsBase {
 public:
-    Argmax(int operationIndex);
+    Argmax(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Argmin : public OperationsBase {
 public:
-    Argmin(int operationIndex);
+    Argmin(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ChannelShuffle : public OperationsBase {
 public:
-    ChannelShuffle(int operationIndex);
+    ChannelShuffle(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
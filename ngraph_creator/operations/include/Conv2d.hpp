@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Conv2d : public OperationsBase {
 public:
-    Conv2d(int operationIndex);
+    Conv2d(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class DepthToSpace : public OperationsBase {
 public:
-    DepthToSpace(int operationIndex);
+    DepthToSpace(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class DepthwiseConv2d : public OperationsBase {
 public:
-    DepthwiseConv2d(int operationIndex);
+    DepthwiseConv2d(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Dequantize : public OperationsBase {
 public:
-    Dequantize(int operationIndex);
+    Dequantize(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
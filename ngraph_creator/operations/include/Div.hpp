@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Div : public OperationsBase {
 public:
-    Div(int operationIndex);
+    Div(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
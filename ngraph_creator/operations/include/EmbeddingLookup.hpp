@@ -9,7 +9,7 @@ namespace nnhal {
 
 class EmbeddingLookup : public OperationsBase {
 public:
-    EmbeddingLookup(int operationIndex);
+    EmbeddingLookup(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Equal : public OperationsBase {
 public:
-    Equal(int operationIndex);
+    Equal(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
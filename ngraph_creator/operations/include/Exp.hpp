@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Exp : public OperationsBase {
 public:
-    Exp(int operationIndex);
+    Exp(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ExpandDims : public OperationsBase {
 public:
-    ExpandDims(int operationIndex);
+    ExpandDims(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class FullyConnected : public OperationsBase {
 public:
-    FullyConnected(int operationIndex);
+    FullyConnected(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class GroupedConv2d : public OperationsBase {
 public:
-    GroupedConv2d(int operationIndex);
+    GroupedConv2d(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
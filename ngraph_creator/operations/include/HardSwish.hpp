@@ -9,7 +9,7 @@ namespace nnhal {
 
 class HardSwish : public OperationsBase {
 public:
-    HardSwish(int operationIndex);
+    HardSwish(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
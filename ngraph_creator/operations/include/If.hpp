@@ -0,0 +1,28 @@
+#pragma once
+
+#include <OperationsBase.hpp>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Both branches are built on the operation inputs and the outputs are selected on the condition,
+// as opset3 has no conditional. The branches run unconditionally, which NNAPI allows as they have
+// no side effects.
+class If : public OperationsBase {
+public:
+    If(int operationIndex, const GraphMetadata& graphMetadata);
+    bool validate() override;
+    std::shared_ptr<ngraph::Node> createNode() override;
+    void connectOperationToGraph() override;
+
+private:
+    bool validateBranch(uint32_t inputIndex);
+    ngraph::OutputVector connectBranch(uint32_t inputIndex, const ngraph::OutputVector& inputs);
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
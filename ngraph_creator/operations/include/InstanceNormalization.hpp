@@ -9,7 +9,7 @@ namespace nnhal {
 
 class InstanceNormalization : public OperationsBase {
 public:
-    InstanceNormalization(int operationIndex);
+    InstanceNormalization(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class L2Pooling2D : public OperationsBase {
 public:
-    L2Pooling2D(int operationIndex);
+    L2Pooling2D(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
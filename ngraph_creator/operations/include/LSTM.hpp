@@ -9,7 +9,7 @@ namespace nnhal {
 
 class LSTM : public OperationsBase {
 public:
-    LSTM(int operationIndex);
+    LSTM(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
     void connectOperationToGraph() override;
@@ -28,10 +28,13 @@ public:
     std::shared_ptr<ngraph::Node> applyActivation(const std::shared_ptr<ngraph::Node>& arg,
                                                   int activationFn) const;
     std::shared_ptr<ngraph::Node> LayerNorm(const ngraph::Output<ngraph::Node>& input,
-                                            const std::shared_ptr<ngraph::Node>& normalizedweights,
-                                            const std::shared_ptr<ngraph::Node>& bias);
+                                            const ngraph::Output<ngraph::Node>& normalizedweights,
+                                            const ngraph::Output<ngraph::Node>& bias);
 
     bool isValidInputTensor(uint32_t inputIndex);
+    // LSTMCell activation for the NNAPI activation, false when the cell doesn't support it
+    bool getCellActivationName(int activationFn, std::string& name) const;
+    void setLstmOutputs(const ngraph::OutputVector& LstmOutputs);
 };
 
 }  // namespace nnhal
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Less : public OperationsBase {
 public:
-    Less(int operationIndex);
+    Less(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class LessEqual : public OperationsBase {
 public:
-    LessEqual(int operationIndex);
+    LessEqual(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class LogSoftmax : public OperationsBase {
 public:
-    LogSoftmax(int operationIndex);
+    LogSoftmax(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
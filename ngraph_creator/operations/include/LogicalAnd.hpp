@@ -9,7 +9,7 @@ namespace nnhal {
 
 class LogicalAnd : public OperationsBase {
 public:
-    LogicalAnd(int operationIndex);
+    LogicalAnd(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
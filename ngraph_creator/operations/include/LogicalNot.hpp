@@ -9,7 +9,7 @@ namespace nnhal {
 
 class LogicalNot : public OperationsBase {
 public:
-    LogicalNot(int operationIndex);
+    LogicalNot(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
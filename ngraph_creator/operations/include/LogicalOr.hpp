@@ -9,7 +9,7 @@ namespace nnhal {
 
 class LogicalOr : public OperationsBase {
 public:
-    LogicalOr(int operationIndex);
+    LogicalOr(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Logistic : public OperationsBase {
 public:
-    Logistic(int operationIndex);
+    Logistic(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
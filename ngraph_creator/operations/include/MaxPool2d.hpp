@@ -9,7 +9,7 @@ namespace nnhal {
 
 class MaxPool2d : public OperationsBase {
 public:
-    MaxPool2d(int operationIndex);
+    MaxPool2d(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Maximum : public OperationsBase {
 public:
-    Maximum(int operationIndex);
+    Maximum(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
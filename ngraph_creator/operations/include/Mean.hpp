@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Mean : public OperationsBase {
 public:
-    Mean(int operationIndex);
+    Mean(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Minimum : public OperationsBase {
 public:
-    Minimum(int operationIndex);
+    Minimum(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
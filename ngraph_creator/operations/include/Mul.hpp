@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Mul : public OperationsBase {
 public:
-    Mul(int operationIndex);
+    Mul(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
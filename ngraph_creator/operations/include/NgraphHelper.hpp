@@ -47,6 +47,51 @@ static inline std::shared_ptr<ngraph::Node> applyActivation(std::shared_ptr<ngra
     return activationNode;
 }
 
+// Runs h(t) = activation(inputProjection(t) + h(t-1) * recurrentWeights^T) over the time major
+// inputProjection [maxTime, batchSize, numUnits] with a TensorIterator whose body is a single
+// step, so the graph doesn't grow with the sequence length. reverse iterates from the last
+// timestep. Returns the hidden state of every timestep in time order, [maxTime, batchSize,
+// numUnits], and the hidden state after the last iteration.
+static inline std::pair<ngraph::Output<ngraph::Node>, ngraph::Output<ngraph::Node>>
+createRnnSequence(ngraph::Output<ngraph::Node> inputProjection,
+                  ngraph::Output<ngraph::Node> initialState,
+                  ngraph::Output<ngraph::Node> recurrentWeights, int32_t activationFn,
+                  bool reverse) {
+    const auto& elementType = inputProjection.get_element_type();
+    const auto& projectionShape = inputProjection.get_shape();
+
+    auto stepInput = std::make_shared<ngraph::opset3::Parameter>(
+        elementType, ngraph::Shape{1, projectionShape[1], projectionShape[2]});
+    auto previousState =
+        std::make_shared<ngraph::opset3::Parameter>(elementType, initialState.get_shape());
+    auto weights =
+        std::make_shared<ngraph::opset3::Parameter>(elementType, recurrentWeights.get_shape());
+
+    auto timeAxis = ngraph::opset3::Constant::create(ngraph::element::i64, ngraph::Shape{1}, {0});
+    auto stepProjection = std::make_shared<ngraph::opset3::Squeeze>(stepInput, timeAxis);
+    auto stateProduct =
+        std::make_shared<ngraph::opset3::MatMul>(previousState, weights, false, true);
+    auto state = applyActivation(
+        std::make_shared<ngraph::opset3::Add>(stepProjection, stateProduct), activationFn);
+    auto stepOutput = std::make_shared<ngraph::opset3::Unsqueeze>(state, timeAxis);
+
+    auto body = std::make_shared<ngraph::Function>(
+        ngraph::OutputVector{state, stepOutput},
+        ngraph::ParameterVector{stepInput, previousState, weights});
+    auto tensorIterator = std::make_shared<ngraph::opset3::TensorIterator>();
+    tensorIterator->set_body(body);
+
+    const int64_t start = reverse ? -1 : 0, stride = reverse ? -1 : 1, end = reverse ? 0 : -1;
+    tensorIterator->set_sliced_input(stepInput, inputProjection, start, stride, 1, end, 0);
+    tensorIterator->set_merged_input(previousState, initialState, state);
+    tensorIterator->set_invariant_input(weights, recurrentWeights);
+
+    auto outputs = tensorIterator->get_concatenated_slices(stepOutput, start, stride, 1, end, 0);
+    auto lastState = tensorIterator->get_iter_value(state, -1);
+    tensorIterator->validate_and_infer_types();
+    return {outputs, lastState};
+}
+
 static inline void calculateExplicitPadding(int32_t in_size, int32_t stride, int32_t filter_size,
                                             int32_t padding_implicit, int32_t* padding_head,
                                             int32_t* padding_tail) {
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class NotEqual : public OperationsBase {
 public:
-    NotEqual(int operationIndex);
+    NotEqual(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
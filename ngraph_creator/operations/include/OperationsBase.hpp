@@ -18,6 +18,17 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
+// Per-graph state shared by all the operations of one NgraphNetworkCreator. Operations keep their
+// own copy, so several models can be validated and built concurrently.
+struct GraphMetadata {
+    std::shared_ptr<NnapiModelInfo> modelInfo;
+    std::shared_ptr<NgraphNodes> nodes;
+    IntelDeviceType pluginType;
+    // Keep 8 bit quantized activations as FakeQuantize outputs, so the plugin's low precision
+    // transformations can run the quantized operations in int8.
+    bool lowPrecision;
+};
+
 class OperationsBase {
 protected:
     enum ConversionType {
@@ -40,110 +51,128 @@ protected:
     uint32_t mDefaultOutputIndex;
     uint32_t mDefaultInputIndex = 0;
     int mNnapiOperationIndex;
+    std::shared_ptr<NnapiModelInfo> mModelInfo;
+    IntelDeviceType mPluginType;
+    bool mLowPrecision;
     std::shared_ptr<ngraph::Node> transpose(ConversionType type,
                                             ngraph::Output<ngraph::Node> input);
     virtual std::shared_ptr<ngraph::Node> createNode() = 0;
-    // override createNodeForPlugin in case sPluginType specific implementation is required
+    // override createNodeForPlugin in case mPluginType specific implementation is required
     virtual std::shared_ptr<ngraph::Node> createNodeForPlugin();
-    void addResultNode(size_t index, std::shared_ptr<ngraph::Node> resultNode);
+    // Builds an elementwise operation directly on the NCHW tensors its NHWC inputs were
+    // transposed from, returning nullptr when the operation can't stay in NCHW.
+    std::shared_ptr<ngraph::Node> createNodeInNchw();
+    void addResultNode(size_t index, ngraph::Output<ngraph::Node> output);
 
     // helper functions
     bool checkOperandType(uint32_t operandIndex, const int32_t expectedOperandType,
                           const std::string& strLogInfo = "Operand");
     bool checkOutputOperandType(uint32_t index, const int32_t expectedOperandType);
     bool checkInputOperandType(uint32_t index, const int32_t expectedOperandType);
-    const vec<uint32_t> getInputOperandDimensions(uint32_t inputIndex);
+    const OperandDimensions getInputOperandDimensions(uint32_t inputIndex);
     bool isValidInputTensor(uint32_t inputIndex);
 
-    std::shared_ptr<ngraph::Node> getInputNode(uint32_t inputIndex, bool dequantize = true) {
+    // Returns the output port that produces the operand, so an output of a node with several
+    // outputs is consumed directly, or an empty Output when the operand can't be created
+    ngraph::Output<ngraph::Node> getInputNode(uint32_t inputIndex, bool dequantize = true) {
         std::shared_ptr<ngraph::Node> input;
-        auto operandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex);
-        auto operandType = sModelInfo->getOperandType(operandIndex);
-        if (sModelInfo->isOperandLifeTimeConst(operandIndex)) {
+        auto operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex);
+        auto operandType = mModelInfo->getOperandType(operandIndex);
+        const bool isConst = mModelInfo->isOperandLifeTimeConst(operandIndex);
+        dequantize = dequantize && (operandType == OperandType::TENSOR_QUANT8_ASYMM ||
+                                    operandType == OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL ||
+                                    operandType == OperandType::TENSOR_QUANT8_ASYMM_SIGNED ||
+                                    operandType == OperandType::TENSOR_QUANT8_SYMM ||
+                                    operandType == OperandType::TENSOR_QUANT16_SYMM ||
+                                    operandType == OperandType::TENSOR_QUANT16_ASYMM);
+        // Per channel dequantization depends on the rank of the consuming operation's input, so
+        // only the raw constant is shared for those operands.
+        const bool cacheDequantized =
+            dequantize && operandType != OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL;
+
+        if (isConst && (!dequantize || cacheDequantized)) {
+            input = mNgraphNodes->getConstantNode(operandIndex, dequantize);
+            if (input != nullptr) return input;
+        }
+
+        if (isConst && (input = mNgraphNodes->getConstantNode(operandIndex, false)) != nullptr) {
+            ALOGV("%s reusing constant node for operand %d", __func__, operandIndex);
+        } else if (isConst) {
             auto operandDims = getInputOperandDimensions(inputIndex);
             ngraph::element::Type elementType;
             switch (operandType) {
-                case OperandType::TENSOR_FLOAT32: {
+                case OperandType::TENSOR_FLOAT32:
                     elementType = ngraph::element::f32;
-                    auto operandValues = sModelInfo->GetConstVecOperand<float>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
-                case OperandType::TENSOR_INT32: {
+                case OperandType::TENSOR_INT32:
                     elementType = ngraph::element::i32;
-                    auto operandValues = sModelInfo->GetConstVecOperand<int>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
-                case OperandType::TENSOR_BOOL8: {
+                case OperandType::TENSOR_BOOL8:
                     elementType = ngraph::element::boolean;
-                    auto operandValues = sModelInfo->GetConstVecOperand<uint8_t>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
-                case OperandType::TENSOR_QUANT8_ASYMM: {
+                case OperandType::TENSOR_QUANT8_ASYMM:
                     elementType = ngraph::element::u8;
-                    auto operandValues = sModelInfo->GetConstVecOperand<uint8_t>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
                 case OperandType::TENSOR_QUANT8_SYMM:
                 case OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL:
-                case OperandType::TENSOR_QUANT8_ASYMM_SIGNED: {
+                case OperandType::TENSOR_QUANT8_ASYMM_SIGNED:
                     elementType = ngraph::element::i8;
-                    auto operandValues = sModelInfo->GetConstVecOperand<int8_t>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
-                case OperandType::TENSOR_FLOAT16: {
+                case OperandType::TENSOR_FLOAT16:
                     elementType = ngraph::element::f16;
-                    auto operandValues = sModelInfo->GetConstVecOperand<_Float16>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
-                case OperandType::TENSOR_QUANT16_SYMM: {
+                case OperandType::TENSOR_QUANT16_SYMM:
                     elementType = ngraph::element::i16;
-                    auto operandValues = sModelInfo->GetConstVecOperand<int16_t>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
-                case OperandType::TENSOR_QUANT16_ASYMM: {
+                case OperandType::TENSOR_QUANT16_ASYMM:
                     elementType = ngraph::element::u16;
-                    auto operandValues = sModelInfo->GetConstVecOperand<uint16_t>(operandIndex);
-                    input = createConstNode(elementType, toNgraphShape(operandDims), operandValues);
                     break;
-                }
                 default: {
                     ALOGE("Unsupported Tensor type %s inputIndex %d, operandType %d", __func__,
                           inputIndex, operandType);
-                    return nullptr;
+                    return {};
                 }
             }
-
+            input = createSharedConstNode(operandIndex, elementType,
+                                          ngraph::Shape(operandDims.begin(), operandDims.end()));
+            if (input == nullptr) return {};
+            mNgraphNodes->setConstantNode(operandIndex, false, input);
         } else {
-            input = mNgraphNodes->getOperationOutput(operandIndex).get_node_shared_ptr();
+            const auto output = mNgraphNodes->getOperationOutput(operandIndex);
+            // Low precision outputs already carry dequantized values
+            if (mNgraphNodes->isDequantizedOutput(operandIndex)) {
+                if (dequantize) return output;
+                return QuantizeNode(output, operandIndex,
+                                    operandType == OperandType::TENSOR_QUANT8_ASYMM
+                                        ? ngraph::element::u8
+                                        : ngraph::element::i8);
+            }
+            if (dequantize) return DequantizeNode(output, operandIndex, ngraph::element::f32);
+            return output;
         }
 
         if (dequantize) {
-            if (operandType == OperandType::TENSOR_QUANT8_ASYMM ||
-                operandType == OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL ||
-                operandType == OperandType::TENSOR_QUANT8_ASYMM_SIGNED ||
-                operandType == OperandType::TENSOR_QUANT8_SYMM ||
-                operandType == OperandType::TENSOR_QUANT16_SYMM ||
-                operandType == OperandType::TENSOR_QUANT16_ASYMM) {
-                input = DequantizeNode(input, operandIndex, ngraph::element::f32);
-            }
+            input = DequantizeNode(input, operandIndex, ngraph::element::f32);
+            if (isConst && cacheDequantized)
+                mNgraphNodes->setConstantNode(operandIndex, true, input);
         }
 
         return input;
     }
     // remove null input node parameter
     void removeInputNode(uint32_t inputIndex) {
-        auto operandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex);
+        auto operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex);
         auto nodeName = mNgraphNodes->getNodeName(operandIndex);
         mNgraphNodes->removeInputParameter(nodeName, operandIndex);
     }
 
+    // Creates a Constant that aliases the operand's CONSTANT_COPY / CONSTANT_REFERENCE memory
+    // instead of copying it. The Constant holds a reference on mModelInfo to keep the model
+    // values and the mapped pools alive.
+    std::shared_ptr<ngraph::Node> createSharedConstNode(uint32_t operandIndex,
+                                                        const ngraph::element::Type& elementType,
+                                                        const ngraph::Shape& shape);
+
     template <typename T>
     std::shared_ptr<ngraph::Node> createConstNode(ngraph::element::Type elementType,
                                                   ngraph::Shape shape, std::vector<T> vals) {
@@ -158,26 +187,28 @@ protected:
         return vec;
     }
 
-    std::shared_ptr<ngraph::Node> QuantizeNode(std::shared_ptr<ngraph::Node> input, size_t index,
+    std::shared_ptr<ngraph::Node> QuantizeNode(ngraph::Output<ngraph::Node> input, size_t index,
                                                ngraph::element::Type quantizeType);
-    std::shared_ptr<ngraph::Node> DequantizeNode(std::shared_ptr<ngraph::Node> input,
-                                                 uint32_t index,
+    std::shared_ptr<ngraph::Node> DequantizeNode(ngraph::Output<ngraph::Node> input, uint32_t index,
                                                  ngraph::element::Type dequantizeType);
+    // Quantize-dequantize of a float tensor to the 8 bit grid of the operand at index, expressed
+    // as a FakeQuantize that the plugin's low precision transformations recognize.
+    std::shared_ptr<ngraph::Node> FakeQuantizeNode(ngraph::Output<ngraph::Node> input,
+                                                   size_t index);
 
     const Operand& getInputOperand(uint32_t index) {
-        auto inputIdx = sModelInfo->getOperationInput(mNnapiOperationIndex, index);
-        return sModelInfo->getOperand(inputIdx);
+        auto inputIdx = mModelInfo->getOperationInput(mNnapiOperationIndex, index);
+        return mModelInfo->getOperand(inputIdx);
     }
 
     const Operand& getOutputOperand(uint32_t index) {
-        auto outputIdx = sModelInfo->getOperationOutput(mNnapiOperationIndex, index);
-        return sModelInfo->getOperand(outputIdx);
+        auto outputIdx = mModelInfo->getOperationOutput(mNnapiOperationIndex, index);
+        return mModelInfo->getOperand(outputIdx);
     }
 
     bool isZeroSizedInput(uint32_t index) {
-        auto inputIdx = sModelInfo->getOperationInput(mNnapiOperationIndex, index);
-        auto operand = sModelInfo->getOperand(inputIdx);
-        auto& dims = operand.dimensions;
+        auto inputIdx = mModelInfo->getOperationInput(mNnapiOperationIndex, index);
+        const auto dims = mModelInfo->getOperandDimensions(inputIdx);
 
         if ((dims.size() > 0) && (dims[0] != 0)) return false;
 
@@ -185,13 +216,11 @@ protected:
     }
 
 public:
-    static std::shared_ptr<NnapiModelInfo> sModelInfo;
-    static IntelDeviceType sPluginType;
     std::shared_ptr<NgraphNodes> mNgraphNodes;
-    OperationsBase(int operationIndex);
+    OperationsBase(int operationIndex, const GraphMetadata& graphMetadata);
     void setNgraphNodes(std::shared_ptr<NgraphNodes> nodes);
     virtual bool validate();
-    // override validateForPlugin in case sPluginType specific implementation is required
+    // override validateForPlugin in case mPluginType specific implementation is required
     virtual bool validateForPlugin();
     // override connectOperationToGraph in case Operation has multiple outputs
     virtual void connectOperationToGraph();
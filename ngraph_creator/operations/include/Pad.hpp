@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Pad : public OperationsBase {
 public:
-    Pad(int operationIndex);
+    Pad(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
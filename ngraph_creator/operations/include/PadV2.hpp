@@ -9,7 +9,7 @@ namespace nnhal {
 
 class PadV2 : public OperationsBase {
 public:
-    PadV2(int operationIndex);
+    PadV2(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Pow : public OperationsBase {
 public:
-    Pow(int operationIndex);
+    Pow(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Quantize : public OperationsBase {
 public:
-    Quantize(int operationIndex);
+    Quantize(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
     void connectOperationToGraph() override;
 };
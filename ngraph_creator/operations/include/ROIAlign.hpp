@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ROIAlign : public OperationsBase {
 public:
-    ROIAlign(int operationIndex);
+    ROIAlign(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
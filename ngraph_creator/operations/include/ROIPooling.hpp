@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ROIPooling : public OperationsBase {
 public:
-    ROIPooling(int operationIndex);
+    ROIPooling(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class RSQRT : public OperationsBase {
 public:
-    RSQRT(int operationIndex);
+    RSQRT(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
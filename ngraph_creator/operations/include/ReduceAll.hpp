@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ReduceAll : public OperationsBase {
 public:
-    ReduceAll(int operationIndex);
+    ReduceAll(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
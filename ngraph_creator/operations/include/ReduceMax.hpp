@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ReduceMax : public OperationsBase {
 public:
-    ReduceMax(int operationIndex);
+    ReduceMax(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
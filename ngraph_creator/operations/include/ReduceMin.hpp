@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ReduceMin : public OperationsBase {
 public:
-    ReduceMin(int operationIndex);
+    ReduceMin(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ReduceProd : public OperationsBase {
 public:
-    ReduceProd(int operationIndex);
+    ReduceProd(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
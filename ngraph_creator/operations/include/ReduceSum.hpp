@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ReduceSum : public OperationsBase {
 public:
-    ReduceSum(int operationIndex);
+    ReduceSum(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
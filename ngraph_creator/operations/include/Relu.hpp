@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Relu : public OperationsBase {
 public:
-    Relu(int operationIndex);
+    Relu(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
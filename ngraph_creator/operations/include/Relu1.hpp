@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Relu1 : public OperationsBase {
 public:
-    Relu1(int operationIndex);
+    Relu1(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class ResizeBilinear : public OperationsBase {
 public:
-    ResizeBilinear(int operationIndex);
+    ResizeBilinear(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
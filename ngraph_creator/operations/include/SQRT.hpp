@@ -9,7 +9,7 @@ namespace nnhal {
 
 class SQRT : public OperationsBase {
 public:
-    SQRT(int operationIndex);
+    SQRT(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
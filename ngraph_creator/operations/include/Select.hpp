@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Select : public OperationsBase {
 public:
-    Select(int operationIndex);
+    Select(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
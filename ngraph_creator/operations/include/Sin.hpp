@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Sin : public OperationsBase {
 public:
-    Sin(int operationIndex);
+    Sin(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Softmax : public OperationsBase {
 public:
-    Softmax(int operationIndex);
+    Softmax(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class SpaceToDepth : public OperationsBase {
 public:
-    SpaceToDepth(int operationIndex);
+    SpaceToDepth(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
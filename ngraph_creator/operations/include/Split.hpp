@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Split : public OperationsBase {
 public:
-    Split(int operationIndex);
+    Split(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
     void connectOperationToGraph() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Squeeze : public OperationsBase {
 public:
-    Squeeze(int operationIndex);
+    Squeeze(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Sub : public OperationsBase {
 public:
-    Sub(int operationIndex);
+    Sub(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Tanh : public OperationsBase {
 public:
-    Tanh(int operationIndex);
+    Tanh(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
 };
 
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class TopkV2 : public OperationsBase {
 public:
-    TopkV2(int operationIndex);
+    TopkV2(int operationIndex, const GraphMetadata& graphMetadata);
     std::shared_ptr<ngraph::Node> createNode() override;
     void connectOperationToGraph() override;
 };
@@ -9,7 +9,7 @@ namespace nnhal {
 
 class Transpose : public OperationsBase {
 public:
-    Transpose(int operationIndex);
+    Transpose(int operationIndex, const GraphMetadata& graphMetadata);
     bool validate() override;
     std::shared_ptr<ngraph::Node> createNode() override;
 };
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <OperationsBase.hpp>
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Lowered to an opset5 Loop whose body is the body model followed by the condition model on the
+// values it produced. The condition model is also built on the operation inputs for the first
+// test. Loop needs the carried values to keep their shape across iterations, so only static
+// shapes are supported.
+class While : public OperationsBase {
+public:
+    While(int operationIndex, const GraphMetadata& graphMetadata);
+    bool validate() override;
+    std::shared_ptr<ngraph::Node> createNode() override;
+    void connectOperationToGraph() override;
+};
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
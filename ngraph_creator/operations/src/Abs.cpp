@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Abs::Abs(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Abs::Abs(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Abs::createNode() {
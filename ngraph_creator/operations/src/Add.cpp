@@ -7,15 +7,16 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Add::Add(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Add::Add(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Add::validate() {
     ALOGV("%s PASSED", __func__);
 
-    const auto& activationIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 2);
-    if (!sModelInfo->isOperandLifeTimeConst(activationIndex)) {
+    const auto& activationIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 2);
+    if (!mModelInfo->isOperandLifeTimeConst(activationIndex)) {
         ALOGE("%s Due to OpenVINO API restrictions, Scalar input values must have CONST lifetime",
               __func__);
         return false;
@@ -26,12 +27,12 @@ bool Add::validate() {
 
 std::shared_ptr<ngraph::Node> Add::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input1, input2;
+    ngraph::Output<ngraph::Node> input1, input2;
 
     input1 = getInputNode(0);
     input2 = getInputNode(1);
 
-    auto activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
+    auto activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
 
     auto addNode =
         std::make_shared<ngraph::opset3::Add>(input1, input2, ngraph::op::AutoBroadcastType::NUMPY);
@@ -42,9 +43,9 @@ std::shared_ptr<ngraph::Node> Add::createNode() {
 }
 
 std::shared_ptr<ngraph::Node> Add::createNodeForPlugin() {
-    if (sPluginType == IntelDeviceType::VPU) {
+    if (mPluginType == IntelDeviceType::VPU) {
         auto input = mNgraphNodes->getOperationOutput(
-            sModelInfo->getOperationInput(mNnapiOperationIndex, 0));
+            mModelInfo->getOperationInput(mNnapiOperationIndex, 0));
         std::shared_ptr<ngraph::Node> constantOp =
             std::make_shared<ngraph::opset3::Constant>(ngraph::element::f32, input.get_shape());
         auto transposedOp = transpose(NHWC_NCHW, constantOp);
@@ -7,17 +7,18 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Argmin::Argmin(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Argmin::Argmin(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Argmin::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
 
     input = getInputNode(0);
 
-    int32_t axis = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
+    int32_t axis = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
     ALOGD("createNode axis %d", axis);
 
     auto k_node = createConstNode(ngraph::element::i32, {}, convertToVector(1));
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-AveragePool2D::AveragePool2D(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+AveragePool2D::AveragePool2D(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool AveragePool2D::validate() {
@@ -24,9 +25,9 @@ bool AveragePool2D::validate() {
 }
 
 std::shared_ptr<ngraph::Node> AveragePool2D::createNode() {
-    std::shared_ptr<ngraph::Node> inputNode;
+    ngraph::Output<ngraph::Node> inputNode;
     const auto& inDims = getInputOperandDimensions(0);
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
 
     inputNode = getInputNode(0);
 
@@ -56,21 +57,21 @@ std::shared_ptr<ngraph::Node> AveragePool2D::createNode() {
     }
 
     if (isExplicit) {
-        padding_left = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 1);
-        padding_right = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
-        padding_top = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
-        padding_bottom = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        padding_left = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 1);
+        padding_right = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
+        padding_top = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        padding_bottom = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
-        filter_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
-        filter_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
+        filter_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
+        filter_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
 
         if (inputsSize == 11) {
-            layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 10);
+            layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 10);
         }
 
         if (layout) useNchw = true;
@@ -79,18 +80,18 @@ std::shared_ptr<ngraph::Node> AveragePool2D::createNode() {
     }
 
     if (isImplicit) {
-        padding_scheme = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 1);
+        padding_scheme = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 1);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
 
-        filter_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
-        filter_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        filter_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        filter_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
         if (inputsSize == 8) {
-            layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 7);
+            layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 7);
         }
 
         if (layout) useNchw = true;
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-BatchToSpace::BatchToSpace(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+BatchToSpace::BatchToSpace(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool BatchToSpace::validate() {
@@ -17,10 +18,10 @@ bool BatchToSpace::validate() {
 
     if (inputRank != 4) return false;
 
-    const auto& block_shape_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& block_shape_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
 
     // TODO: Add Support for all_tensors_as_inputs
-    if (!sModelInfo->isOperandLifeTimeConst(block_shape_OperandIndex)) {
+    if (!mModelInfo->isOperandLifeTimeConst(block_shape_OperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
@@ -32,19 +33,19 @@ bool BatchToSpace::validate() {
 std::shared_ptr<ngraph::Node> BatchToSpace::createNode() {
     int32_t layout = 0;
     bool useNchw = false;
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
     ALOGD("%s inputsSize %lu", __func__, inputsSize);
 
     auto inputNode = getInputNode(0);
     auto& inDims = getInputOperandDimensions(0);
-    const auto& block_shape_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-    auto block_shape = sModelInfo->GetConstVecOperand<int32_t>(block_shape_OperandIndex);
+    const auto& block_shape_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    auto block_shape = mModelInfo->GetConstVecOperand<int32_t>(block_shape_OperandIndex);
 
     // Compensation for the shape to be same as the size of data input shape
     block_shape.insert(block_shape.begin(), 1);
     block_shape.insert(block_shape.begin(), 1);
 
-    if (inputsSize == 3) layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
+    if (inputsSize == 3) layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
     if (layout) useNchw = true;
 
     std::vector<uint32_t> shape(inDims.size(), 0);
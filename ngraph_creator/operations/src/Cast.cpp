@@ -7,26 +7,27 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Cast::Cast(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Cast::Cast(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 void Cast::connectOperationToGraph() { createNode(); }
 
 std::shared_ptr<ngraph::Node> Cast::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
 
     input = getInputNode(0, false);
 
-    auto inputIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 0);
-    auto outputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+    auto inputIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 0);
+    auto outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 
-    const auto& inputType = sModelInfo->getOperationType(inputIndex);
-    const auto& outputType = sModelInfo->getOperationType(outputIndex);
+    const auto& inputType = mModelInfo->getOperationType(inputIndex);
+    const auto& outputType = mModelInfo->getOperationType(outputIndex);
 
     ngraph::element::Type elementType;  // change to outputbased element type
-    std::shared_ptr<ngraph::Node> outputNode;
+    ngraph::Output<ngraph::Node> outputNode;
 
     if (inputType == outputType) {
         outputNode = input;
@@ -63,7 +64,7 @@ std::shared_ptr<ngraph::Node> Cast::createNode() {
     }
 
     mNgraphNodes->setOutputAtOperandIndex(outputIndex, outputNode);
-    const auto op = sModelInfo->getOperand(outputIndex);
+    const auto& op = mModelInfo->getOperand(outputIndex);
     if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
         addResultNode(mDefaultOutputIndex, outputNode);
     }
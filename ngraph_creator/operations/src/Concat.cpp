@@ -7,13 +7,14 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Concat::Concat(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Concat::Concat(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Concat::validate() {
     // check concatenation axis
-    auto n = sModelInfo->getOperationInputsSize(mNnapiOperationIndex) -
+    auto n = mModelInfo->getOperationInputsSize(mNnapiOperationIndex) -
              1;  // 0 ~ n-1: The list of n input tensors
     for (size_t i = 0; i < n; i++) {
         if (!isValidInputTensor(i)) {
@@ -26,16 +27,16 @@ bool Concat::validate() {
 }
 
 std::shared_ptr<ngraph::Node> Concat::createNode() {
-    auto n = sModelInfo->getOperationInputsSize(mNnapiOperationIndex) -
+    auto n = mModelInfo->getOperationInputsSize(mNnapiOperationIndex) -
              1;  // 0 ~ n-1: The list of n input tensors
-    auto axis = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex,
+    auto axis = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex,
                                                           n);  // n: concatenation axis
     std::vector<ngraph::Output<ngraph::Node>> inputs;
     ALOGD("createNode n %lu, axis %d", n, axis);
     for (size_t i = 0; i < n; i++) {
-        auto inputIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, i);
+        auto inputIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, i);
         auto inputOp = getInputNode(i);
-        const auto op = sModelInfo->getOperand(inputIndex);
+        const auto& op = mModelInfo->getOperand(inputIndex);
         ALOGD("createNode inputIndex %d, lifetime %d", inputIndex, op.lifetime);
         inputs.push_back(inputOp);
     }
@@ -8,8 +8,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Conv2d::Conv2d(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Conv2d::Conv2d(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Conv2d::validate() {
@@ -27,8 +28,8 @@ bool Conv2d::validate() {
     }
 
     if (checkInputOperandType(1, (int32_t)OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL)) {
-        const auto& operandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-        const auto& operand = sModelInfo->getOperand(operandIndex);
+        const auto& operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+        const auto& operand = mModelInfo->getOperand(operandIndex);
         if (operand.extraParams.channelQuant().channelDim != 0) {
             return false;
         }
@@ -39,7 +40,7 @@ bool Conv2d::validate() {
 }
 
 std::shared_ptr<ngraph::Node> Conv2d::createNode() {
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
     ALOGD("%s inputsSize %lu", __func__, inputsSize);
 
     bool isImplicit = false, isExplicit = false;
@@ -77,28 +78,28 @@ std::shared_ptr<ngraph::Node> Conv2d::createNode() {
     // TODO: create a generic function to support conv, depthwise, grouped_conv and transpose_conv
     // operations
     if (isExplicit) {
-        padding_left = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
-        padding_right = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
-        padding_top = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
-        padding_bottom = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        padding_left = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        padding_right = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        padding_top = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        padding_bottom = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
 
         if (inputsSize > 10 && inputsSize <= 13) {
             switch (inputsSize) {
                 case 13:
                     dilation_height_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 12);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 12);
                     __attribute__((fallthrough));
                 case 12:
                     dilation_width_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 11);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 11);
                     __attribute__((fallthrough));
                 case 11:
-                    layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 10);
+                    layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 10);
                     __attribute__((fallthrough));
                 default:
                     break;
@@ -120,25 +121,25 @@ std::shared_ptr<ngraph::Node> Conv2d::createNode() {
     }
 
     if (isImplicit) {
-        padding_scheme = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        padding_scheme = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
         if (inputsSize > 7 && inputsSize <= 10) {
             switch (inputsSize) {
                 case 10:
                     dilation_height_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
                     __attribute__((fallthrough));
                 case 9:
                     dilation_width_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
                     __attribute__((fallthrough));
                 case 8:
-                    layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 7);
+                    layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 7);
                     __attribute__((fallthrough));
                 default:
                     break;
@@ -172,18 +173,18 @@ std::shared_ptr<ngraph::Node> Conv2d::createNode() {
         }
     }
 
-    std::shared_ptr<ngraph::Node> inputNode, filterNode, biasNode;
-    const auto& biasIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 2);
+    ngraph::Output<ngraph::Node> inputNode, filterNode, biasNode;
+    const auto& biasIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 2);
 
     inputNode = getInputNode(0);
     filterNode = getInputNode(1);
     biasNode = getInputNode(2);
 
     if (checkInputOperandType(1, (int32_t)OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL)) {
-        auto filterIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-        const auto& filterOperand = sModelInfo->getOperand(filterIndex);
+        auto filterIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+        const auto& filterOperand = mModelInfo->getOperand(filterIndex);
         vec<float> filterScales = filterOperand.extraParams.channelQuant().scales;
-        float inputScale = sModelInfo->getOperandScale(0);
+        float inputScale = mModelInfo->getOperandScale(0);
         auto filterScalesNode =
             createConstNode(ngraph::element::f32, ngraph::Shape{filterScales.size()}, filterScales);
         auto inputScalesNode =
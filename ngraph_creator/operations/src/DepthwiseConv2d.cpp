@@ -8,8 +8,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-DepthwiseConv2d::DepthwiseConv2d(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+DepthwiseConv2d::DepthwiseConv2d(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool DepthwiseConv2d::validate() {
@@ -29,8 +30,8 @@ bool DepthwiseConv2d::validate() {
     }
 
     if (checkInputOperandType(1, (int32_t)OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL)) {
-        const auto& operandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-        const auto& operand = sModelInfo->getOperand(operandIndex);
+        const auto& operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+        const auto& operand = mModelInfo->getOperand(operandIndex);
         if (operand.extraParams.channelQuant().channelDim != 3) {
             return false;
         }
@@ -41,7 +42,7 @@ bool DepthwiseConv2d::validate() {
 }
 
 std::shared_ptr<ngraph::Node> DepthwiseConv2d::createNode() {
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
     ALOGD("%s inputsSize %lu", __func__, inputsSize);
     bool isImplicit = false, isExplicit = false;
 
@@ -78,30 +79,30 @@ std::shared_ptr<ngraph::Node> DepthwiseConv2d::createNode() {
     }
 
     if (isExplicit) {
-        padding_left = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
-        padding_right = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
-        padding_top = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
-        padding_bottom = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        padding_left = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        padding_right = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        padding_top = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        padding_bottom = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
 
-        depthwise_multiplier = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
+        depthwise_multiplier = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 10);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 10);
 
         if (inputsSize > 11 && inputsSize <= 14) {
             switch (inputsSize) {
                 case 14:
                     dilation_height_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 13);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 13);
                     __attribute__((fallthrough));
                 case 13:
                     dilation_width_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 12);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 12);
                     __attribute__((fallthrough));
                 case 12:
-                    layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 11);
+                    layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 11);
                     __attribute__((fallthrough));
                 default:
                     break;
@@ -125,27 +126,27 @@ std::shared_ptr<ngraph::Node> DepthwiseConv2d::createNode() {
     }
 
     if (isImplicit) {
-        padding_scheme = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        padding_scheme = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
 
-        depthwise_multiplier = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        depthwise_multiplier = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
 
         if (inputsSize > 8 && inputsSize <= 11) {
             switch (inputsSize) {
                 case 11:
                     dilation_height_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 10);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 10);
                     __attribute__((fallthrough));
                 case 10:
                     dilation_width_factor =
-                        sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
+                        mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
                     __attribute__((fallthrough));
                 case 9:
-                    layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 8);
+                    layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 8);
                     __attribute__((fallthrough));
                 default:
                     break;
@@ -181,18 +182,18 @@ std::shared_ptr<ngraph::Node> DepthwiseConv2d::createNode() {
         }
     }
 
-    std::shared_ptr<ngraph::Node> inputNode, filterNode, biasNode;
-    const auto& biasIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 2);
+    ngraph::Output<ngraph::Node> inputNode, filterNode, biasNode;
+    const auto& biasIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 2);
 
     inputNode = getInputNode(0);
     filterNode = getInputNode(1);
     biasNode = getInputNode(2);
 
     if (checkInputOperandType(1, (int32_t)OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL)) {
-        auto filterIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-        const auto& filterOperand = sModelInfo->getOperand(filterIndex);
+        auto filterIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+        const auto& filterOperand = mModelInfo->getOperand(filterIndex);
         vec<float> filterScales = filterOperand.extraParams.channelQuant().scales;
-        float inputScale = sModelInfo->getOperandScale(0);
+        float inputScale = mModelInfo->getOperandScale(0);
         auto filterScalesNode =
             createConstNode(ngraph::element::f32, ngraph::Shape{filterScales.size()}, filterScales);
         auto inputScalesNode =
@@ -223,8 +224,8 @@ std::shared_ptr<ngraph::Node> DepthwiseConv2d::createNode() {
     pads_end = {padding_bottom, padding_right};
     dilations = {(size_t)dilation_height_factor, (size_t)dilation_width_factor};
 
-    if (filterNode != nullptr) {
-        std::vector<size_t> shape(&filterNode->get_shape()[0], &filterNode->get_shape()[0] + 4);
+    if (filterNode.get_node() != nullptr) {
+        std::vector<size_t> shape(&filterNode.get_shape()[0], &filterNode.get_shape()[0] + 4);
         shape[0] /= input_channel;
         shape.insert(shape.begin(), input_channel);
         ALOGD("%s final filternode shape %lu", __func__, shape.size());
@@ -7,15 +7,17 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Dequantize::Dequantize(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Dequantize::Dequantize(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Dequantize::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input, outputNode;
+    ngraph::Output<ngraph::Node> input;
+    std::shared_ptr<ngraph::Node> outputNode;
     input = getInputNode(0, false);
-    const auto& inputIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 0);
+    const auto& inputIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 0);
 
     if (checkOutputOperandType(0, (int32_t)OperandType::TENSOR_FLOAT16))
         outputNode = DequantizeNode(input, inputIndex, ngraph::element::f16);
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Div::Div(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Div::Div(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Div::createNode() {
@@ -16,7 +17,7 @@ std::shared_ptr<ngraph::Node> Div::createNode() {
     auto input1 = getInputNode(0);
     auto input2 = getInputNode(1);
 
-    auto activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
+    auto activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 2);
 
     auto DivNode = std::make_shared<ngraph::opset3::Divide>(input1, input2,
                                                             ngraph::op::AutoBroadcastType::NUMPY);
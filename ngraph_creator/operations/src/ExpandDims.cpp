@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-ExpandDims::ExpandDims(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+ExpandDims::ExpandDims(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool ExpandDims::validate() {
@@ -22,7 +23,7 @@ bool ExpandDims::validate() {
 std::shared_ptr<ngraph::Node> ExpandDims::createNode() {
     // Creating input nodes
     auto input = getInputNode(0);
-    auto index = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
+    auto index = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
 
     auto axes = createConstNode(ngraph::element::i32, {}, convertToVector(index));
 
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-FullyConnected::FullyConnected(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+FullyConnected::FullyConnected(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 // Supports only FP32 input. Will add support for QUANT8 through decompose node
@@ -31,9 +32,10 @@ bool FullyConnected::validate() {
 }
 
 std::shared_ptr<ngraph::Node> FullyConnected::createNode() {
-    std::shared_ptr<ngraph::Node> inputNode = getInputNode(0);
-    std::shared_ptr<ngraph::Node> weightsNode = getInputNode(1);
-    std::shared_ptr<ngraph::Node> biasNode, multiplyNode, addNode, activationNode;
+    ngraph::Output<ngraph::Node> inputNode = getInputNode(0);
+    ngraph::Output<ngraph::Node> weightsNode = getInputNode(1);
+    ngraph::Output<ngraph::Node> biasNode;
+    std::shared_ptr<ngraph::Node> multiplyNode, addNode, activationNode;
 
     auto inputDims = getInputOperand(0).dimensions;
     auto weightDims = getInputOperand(1).dimensions;
@@ -52,13 +54,13 @@ std::shared_ptr<ngraph::Node> FullyConnected::createNode() {
             std::make_shared<ngraph::opset3::MatMul>(inputNode, weightsNode, false, true);
     }
 
-    if (!sModelInfo->isOmittedInput(mNnapiOperationIndex, 2) && biasDims.size() != 0) {
+    if (!mModelInfo->isOmittedInput(mNnapiOperationIndex, 2) && biasDims.size() != 0) {
         biasNode = getInputNode(2);
 
         if (checkInputOperandType(0, (int32_t)OperandType::TENSOR_QUANT8_ASYMM) ||
             checkInputOperandType(0, (int32_t)OperandType::TENSOR_QUANT8_ASYMM_SIGNED))
             biasNode =
-                DequantizeNode(biasNode, sModelInfo->getOperationInput(mNnapiOperationIndex, 2),
+                DequantizeNode(biasNode, mModelInfo->getOperationInput(mNnapiOperationIndex, 2),
                                ngraph::element::f32);
 
         addNode = std::make_shared<ngraph::opset3::Add>(multiplyNode, biasNode,
@@ -68,7 +70,7 @@ std::shared_ptr<ngraph::Node> FullyConnected::createNode() {
         addNode = multiplyNode;
     }
 
-    auto activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+    auto activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
     activationNode = applyActivation(addNode, activationFn);
     return activationNode ? activationNode : addNode;
 }
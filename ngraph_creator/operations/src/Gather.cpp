@@ -7,18 +7,19 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Gather::Gather(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Gather::Gather(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Gather::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> gatherVals;
+    ngraph::Output<ngraph::Node> gatherVals;
 
     gatherVals = getInputNode(0);
 
     // axis range [-n, n]
-    auto axis = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
+    auto axis = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
     auto axisNode = createConstNode(ngraph::element::i32, {}, convertToVector(axis));
 
     auto indices = getInputNode(2);
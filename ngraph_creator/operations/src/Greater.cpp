@@ -7,13 +7,14 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Greater::Greater(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Greater::Greater(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Greater::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input1, input2;
+    ngraph::Output<ngraph::Node> input1, input2;
 
     input1 = getInputNode(0);
     input2 = getInputNode(1);
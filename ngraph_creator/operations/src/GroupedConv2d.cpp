@@ -8,8 +8,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-GroupedConv2d::GroupedConv2d(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+GroupedConv2d::GroupedConv2d(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool GroupedConv2d::validate() {
@@ -23,8 +24,8 @@ bool GroupedConv2d::validate() {
     }
 
     if (checkInputOperandType(1, (int32_t)OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL)) {
-        const auto& operandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-        const auto& operand = sModelInfo->getOperand(operandIndex);
+        const auto& operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+        const auto& operand = mModelInfo->getOperand(operandIndex);
         if (operand.extraParams.channelQuant().channelDim != 0) {
             return false;
         }
@@ -35,7 +36,7 @@ bool GroupedConv2d::validate() {
 }
 
 std::shared_ptr<ngraph::Node> GroupedConv2d::createNode() {
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
     bool isImplicit = false, isExplicit = false;
 
     if (inputsSize >= 11 && inputsSize <= 12 &&
@@ -71,20 +72,20 @@ std::shared_ptr<ngraph::Node> GroupedConv2d::createNode() {
     }
 
     if (isExplicit) {
-        padding_left = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
-        padding_right = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
-        padding_top = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
-        padding_bottom = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        padding_left = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        padding_right = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        padding_top = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        padding_bottom = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 8);
 
-        number_groups = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
+        number_groups = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 9);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 10);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 10);
 
         if (inputsSize == 12)
-            layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 11);
+            layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 11);
 
         if (layout) useNchw = true;
 
@@ -103,17 +104,17 @@ std::shared_ptr<ngraph::Node> GroupedConv2d::createNode() {
     }
 
     if (isImplicit) {
-        padding_scheme = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
+        padding_scheme = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 3);
 
-        stride_width = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
-        stride_height = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+        stride_width = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 4);
+        stride_height = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
 
-        number_groups = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+        number_groups = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
-        activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
+        activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 7);
 
         if (inputsSize == 9)
-            layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 8);
+            layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 8);
 
         if (layout) useNchw = true;
 
@@ -144,18 +145,18 @@ std::shared_ptr<ngraph::Node> GroupedConv2d::createNode() {
         }
     }
 
-    std::shared_ptr<ngraph::Node> inputNode, filterNode, biasNode;
-    const auto& biasIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 2);
+    ngraph::Output<ngraph::Node> inputNode, filterNode, biasNode;
+    const auto& biasIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 2);
 
     inputNode = getInputNode(0);
     filterNode = getInputNode(1);
     biasNode = getInputNode(2);
 
     if (checkInputOperandType(1, (int32_t)OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL)) {
-        auto filterIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-        const auto& filterOperand = sModelInfo->getOperand(filterIndex);
+        auto filterIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+        const auto& filterOperand = mModelInfo->getOperand(filterIndex);
         vec<float> filterScales = filterOperand.extraParams.channelQuant().scales;
-        float inputScale = sModelInfo->getOperandScale(0);
+        float inputScale = mModelInfo->getOperandScale(0);
         auto filterScalesNode =
             createConstNode(ngraph::element::f32, ngraph::Shape{filterScales.size()}, filterScales);
         auto inputScalesNode =
@@ -191,8 +192,8 @@ std::shared_ptr<ngraph::Node> GroupedConv2d::createNode() {
     // filter = [depth_out=(groups * c_out), height, width, depth_group=c_in]
     // openvino: input=[n, groups * c_in, height, width], kernel=[groups, c_out,
     // c_in, height, width]
-    if (filterNode != nullptr) {
-        std::vector<size_t> shape(&filterNode->get_shape()[0], &filterNode->get_shape()[0] + 4);
+    if (filterNode.get_node() != nullptr) {
+        std::vector<size_t> shape(&filterNode.get_shape()[0], &filterNode.get_shape()[0] + 4);
 
         shape[0] /= number_groups;
         shape.insert(shape.begin(), number_groups);
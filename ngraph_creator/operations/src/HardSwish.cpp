@@ -6,8 +6,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-HardSwish::HardSwish(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+HardSwish::HardSwish(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool HardSwish::validate() {
@@ -16,7 +17,8 @@ bool HardSwish::validate() {
 }
 
 std::shared_ptr<ngraph::Node> HardSwish::createNode() {
-    std::shared_ptr<ngraph::Node> outputNode, inputNode;
+    std::shared_ptr<ngraph::Node> outputNode;
+    ngraph::Output<ngraph::Node> inputNode;
     inputNode = getInputNode(0);
 
     outputNode = std::make_shared<ngraph::op::v4::HSwish>(inputNode);
@@ -0,0 +1,100 @@
+#include <If.hpp>
+#include <NgraphNetworkCreator.hpp>
+#include <algorithm>
+#include <stdexcept>
+#undef LOG_TAG
+#define LOG_TAG "If"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Inputs 0: condition, 1: then model, 2: else model, 3 ~ (n + 2): inputs of both branches
+constexpr uint32_t kFirstBranchInput = 3;
+
+If::If(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+}
+
+bool If::validateBranch(uint32_t inputIndex) {
+    auto branchInfo = mModelInfo->getReferencedModelInfo(
+        mModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex));
+    if (branchInfo == nullptr) return false;
+    const auto inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto outputsSize = mModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
+    if (branchInfo->getModelInputIndexes().size() != inputsSize - kFirstBranchInput ||
+        branchInfo->getModelOutputsSize() != outputsSize) {
+        ALOGE("%s branch %d signature does not match the operation", __func__, inputIndex);
+        return false;
+    }
+    // Select needs both branches to produce the outputs in their final shape
+    for (uint32_t i = 0; i < outputsSize; i++) {
+        const auto& output = getOutputOperand(i);
+        const auto& branchOutput = branchInfo->getOperand(branchInfo->getModelOutputIndex(i));
+        if (output.dimensions.size() == 0 ||
+            std::find(output.dimensions.begin(), output.dimensions.end(), 0) !=
+                output.dimensions.end()) {
+            ALOGE("%s output %d has no static shape", __func__, i);
+            return false;
+        }
+        if (branchOutput.type != output.type || branchOutput.dimensions != output.dimensions) {
+            ALOGE("%s branch %d output %d does not match the operation output", __func__,
+                  inputIndex, i);
+            return false;
+        }
+    }
+    return NgraphNetworkCreator::validateSubgraph(branchInfo, mPluginType);
+}
+
+bool If::validate() {
+    if (!checkInputOperandType(0, (int32_t)OperandType::TENSOR_BOOL8)) return false;
+    if (!validateBranch(1) || !validateBranch(2)) return false;
+    ALOGV("%s PASSED", __func__);
+    return true;
+}
+
+ngraph::OutputVector If::connectBranch(uint32_t inputIndex, const ngraph::OutputVector& inputs) {
+    auto branchInfo = mModelInfo->getReferencedModelInfo(
+        mModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex));
+    if (branchInfo == nullptr) return {};
+    NgraphNetworkCreator branch(branchInfo, mPluginType, mLowPrecision);
+    return branch.connectSubgraph(inputs);
+}
+
+void If::connectOperationToGraph() { createNode(); }
+
+std::shared_ptr<ngraph::Node> If::createNode() {
+    auto condition = getInputNode(0);
+    ngraph::OutputVector inputs;
+    for (uint32_t i = kFirstBranchInput;
+         i < mModelInfo->getOperationInputsSize(mNnapiOperationIndex); i++)
+        inputs.push_back(getInputNode(i, false));
+
+    const auto thenOutputs = connectBranch(1, inputs);
+    const auto elseOutputs = connectBranch(2, inputs);
+    const auto outputsSize = mModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
+    if (thenOutputs.size() != outputsSize || elseOutputs.size() != outputsSize)
+        throw std::runtime_error("IF branch could not be built");
+
+    for (uint32_t i = 0; i < outputsSize; i++) {
+        auto outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, i);
+        // The branch outputs are in the integer representation of quantized operands
+        std::shared_ptr<ngraph::Node> outNode =
+            std::make_shared<ngraph::opset3::Select>(condition, thenOutputs[i], elseOutputs[i]);
+        mNgraphNodes->setOutputAtOperandIndex(outputIndex, outNode);
+        ALOGD("%s Set Output index %d", __func__, outputIndex);
+        const auto& op = mModelInfo->getOperand(outputIndex);
+        if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
+            addResultNode(outputIndex, outNode);
+            ALOGD("%s Add result %d", __func__, outputIndex);
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-InstanceNormalization::InstanceNormalization(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+InstanceNormalization::InstanceNormalization(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool InstanceNormalization::validate() {
@@ -37,17 +38,17 @@ bool InstanceNormalization::validate() {
 std::shared_ptr<ngraph::Node> InstanceNormalization::createNode() {
     ALOGV("%s Entering", __func__);
 
-    std::shared_ptr<ngraph::Node> inputNode;
+    ngraph::Output<ngraph::Node> inputNode;
     bool useNchw = false;
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
     ALOGD("%s inputsSize %lu", __func__, inputsSize);
 
     // Read inputs
     inputNode = getInputNode(0);
-    auto gamma = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 1);
-    auto beta = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 2);
-    auto epsilon = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 3);
-    auto layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 4);
+    auto gamma = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 1);
+    auto beta = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 2);
+    auto epsilon = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 3);
+    auto layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 4);
     if (layout) useNchw = true;
 
     if (!useNchw)  // No conversion needed if useNchw set
@@ -13,13 +13,14 @@ namespace nnhal {
 #define ACTIVATION_FUNCTION_TANH 4
 #define ACTIVATION_FUNCTION_SIGMOID 6
 
-LSTM::LSTM(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+LSTM::LSTM(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool LSTM::validate() {
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
-    const auto& outputsSize = sModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& outputsSize = mModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
 
     if (inputsSize != 23) {
         if (inputsSize != 27) return false;
@@ -34,15 +35,15 @@ bool LSTM::validate() {
 void LSTM::connectOperationToGraph() { createNode(); }
 
 std::shared_ptr<ngraph::Node> LSTM::createNode() {
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
 
     bool isCIFGenabled = false, isPeepholeUsed = false, isProjectionUsed = false,
          isLayerNormUsed = false, isCifgDimsEmpty = true;
 
     // checking if CIFG enabled
-    if (sModelInfo->isOmittedInput(mNnapiOperationIndex, 1) &&
-        sModelInfo->isOmittedInput(mNnapiOperationIndex, 5) &&
-        sModelInfo->isOmittedInput(mNnapiOperationIndex, 12)) {
+    if (mModelInfo->isOmittedInput(mNnapiOperationIndex, 1) &&
+        mModelInfo->isOmittedInput(mNnapiOperationIndex, 5) &&
+        mModelInfo->isOmittedInput(mNnapiOperationIndex, 12)) {
         isCIFGenabled = true;
     } else {
         if (isValidInputTensor(1) && isValidInputTensor(5) && isValidInputTensor(12))
@@ -52,9 +53,9 @@ std::shared_ptr<ngraph::Node> LSTM::createNode() {
     }
 
     // checking if peephole enabled
-    if (sModelInfo->isOmittedInput(mNnapiOperationIndex, 9) &&
-        sModelInfo->isOmittedInput(mNnapiOperationIndex, 10) &&
-        sModelInfo->isOmittedInput(mNnapiOperationIndex, 11)) {
+    if (mModelInfo->isOmittedInput(mNnapiOperationIndex, 9) &&
+        mModelInfo->isOmittedInput(mNnapiOperationIndex, 10) &&
+        mModelInfo->isOmittedInput(mNnapiOperationIndex, 11)) {
         isPeepholeUsed = false;
     } else {
         if (!isCIFGenabled && !isValidInputTensor(9) && isValidInputTensor(10) &&
@@ -76,7 +77,7 @@ std::shared_ptr<ngraph::Node> LSTM::createNode() {
     }
 
     // checking if projection enabled
-    if (sModelInfo->isOmittedInput(mNnapiOperationIndex, 16)) {
+    if (mModelInfo->isOmittedInput(mNnapiOperationIndex, 16)) {
         isProjectionUsed = false;
     } else {
         if (isValidInputTensor(16))
@@ -87,10 +88,10 @@ std::shared_ptr<ngraph::Node> LSTM::createNode() {
 
     if (inputsSize == 27) {
         // checking if layer normalization enabled
-        if (sModelInfo->isOmittedInput(mNnapiOperationIndex, 23) &&
-            sModelInfo->isOmittedInput(mNnapiOperationIndex, 24) &&
-            sModelInfo->isOmittedInput(mNnapiOperationIndex, 25) &&
-            sModelInfo->isOmittedInput(mNnapiOperationIndex, 26)) {
+        if (mModelInfo->isOmittedInput(mNnapiOperationIndex, 23) &&
+            mModelInfo->isOmittedInput(mNnapiOperationIndex, 24) &&
+            mModelInfo->isOmittedInput(mNnapiOperationIndex, 25) &&
+            mModelInfo->isOmittedInput(mNnapiOperationIndex, 26)) {
             isLayerNormUsed = false;
         } else {
             if (isCIFGenabled) {
@@ -109,7 +110,7 @@ std::shared_ptr<ngraph::Node> LSTM::createNode() {
         }
     }
 
-    std::shared_ptr<ngraph::Node> inputNode, input2input_weights, input2forget_weights,
+    ngraph::Output<ngraph::Node> inputNode, input2input_weights, input2forget_weights,
         input2cell_weights, input2output_weights, recurrent2input_weights, recurrent2forget_weights,
         recurrent2cell_weights, recurrent2output_weights, cell2input_weights, cell2forget_weights,
         cell2output_weights, input_gate_bias, forget_gate_bias, cell_bias, output_gate_bias,
@@ -124,7 +125,7 @@ std::shared_ptr<ngraph::Node> LSTM::createNode() {
 
     // Creating input nodes
     inputNode = getInputNode(0);
-    const auto& elementType = inputNode->get_element_type();
+    const auto& elementType = inputNode.get_element_type();
 
     // W_{xi}, W_{xf}, W_{xc}, W_{xo}
     if (isCIFGenabled) {
@@ -187,22 +188,89 @@ std::shared_ptr<ngraph::Node> LSTM::createNode() {
     initial_hidden_state = getInputNode(18);  // h_{t-1}
     initial_cell_state = getInputNode(19);    // C_{t-1}
 
-    activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 20);
+    activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 20);
 
     if (checkInputOperandType(0, (int32_t)OperandType::TENSOR_FLOAT16)) {
-        cell_state_clipping = sModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 21);
+        cell_state_clipping = mModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 21);
         if (isProjectionUsed)
-            proj_clipping = sModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 22);
+            proj_clipping = mModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 22);
     } else {
-        cell_state_clipping = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 21);
+        cell_state_clipping = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 21);
         if (isProjectionUsed)
-            proj_clipping = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 22);
+            proj_clipping = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 22);
+    }
+
+    // The common configurations run on the plugin's LSTM cell, which computes all the gates with
+    // a single GEMM. CIFG, peephole, layer normalization and cell clipping (LSTMCell clips the
+    // gates, not the cell state) keep the decomposed graph below.
+    //
+    // With projection, h_{t-1} has output_size elements where LSTMCell expects num_units. The
+    // cell then takes h_{t-1} padded with zeros to num_units and the recurrent weights padded
+    // with as many zero columns, which gives the same gates, and its output o_t (.) g(C_t) is
+    // projected by a MatMul after it. The cell can't run on the unprojected o_t (.) g(C_t) of the
+    // previous step instead, as NNAPI only passes the projected h_{t-1}, and W_{proj} can't be
+    // inverted. The padding adds (num_units - output_size) zero columns to the recurrent GEMM, so
+    // the cell is only used while that at most doubles it.
+    const bool cellProjection =
+        isProjectionUsed && output_size <= num_units && output_size * 2 >= num_units;
+    std::string cellActivation;
+    if (!isCIFGenabled && !isPeepholeUsed && !isLayerNormUsed &&
+        (!isProjectionUsed || cellProjection) && cell_state_clipping == 0.f &&
+        getCellActivationName(activationFn, cellActivation)) {
+        ALOGD("%s using LSTMCell%s", __func__, isProjectionUsed ? " and a projection" : "");
+
+        // LSTMCell takes the gates stacked in f, i, c, o order
+        auto W = std::make_shared<ngraph::opset3::Concat>(
+            ngraph::OutputVector{input2forget_weights, input2input_weights, input2cell_weights,
+                                 input2output_weights},
+            0);
+        std::shared_ptr<ngraph::Node> R = std::make_shared<ngraph::opset3::Concat>(
+            ngraph::OutputVector{recurrent2forget_weights, recurrent2input_weights,
+                                 recurrent2cell_weights, recurrent2output_weights},
+            0);
+        auto B = std::make_shared<ngraph::opset3::Concat>(
+            ngraph::OutputVector{forget_gate_bias, input_gate_bias, cell_bias, output_gate_bias},
+            0);
+
+        ngraph::Output<ngraph::Node> hiddenState = initial_hidden_state;
+        if (output_size < num_units) {
+            // Zeros appended to the last dimension
+            const int32_t padding = num_units - output_size;
+            auto padsBegin = createConstNode(ngraph::element::i32, {2}, std::vector<int32_t>{0, 0});
+            auto padsEnd =
+                createConstNode(ngraph::element::i32, {2}, std::vector<int32_t>{0, padding});
+            hiddenState = std::make_shared<ngraph::opset3::Pad>(hiddenState, padsBegin, padsEnd,
+                                                                ngraph::op::PadMode::CONSTANT);
+            R = std::make_shared<ngraph::opset3::Pad>(R, padsBegin, padsEnd,
+                                                      ngraph::op::PadMode::CONSTANT);
+        }
+
+        auto cell = std::make_shared<ngraph::opset3::LSTMCell>(
+            inputNode, hiddenState, initial_cell_state, W, R, B, num_units,
+            ngraph::op::LSTMWeightsFormat::FICO,
+            std::vector<std::string>{"sigmoid", cellActivation, cellActivation});
+
+        ngraph::Output<ngraph::Node> H = cell->output(0);
+        const auto C = cell->output(1);
+        if (isProjectionUsed) {
+            // clip(W_{proj}(o_t odot g(C_t))+b_{proj}, t_{proj})
+            H = clip(add(matMul(H, projection_weights, false, true), projection_bias),
+                     proj_clipping);
+        }
+
+        // NNAPI leaves the content of the scratch buffer unspecified. Like the decomposed graph,
+        // the cell returns zeros, computed from C so that the output is connected to the graph.
+        auto scratchBuffer =
+            mul(createConstNode(elementType, C.get_shape(), convertToVector(0.f)), C);
+        std::vector<ngraph::Output<ngraph::Node>> inputs(4, scratchBuffer);
+        setLstmOutputs({std::make_shared<ngraph::opset3::Concat>(inputs, 1), H, C, H});
+        return nullptr;
     }
 
     std::shared_ptr<ngraph::Node> i_t, f_t, c_t, o_t;
     std::shared_ptr<ngraph::Node> scratchBuffer;
 
-    std::shared_ptr<ngraph::Node> input_layer_norm_weights, forget_layer_norm_weights,
+    ngraph::Output<ngraph::Node> input_layer_norm_weights, forget_layer_norm_weights,
         cell_layer_norm_weights, output_layer_norm_weights;
 
     if (isLayerNormUsed) {
@@ -320,21 +388,35 @@ std::shared_ptr<ngraph::Node> LSTM::createNode() {
         H = mul(o_t, applyActivation(C, activationFn));
     }
 
-    std::vector<std::shared_ptr<ngraph::Node>> LstmOutputs(4, nullptr);
-    LstmOutputs[0] = scratchBuffer;
-    LstmOutputs[1] = H;
-    LstmOutputs[2] = C;
-    LstmOutputs[3] = H;
+    setLstmOutputs({scratchBuffer, H, C, H});
+    return nullptr;
+}
 
+void LSTM::setLstmOutputs(const ngraph::OutputVector& LstmOutputs) {
     for (int i = 0; i < 4; i++) {
-        auto outputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, i);
+        auto outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, i);
         mNgraphNodes->setOutputAtOperandIndex(outputIndex, LstmOutputs[i]);
-        const auto op = sModelInfo->getOperand(outputIndex);
+        const auto& op = mModelInfo->getOperand(outputIndex);
         if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
             addResultNode(outputIndex, LstmOutputs[i]);
         }
     }
-    return nullptr;
+}
+
+bool LSTM::getCellActivationName(int activationFn, std::string& name) const {
+    switch (activationFn) {
+        case ACTIVATION_FUNCTION_RELU:
+            name = "relu";
+            return true;
+        case ACTIVATION_FUNCTION_TANH:
+            name = "tanh";
+            return true;
+        case ACTIVATION_FUNCTION_SIGMOID:
+            name = "sigmoid";
+            return true;
+        default:
+            return false;
+    }
 }
 
 std::shared_ptr<ngraph::Node> LSTM::add(const ngraph::Output<ngraph::Node>& lhs,
@@ -389,8 +471,8 @@ std::shared_ptr<ngraph::Node> LSTM::applyActivation(const std::shared_ptr<ngraph
 
 std::shared_ptr<ngraph::Node> LSTM::LayerNorm(
     const ngraph::Output<ngraph::Node>& input,
-    const std::shared_ptr<ngraph::Node>& normalizedweights,
-    const std::shared_ptr<ngraph::Node>& bias) {
+    const ngraph::Output<ngraph::Node>& normalizedweights,
+    const ngraph::Output<ngraph::Node>& bias) {
     // LayerNormalization
     auto normalizationConstant = createConstNode(ngraph::element::f32, {}, convertToVector(1e-8f));
     auto axis = ngraph::op::Constant::create(ngraph::element::i32, {}, {-1});
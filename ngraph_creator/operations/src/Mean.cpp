@@ -7,15 +7,16 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Mean::Mean(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Mean::Mean(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Mean::validate() {
     // TODO: Add Support for all_tensors_as_inputs
-    const auto& axesOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& axesOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
 
-    if (!sModelInfo->isOperandLifeTimeConst(axesOperandIndex)) {
+    if (!mModelInfo->isOperandLifeTimeConst(axesOperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
@@ -25,12 +26,12 @@ bool Mean::validate() {
 
 std::shared_ptr<ngraph::Node> Mean::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
 
     input = getInputNode(0);
 
     auto reduction_axes = getInputNode(1);
-    auto reduce_dims = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
+    auto reduce_dims = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
     bool keep_dims = (reduce_dims > 0) ? true : false;
 
     std::shared_ptr<ngraph::Node> outputNode;
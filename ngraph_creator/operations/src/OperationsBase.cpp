@@ -1,4 +1,6 @@
 #include <OperationsBase.hpp>
+#include <algorithm>
+#include <ngraph/runtime/shared_buffer.hpp>
 #undef LOG_TAG
 #define LOG_TAG "OperationsBase"
 
@@ -7,11 +9,62 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-IntelDeviceType OperationsBase::sPluginType;
-std::shared_ptr<NnapiModelInfo> OperationsBase::sModelInfo;
+namespace {
+// Returns the NCHW input of a NCHW->NHWC Transpose node, nullptr for any other node
+std::shared_ptr<ngraph::Node> getNchwSource(const std::shared_ptr<ngraph::Node>& node) {
+    auto transposeNode = ngraph::as_type_ptr<ngraph::opset3::Transpose>(node);
+    if (!transposeNode) return nullptr;
+    auto orderNode =
+        ngraph::as_type_ptr<ngraph::opset3::Constant>(transposeNode->get_input_node_shared_ptr(1));
+    if (!orderNode || orderNode->cast_vector<int64_t>() != std::vector<int64_t>{0, 2, 3, 1})
+        return nullptr;
+    auto source = transposeNode->get_input_node_shared_ptr(0);
+    if (source->get_output_size() != 1) return nullptr;
+    return source;
+}
+
+// Operations whose result doesn't depend on the layout of their inputs
+bool isLayoutAgnostic(OperationType type) {
+    switch (type) {
+        case OperationType::ABS:
+        case OperationType::ADD:
+        case OperationType::DIV:
+        case OperationType::EXP:
+        case OperationType::FLOOR:
+        case OperationType::HARD_SWISH:
+        case OperationType::LOG:
+        case OperationType::LOGISTIC:
+        case OperationType::MAXIMUM:
+        case OperationType::MINIMUM:
+        case OperationType::MUL:
+        case OperationType::NEG:
+        case OperationType::POW:
+        case OperationType::RELU:
+        case OperationType::RELU1:
+        case OperationType::RELU6:
+        case OperationType::RSQRT:
+        case OperationType::SIN:
+        case OperationType::SQRT:
+        case OperationType::SUB:
+        case OperationType::TANH:
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace
 
 std::shared_ptr<ngraph::Node> OperationsBase::transpose(ConversionType type,
                                                         ngraph::Output<ngraph::Node> input) {
+    if (type == NHWC_NCHW) {
+        // Transposing back a NCHW->NHWC Transpose is a no-op
+        auto source = getNchwSource(input.get_node_shared_ptr());
+        if (source) {
+            if (mNgraphNodes) mNgraphNodes->addElidedTranspose();
+            return source;
+        }
+    }
+
     ngraph::AxisVector order;
     switch (type) {
         case NHWC_NCHW:
@@ -62,13 +115,75 @@ std::shared_ptr<ngraph::Node> OperationsBase::transpose(ConversionType type,
     return std::make_shared<ngraph::opset3::Transpose>(input, order_node);
 }
 
-// override createNodeForPlugin in case sPluginType specific implementation is required
+// override createNodeForPlugin in case mPluginType specific implementation is required
 std::shared_ptr<ngraph::Node> OperationsBase::createNodeForPlugin() { return createNode(); }
 
+std::shared_ptr<ngraph::Node> OperationsBase::createNodeInNchw() {
+    if (!isLayoutAgnostic(mModelInfo->getOperationType(mNnapiOperationIndex))) return nullptr;
+    if (mModelInfo->getOperand(mDefaultOutputIndex).dimensions.size() != 4) return nullptr;
+
+    // Every tensor input has to be available in NCHW, or broadcast the same way in both layouts
+    std::vector<uint32_t> nchwInputs;
+    for (size_t i = 0; i < mModelInfo->getOperationInputsSize(mNnapiOperationIndex); i++) {
+        auto operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, i);
+        const auto& operand = mModelInfo->getOperand(operandIndex);
+        size_t elements = 1;
+        for (auto dimension : operand.dimensions) elements *= dimension;
+        if (mNgraphNodes->isForcedNchw(operandIndex)) {
+            if (std::find(nchwInputs.begin(), nchwInputs.end(), operandIndex) == nchwInputs.end())
+                nchwInputs.push_back(operandIndex);
+        } else if (!operand.dimensions.empty() && elements != 1) {
+            return nullptr;
+        }
+    }
+    if (nchwInputs.empty()) return nullptr;
+
+    std::vector<ngraph::Output<ngraph::Node>> nhwcOutputs;
+    for (auto operandIndex : nchwInputs) {
+        auto nhwcOutput = mNgraphNodes->getOperationOutput(operandIndex);
+        nhwcOutputs.push_back(nhwcOutput);
+        mNgraphNodes->setOutputAtOperandIndex(
+            operandIndex, getNchwSource(nhwcOutput.get_node_shared_ptr())->get_default_output());
+    }
+    std::shared_ptr<ngraph::Node> outputNode;
+    try {
+        outputNode = createNodeForPlugin();
+    } catch (...) {
+        for (size_t i = 0; i < nchwInputs.size(); i++)
+            mNgraphNodes->setOutputAtOperandIndex(nchwInputs[i], nhwcOutputs[i]);
+        throw;
+    }
+    for (size_t i = 0; i < nchwInputs.size(); i++)
+        mNgraphNodes->setOutputAtOperandIndex(nchwInputs[i], nhwcOutputs[i]);
+
+    mNgraphNodes->addNchwOperation();
+    return transpose(NCHW_NHWC, outputNode);
+}
+
 // override connectOperationToGraph in case Operation has multiple outputs
 void OperationsBase::connectOperationToGraph() {
-    auto outputNode = createNodeForPlugin();
-    const auto op = sModelInfo->getOperand(mDefaultOutputIndex);
+    auto outputNode = createNodeInNchw();
+    if (outputNode == nullptr) outputNode = createNodeForPlugin();
+    const auto& op = mModelInfo->getOperand(mDefaultOutputIndex);
+    // Model outputs still need the integer representation that is copied to the request memory
+    if (mLowPrecision && op.lifetime != OperandLifeTime::SUBGRAPH_OUTPUT &&
+        (op.type == OperandType::TENSOR_QUANT8_ASYMM ||
+         op.type == OperandType::TENSOR_QUANT8_ASYMM_SIGNED ||
+         op.type == OperandType::TENSOR_QUANT8_SYMM)) {
+        // FakeQuantize is per tensor, so it is applied before a NCHW->NHWC Transpose to keep it
+        // last for the consumers
+        auto nchwNode = getNchwSource(outputNode);
+        if (nchwNode) {
+            outputNode = transpose(NCHW_NHWC, FakeQuantizeNode(nchwNode, mDefaultOutputIndex));
+            mNgraphNodes->setForcedNchw(mDefaultOutputIndex);
+        } else {
+            outputNode = FakeQuantizeNode(outputNode, mDefaultOutputIndex);
+        }
+        mNgraphNodes->setOutputAtOperandIndex(mDefaultOutputIndex,
+                                              outputNode->get_default_output());
+        mNgraphNodes->setDequantizedOutput(mDefaultOutputIndex);
+        return;
+    }
     if (op.type == OperandType::TENSOR_QUANT8_ASYMM) {
         outputNode = QuantizeNode(outputNode, mDefaultOutputIndex, ngraph::element::u8);
     }
@@ -86,13 +201,35 @@ void OperationsBase::connectOperationToGraph() {
         addResultNode(mDefaultOutputIndex, outputNode);
     }
     mNgraphNodes->setOutputAtOperandIndex(mDefaultOutputIndex, outputNode->get_default_output());
+    if (getNchwSource(outputNode)) mNgraphNodes->setForcedNchw(mDefaultOutputIndex);
+}
+
+std::shared_ptr<ngraph::Node> OperationsBase::createSharedConstNode(
+    uint32_t operandIndex, const ngraph::element::Type& elementType, const ngraph::Shape& shape) {
+    uint32_t length;
+    const uint8_t* buffer = mModelInfo->GetOperandMemory(operandIndex, length);
+    const size_t expectedLength = ngraph::shape_size(shape) * elementType.size();
+    if (buffer == nullptr || length != expectedLength) {
+        ALOGE("%s Invalid memory for operand %d, length %d expected %zu", __func__, operandIndex,
+              length, expectedLength);
+        return nullptr;
+    }
+    auto sharedBuffer =
+        std::make_shared<ngraph::runtime::SharedBuffer<std::shared_ptr<NnapiModelInfo>>>(
+            reinterpret_cast<char*>(const_cast<uint8_t*>(buffer)), length, mModelInfo);
+    return std::make_shared<ngraph::opset3::Constant>(elementType, shape, sharedBuffer);
 }
 
-void OperationsBase::addResultNode(size_t index, std::shared_ptr<ngraph::Node> resultNode) {
-    mNgraphNodes->setResultNode(index, resultNode);
+void OperationsBase::addResultNode(size_t index, ngraph::Output<ngraph::Node> output) {
+    mNgraphNodes->setResultNode(index, output);
 }
 
-OperationsBase::OperationsBase(int operationIndex) : mNnapiOperationIndex(operationIndex) {
+OperationsBase::OperationsBase(int operationIndex, const GraphMetadata& graphMetadata)
+    : mNnapiOperationIndex(operationIndex),
+      mModelInfo(graphMetadata.modelInfo),
+      mPluginType(graphMetadata.pluginType),
+      mLowPrecision(graphMetadata.lowPrecision),
+      mNgraphNodes(graphMetadata.nodes) {
     mDefaultOutputIndex = 0;
 }
 
@@ -107,7 +244,7 @@ bool OperationsBase::validateForPlugin() {
 
 bool OperationsBase::checkOperandType(uint32_t operandIndex, const int32_t expectedOperandType,
                                       const std::string& strLogInfo) {
-    const auto operandType = (int32_t)sModelInfo->getOperandType(operandIndex);
+    const auto operandType = (int32_t)mModelInfo->getOperandType(operandIndex);
     if (operandType != expectedOperandType) {
         ALOGE("OperationIndex %d %s Index %d type %d invalid", mNnapiOperationIndex,
               strLogInfo.c_str(), operandIndex, operandType);
@@ -118,17 +255,16 @@ bool OperationsBase::checkOperandType(uint32_t operandIndex, const int32_t expec
     return true;
 }
 bool OperationsBase::checkOutputOperandType(uint32_t index, const int32_t expectedOperandType) {
-    const auto& operandIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, index);
+    const auto& operandIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, index);
     return checkOperandType(operandIndex, expectedOperandType, "Output");
 }
 bool OperationsBase::checkInputOperandType(uint32_t index, const int32_t expectedOperandType) {
-    const auto& operandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, index);
+    const auto& operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, index);
     return checkOperandType(operandIndex, expectedOperandType, "Input");
 }
-const vec<uint32_t> OperationsBase::getInputOperandDimensions(uint32_t inputIndex) {
-    const auto& operandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex);
-    const auto& operand = sModelInfo->getOperand(operandIndex);
-    return operand.dimensions;
+const OperandDimensions OperationsBase::getInputOperandDimensions(uint32_t inputIndex) {
+    const auto& operandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, inputIndex);
+    return mModelInfo->getOperandDimensions(operandIndex);
 }
 
 bool OperationsBase::isValidInputTensor(uint32_t inputIndex) {
@@ -143,19 +279,19 @@ bool OperationsBase::isValidInputTensor(uint32_t inputIndex) {
     return true;
 }
 
-std::shared_ptr<ngraph::Node> OperationsBase::QuantizeNode(std::shared_ptr<ngraph::Node> input,
+std::shared_ptr<ngraph::Node> OperationsBase::QuantizeNode(ngraph::Output<ngraph::Node> input,
                                                            size_t index,
                                                            ngraph::element::Type quantizeType) {
     auto floatElementType = ngraph::element::f32;
     auto intElementType = ngraph::element::i32;
 
-    float inputScale = sModelInfo->getOperandScale(index);
-    int inputZeroPoint = sModelInfo->getOperandZeroPoint(index);
+    float inputScale = mModelInfo->getOperandScale(index);
+    int inputZeroPoint = mModelInfo->getOperandZeroPoint(index);
 
     auto scale = createConstNode(floatElementType, {}, convertToVector(inputScale));
     auto zeroPoint = createConstNode(intElementType, {}, convertToVector(inputZeroPoint));
 
-    if (input->get_element_type() != ngraph::element::f32)
+    if (input.get_element_type() != ngraph::element::f32)
         input = std::make_shared<ngraph::opset3::Convert>(input, floatElementType);
     auto div = std::make_shared<ngraph::opset3::Divide>(input, scale);
     ngraph::op::v5::Round::RoundMode mode = ngraph::op::v5::Round::RoundMode::HALF_TO_EVEN;
@@ -163,7 +299,7 @@ std::shared_ptr<ngraph::Node> OperationsBase::QuantizeNode(std::shared_ptr<ngrap
     auto convertRound = std::make_shared<ngraph::opset3::Convert>(round, ngraph::element::i32);
     auto sum = std::make_shared<ngraph::opset3::Add>(convertRound, zeroPoint);
     std::shared_ptr<ngraph::Node> data;
-    const auto operand = sModelInfo->getOperand(index);
+    const auto& operand = mModelInfo->getOperand(index);
     if (operand.type == OperandType::TENSOR_QUANT8_ASYMM)
         data = std::make_shared<ngraph::opset3::Clamp>(sum, 0, 255);
     else if (operand.type == OperandType::TENSOR_QUANT8_SYMM ||
@@ -183,13 +319,35 @@ std::shared_ptr<ngraph::Node> OperationsBase::QuantizeNode(std::shared_ptr<ngrap
     return outputNode;
 }
 
-std::shared_ptr<ngraph::Node> OperationsBase::DequantizeNode(std::shared_ptr<ngraph::Node> input,
+std::shared_ptr<ngraph::Node> OperationsBase::FakeQuantizeNode(ngraph::Output<ngraph::Node> input,
+                                                               size_t index) {
+    const auto& operand = mModelInfo->getOperand(index);
+    const float scale = operand.scale;
+    const int32_t zeroPoint = operand.zeroPoint;
+    int32_t quantMin = -128, quantMax = 127;
+    if (operand.type == OperandType::TENSOR_QUANT8_ASYMM) {
+        quantMin = 0;
+        quantMax = 255;
+    }
+
+    if (input.get_element_type() != ngraph::element::f32)
+        input = std::make_shared<ngraph::opset3::Convert>(input, ngraph::element::f32);
+
+    auto lowNode = createConstNode(ngraph::element::f32, {},
+                                   convertToVector(scale * (quantMin - zeroPoint)));
+    auto highNode = createConstNode(ngraph::element::f32, {},
+                                    convertToVector(scale * (quantMax - zeroPoint)));
+    return std::make_shared<ngraph::opset3::FakeQuantize>(input, lowNode, highNode, lowNode,
+                                                          highNode, quantMax - quantMin + 1);
+}
+
+std::shared_ptr<ngraph::Node> OperationsBase::DequantizeNode(ngraph::Output<ngraph::Node> input,
                                                              uint32_t index,
                                                              ngraph::element::Type dequantizeType) {
-    const auto operand = sModelInfo->getOperand(index);
+    const auto& operand = mModelInfo->getOperand(index);
     std::shared_ptr<ngraph::Node> outputNode;
 
-    if (input->get_element_type() != ngraph::element::f32)
+    if (input.get_element_type() != ngraph::element::f32)
         input = std::make_shared<ngraph::opset3::Convert>(input, ngraph::element::f32);
 
     if (operand.type == OperandType::TENSOR_QUANT8_SYMM_PER_CHANNEL) {
@@ -204,9 +362,9 @@ std::shared_ptr<ngraph::Node> OperationsBase::DequantizeNode(std::shared_ptr<ngr
         outputNode = std::make_shared<ngraph::opset3::Multiply>(input, scaleNode);
     } else {
         auto scaleNode = createConstNode(ngraph::element::f32, {},
-                                         convertToVector(sModelInfo->getOperandScale(index)));
+                                         convertToVector(mModelInfo->getOperandScale(index)));
         auto zeroPointNode = createConstNode(
-            ngraph::element::f32, {}, convertToVector(sModelInfo->getOperandZeroPoint(index)));
+            ngraph::element::f32, {}, convertToVector(mModelInfo->getOperandZeroPoint(index)));
 
         if (operand.type == OperandType::TENSOR_QUANT8_ASYMM ||
             operand.type == OperandType::TENSOR_QUANT16_ASYMM ||
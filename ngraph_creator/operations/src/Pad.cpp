@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Pad::Pad(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Pad::Pad(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Pad::validate() {
@@ -20,9 +21,9 @@ bool Pad::validate() {
     if (inputRank < 2) return false;
 
     // TODO: Add Support for all_tensors_as_inputs
-    const auto& padOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& padOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
 
-    if (!sModelInfo->isOperandLifeTimeConst(padOperandIndex)) {
+    if (!mModelInfo->isOperandLifeTimeConst(padOperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
@@ -34,9 +35,9 @@ std::shared_ptr<ngraph::Node> Pad::createNode() {
     // Creating input nodes
     auto inputNode = getInputNode(0);
 
-    const auto& paddingsOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& paddingsOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
     // Fetch the 2D paddings as a 1D vector, and then split it into 2
-    auto paddings_2d = sModelInfo->GetConstVecOperand<int32_t>(paddingsOperandIndex);
+    auto paddings_2d = mModelInfo->GetConstVecOperand<int32_t>(paddingsOperandIndex);
     auto half_size = paddings_2d.size() / 2;
     std::vector<int32_t> paddings_0(half_size);
     std::vector<int32_t> paddings_1(half_size);
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-PadV2::PadV2(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+PadV2::PadV2(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool PadV2::validate() {
@@ -20,9 +21,9 @@ bool PadV2::validate() {
     if (inputRank < 2) return false;
 
     // TODO: Add Support for all_tensors_as_inputs
-    const auto& padOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& padOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
 
-    if (!sModelInfo->isOperandLifeTimeConst(padOperandIndex)) {
+    if (!mModelInfo->isOperandLifeTimeConst(padOperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
@@ -34,17 +35,17 @@ std::shared_ptr<ngraph::Node> PadV2::createNode() {
     // Creating input nodes
     auto inputNode = getInputNode(0);
     std::shared_ptr<ngraph::Node> pad_value;
-    auto inputIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 0);
+    auto inputIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 0);
 
     if (checkInputOperandType(0, (int32_t)OperandType::TENSOR_FLOAT32)) {
-        auto pad_scalar_value = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 2);
+        auto pad_scalar_value = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 2);
         pad_value = createConstNode(ngraph::element::f32, {}, convertToVector(pad_scalar_value));
     } else if (checkInputOperandType(0, (int32_t)OperandType::TENSOR_FLOAT16)) {
-        auto pad_scalar_value = sModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 2);
+        auto pad_scalar_value = mModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 2);
         pad_value = createConstNode(ngraph::element::f16, {}, convertToVector(pad_scalar_value));
     } else if (checkInputOperandType(0, (int32_t)OperandType::TENSOR_QUANT8_ASYMM) ||
                checkInputOperandType(0, (int32_t)OperandType::TENSOR_QUANT8_ASYMM_SIGNED)) {
-        auto pad_scalar_value = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
+        auto pad_scalar_value = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
         pad_value = createConstNode(ngraph::element::i32, {}, convertToVector(pad_scalar_value));
 
         // scale and zeropoint of pad value has to be same as in inputNode. so inputIndex is passed
@@ -52,9 +53,9 @@ std::shared_ptr<ngraph::Node> PadV2::createNode() {
         pad_value = DequantizeNode(pad_value, inputIndex, ngraph::element::f32);
     }
 
-    const auto& paddingsOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& paddingsOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
     // Fetch the 2D paddings as a 1D vector, and then split it into 2
-    auto paddings_2d = sModelInfo->GetConstVecOperand<int32_t>(paddingsOperandIndex);
+    auto paddings_2d = mModelInfo->GetConstVecOperand<int32_t>(paddingsOperandIndex);
     auto half_size = paddings_2d.size() / 2;
     std::vector<int32_t> paddings_0(half_size);
     std::vector<int32_t> paddings_1(half_size);
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Quantize::Quantize(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Quantize::Quantize(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 void Quantize::connectOperationToGraph() { createNode(); }
@@ -16,11 +17,11 @@ void Quantize::connectOperationToGraph() { createNode(); }
 std::shared_ptr<ngraph::Node> Quantize::createNode() {
     // Creating input nodes
     auto input = getInputNode(0);
-    const auto& outputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+    const auto& outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
     auto outputNode = QuantizeNode(input, outputIndex, ngraph::element::u8);
 
     mNgraphNodes->setOutputAtOperandIndex(outputIndex, outputNode);
-    const auto op = sModelInfo->getOperand(outputIndex);
+    const auto& op = mModelInfo->getOperand(outputIndex);
     if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
         addResultNode(mDefaultOutputIndex, outputNode);
     }
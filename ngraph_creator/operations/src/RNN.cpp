@@ -9,15 +9,16 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-RNN::RNN(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+RNN::RNN(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 void RNN::connectOperationToGraph() { createNode(); }
 
 std::shared_ptr<ngraph::Node> RNN::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input, W, R, bias, initial_hidden_state;
+    ngraph::Output<ngraph::Node> input, W, R, bias, initial_hidden_state;
 
     input = getInputNode(0);
     W = getInputNode(1);
@@ -25,7 +26,7 @@ std::shared_ptr<ngraph::Node> RNN::createNode() {
     bias = getInputNode(3);
     initial_hidden_state = getInputNode(4);
 
-    auto activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+    auto activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
 
     // inputs * input_weights
     auto input_W = std::make_shared<ngraph::opset3::MatMul>(input, W, false, true);
@@ -38,25 +39,15 @@ std::shared_ptr<ngraph::Node> RNN::createNode() {
 
     auto outputNode = applyActivation(i_t, activationFn);
 
+    // hidden_state_out, the state fed back as hidden_state_in of the next step, and output hold
+    // the same values. Both Results read the one node, so both operands get the same IE output.
     for (int i = 0; i < 2; i++) {
-        auto outputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, i);
-        std::shared_ptr<ngraph::Node> outNode;
-        if (i == 1) {
-            outNode = outputNode;
-        } else {
-            // TODO: Implement properly
-            // Creating a dummy node with same size as outputNode, initialized to 0
-            // and then multiplying with outputNode so that it gets connected to the graph
-            outNode = createConstNode(outputNode->get_element_type(), outputNode->get_shape(),
-                                      convertToVector(0));
-            outNode = std::make_shared<ngraph::opset3::Multiply>(outNode, outputNode);
-        }
-
-        mNgraphNodes->setOutputAtOperandIndex(outputIndex, outNode);
+        auto outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, i);
+        mNgraphNodes->setOutputAtOperandIndex(outputIndex, outputNode);
         ALOGD("%s Set Output index %d", __func__, outputIndex);
-        const auto op = sModelInfo->getOperand(outputIndex);
+        const auto& op = mModelInfo->getOperand(outputIndex);
         if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
-            addResultNode(outputIndex, outNode);
+            addResultNode(outputIndex, outputNode);
             ALOGD("%s Add result %d", __func__, outputIndex);
         }
     }
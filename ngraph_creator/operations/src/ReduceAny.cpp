@@ -7,15 +7,16 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-ReduceAny::ReduceAny(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+ReduceAny::ReduceAny(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> ReduceAny::createNode() {
     // Creating input nodes
     auto input = getInputNode(0);
     auto reduction_axes = getInputNode(1);
-    auto keep_dims = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
+    auto keep_dims = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
 
     auto outputNode =
         std::make_shared<ngraph::opset3::ReduceLogicalOr>(input, reduction_axes, keep_dims);
@@ -7,18 +7,19 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-ReduceMin::ReduceMin(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+ReduceMin::ReduceMin(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> ReduceMin::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
 
     input = getInputNode(0);
 
     auto reduction_axes = getInputNode(1);
-    auto keep_dims = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
+    auto keep_dims = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
 
     std::shared_ptr<ngraph::Node> outputNode;
     outputNode = std::make_shared<ngraph::opset3::ReduceMin>(input, reduction_axes, keep_dims);
@@ -7,13 +7,14 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Reshape::Reshape(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Reshape::Reshape(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Reshape::validate() {
-    const auto& dimsOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-    if (!sModelInfo->isOperandLifeTimeConst(dimsOperandIndex) || !isValidInputTensor(1)) {
+    const auto& dimsOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    if (!mModelInfo->isOperandLifeTimeConst(dimsOperandIndex) || !isValidInputTensor(1)) {
         // TODO: Support CPU_reshape_all_tensors_as_inputs
         ALOGE("%s Only Constant non-zero dimensions supported now", __func__);
         return false;
@@ -23,10 +24,10 @@ bool Reshape::validate() {
 }
 
 std::shared_ptr<ngraph::Node> Reshape::createNode() {
-    const auto& dimsOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-    auto outDims = sModelInfo->GetConstVecOperand<int32_t>(dimsOperandIndex);
+    const auto& dimsOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    auto outDims = mModelInfo->GetConstVecOperand<int32_t>(dimsOperandIndex);
     VLOGDIMS(L3, outDims, "Reshape::createNode dims");
-    std::shared_ptr<ngraph::Node> inputOp;
+    ngraph::Output<ngraph::Node> inputOp;
     inputOp = getInputNode(0);
 
     const auto& inDims = getInputOperandDimensions(0);
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-ResizeNearestNeighbor::ResizeNearestNeighbor(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+ResizeNearestNeighbor::ResizeNearestNeighbor(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool ResizeNearestNeighbor::validate() {
@@ -22,7 +23,7 @@ bool ResizeNearestNeighbor::validate() {
 }
 
 std::shared_ptr<ngraph::Node> ResizeNearestNeighbor::createNode() {
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
 
     std::shared_ptr<ngraph::Node> outputNode;
     int32_t input_width = 0, input_height = 0;
@@ -33,19 +34,19 @@ std::shared_ptr<ngraph::Node> ResizeNearestNeighbor::createNode() {
     const auto& inputDimensions = getInputOperandDimensions(0);
     int32_t out_width = 0, out_height = 0;
 
-    std::shared_ptr<ngraph::Node> inputNode;
+    ngraph::Output<ngraph::Node> inputNode;
     struct ngraph::op::v4::Interpolate::InterpolateAttrs attrs;
 
     inputNode = getInputNode(0);
     switch (inputsSize) {
         case 6:
-            half_pixel = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 5);
+            half_pixel = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 5);
             __attribute__((fallthrough));
         case 5:
-            align_corners = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 4);
+            align_corners = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 4);
             __attribute__((fallthrough));
         case 4:
-            layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 3);
+            layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 3);
             __attribute__((fallthrough));
         default:
             break;
@@ -70,18 +71,18 @@ std::shared_ptr<ngraph::Node> ResizeNearestNeighbor::createNode() {
     if (checkInputOperandType(1, (int32_t)OperandType::FLOAT32)) {
         // In tensorflow lite, resizing by size is supported. Scaling factors are
         // calculated based on output shape.
-        width_scale = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 1);
-        height_scale = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 2);
+        width_scale = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 1);
+        height_scale = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 2);
         out_width = (int)(input_width * width_scale);
         out_height = (int)(input_height * height_scale);
     } else if (checkInputOperandType(1, (int32_t)OperandType::FLOAT16)) {
-        width_scale = sModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 1);
-        height_scale = sModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 2);
+        width_scale = mModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 1);
+        height_scale = mModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 2);
         out_width = (int)(input_width * width_scale);
         out_height = (int)(input_height * height_scale);
     } else if (checkInputOperandType(1, (int32_t)OperandType::INT32)) {
-        out_width = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
-        out_height = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
+        out_width = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
+        out_height = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
     }
     width_scale = (float)out_width / (float)input_width;
     height_scale = (float)out_height / (float)input_height;
@@ -7,13 +7,14 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Select::Select(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Select::Select(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Select::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input1, input2, input3;
+    ngraph::Output<ngraph::Node> input1, input2, input3;
 
     input1 = getInputNode(0);
     input2 = getInputNode(1);
@@ -7,28 +7,30 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Softmax::Softmax(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Softmax::Softmax(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> Softmax::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input, outputNode;
+    ngraph::Output<ngraph::Node> input;
+    std::shared_ptr<ngraph::Node> outputNode;
 
     input = getInputNode(0);
 
     std::shared_ptr<ngraph::Node> betaNode;
 
     if (checkInputOperandType(0, (int32_t)OperandType::TENSOR_FLOAT16)) {
-        auto beta = sModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 1);
+        auto beta = mModelInfo->ParseOperationInput<_Float16>(mNnapiOperationIndex, 1);
         betaNode = createConstNode(ngraph::element::f16, {1}, convertToVector(beta));
     } else {
-        auto beta = sModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 1);
+        auto beta = mModelInfo->ParseOperationInput<float>(mNnapiOperationIndex, 1);
         betaNode = createConstNode(ngraph::element::f32, {1}, convertToVector(beta));
     }
     int axis = -1;
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
-    if (inputsSize == 3) axis = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    if (inputsSize == 3) axis = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 2);
 
     const auto axisNode = createConstNode(ngraph::element::i32, {1}, convertToVector(axis));
 
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-SpaceToBatch::SpaceToBatch(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+SpaceToBatch::SpaceToBatch(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool SpaceToBatch::validate() {
@@ -17,16 +18,16 @@ bool SpaceToBatch::validate() {
 
     if (inputRank != 4) return false;
 
-    auto& block_shape_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    auto& block_shape_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
     // TODO: Add Support for all_tensors_as_inputs
-    if (!sModelInfo->isOperandLifeTimeConst(block_shape_OperandIndex)) {
+    if (!mModelInfo->isOperandLifeTimeConst(block_shape_OperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
 
-    auto pad_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 2);
+    auto pad_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 2);
     // TODO: Add Support for all_tensors_as_inputs
-    if (!sModelInfo->isOperandLifeTimeConst(pad_OperandIndex)) {
+    if (!mModelInfo->isOperandLifeTimeConst(pad_OperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
@@ -38,22 +39,22 @@ bool SpaceToBatch::validate() {
 std::shared_ptr<ngraph::Node> SpaceToBatch::createNode() {
     int32_t layout = 0;
     bool useNchw = false;
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
 
     auto inputNode = getInputNode(0);
 
     auto& inDims = getInputOperandDimensions(0);
 
-    const auto& block_shape_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-    auto block_shape = sModelInfo->GetConstVecOperand<int32_t>(block_shape_OperandIndex);
+    const auto& block_shape_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    auto block_shape = mModelInfo->GetConstVecOperand<int32_t>(block_shape_OperandIndex);
 
     // Compensation for the shape to be same as the size of data input shape
     block_shape.insert(block_shape.begin(), 1);
     block_shape.insert(block_shape.begin(), 1);
 
-    const auto& pad_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 2);
+    const auto& pad_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 2);
     // Fetch the 2D pad as a 1D vector, and then split it into 2
-    auto pad_2d = sModelInfo->GetConstVecOperand<int32_t>(pad_OperandIndex);
+    auto pad_2d = mModelInfo->GetConstVecOperand<int32_t>(pad_OperandIndex);
     auto half_size = pad_2d.size() / 2;
     std::vector<int32_t> pad_0(half_size);
     std::vector<int32_t> pad_1(half_size);
@@ -75,7 +76,7 @@ std::shared_ptr<ngraph::Node> SpaceToBatch::createNode() {
     const auto pad_begin = createConstNode(ngraph::element::i64, {inDims.size()}, pad_0);
     const auto pad_end = createConstNode(ngraph::element::i64, {inDims.size()}, pad_1);
 
-    if (inputsSize == 4) layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 3);
+    if (inputsSize == 4) layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 3);
     if (layout) useNchw = true;
 
     if (!useNchw)  // No conversion needed if useNchw set
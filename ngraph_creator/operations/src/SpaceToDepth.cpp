@@ -7,24 +7,25 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-SpaceToDepth::SpaceToDepth(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+SpaceToDepth::SpaceToDepth(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 std::shared_ptr<ngraph::Node> SpaceToDepth::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
     bool useNchw = false;
 
-    const auto& inputsSize = sModelInfo->getOperationInputsSize(mNnapiOperationIndex);
+    const auto& inputsSize = mModelInfo->getOperationInputsSize(mNnapiOperationIndex);
 
     if (inputsSize == 3) {
-        auto layout = sModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
+        auto layout = mModelInfo->ParseOperationInput<uint8_t>(mNnapiOperationIndex, 2);
         if (layout) useNchw = true;
     }
 
     input = getInputNode(0);
-    auto block_size = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 1);
+    auto block_size = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 1);
 
     if (!useNchw)  // No conversion needed if useNchw set
         input = transpose(NHWC_NCHW, input);
@@ -7,19 +7,20 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Squeeze::Squeeze(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Squeeze::Squeeze(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Squeeze::validate() {
     // TODO: Add Support for all_tensors_as_inputs
-    const auto& dimsOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& dimsOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
 
     // TODO: Support OmittedInput.
     // The empty 2nd argument in Squeeze op causes dynamic output
     // To add support, the dims will have to be calculated statically
-    if (sModelInfo->isOmittedInput(mNnapiOperationIndex, 1) ||
-        !sModelInfo->isOperandLifeTimeConst(dimsOperandIndex)) {
+    if (mModelInfo->isOmittedInput(mNnapiOperationIndex, 1) ||
+        !mModelInfo->isOperandLifeTimeConst(dimsOperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
@@ -29,13 +30,13 @@ bool Squeeze::validate() {
 
 std::shared_ptr<ngraph::Node> Squeeze::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
 
     input = getInputNode(0);
 
-    std::shared_ptr<ngraph::Node> dims;
+    ngraph::Output<ngraph::Node> dims;
 
-    if (!sModelInfo->isOmittedInput(mNnapiOperationIndex, 1))
+    if (!mModelInfo->isOmittedInput(mNnapiOperationIndex, 1))
         dims = getInputNode(1);
     else
         dims = createConstNode(ngraph::element::i32, {0}, std::vector<int64_t>{});
@@ -7,8 +7,9 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-StridedSlice::StridedSlice(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+StridedSlice::StridedSlice(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool StridedSlice::validate() {
@@ -20,31 +21,31 @@ bool StridedSlice::validate() {
     }
 
     // TODO: Add Support for all_tensors_as_inputs
-    auto& begins_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
-    if (!sModelInfo->isOperandLifeTimeConst(begins_OperandIndex)) {
+    auto& begins_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    if (!mModelInfo->isOperandLifeTimeConst(begins_OperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
 
-    auto ends_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 2);
-    if (!sModelInfo->isOperandLifeTimeConst(ends_OperandIndex)) {
+    auto ends_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 2);
+    if (!mModelInfo->isOperandLifeTimeConst(ends_OperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
 
-    auto& strides_OperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 3);
-    if (!sModelInfo->isOperandLifeTimeConst(strides_OperandIndex)) {
+    auto& strides_OperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 3);
+    if (!mModelInfo->isOperandLifeTimeConst(strides_OperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
 
-    auto shrink_axis_mask = sModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 6);
+    auto shrink_axis_mask = mModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 6);
     std::vector<int64_t> shrink_axis_mask_bits = getMaskBits(shrink_axis_mask, inputRank);
 
     for (int i = 0; i < inputRank; i++) {
         if (shrink_axis_mask_bits[i]) {
             // Check for negative stride when shrink axis bit is set
-            auto stridesVector = sModelInfo->GetConstVecOperand<int32_t>(strides_OperandIndex);
+            auto stridesVector = mModelInfo->GetConstVecOperand<int32_t>(strides_OperandIndex);
             if (stridesVector[i] < 0) {
                 ALOGE("%s Negative stride value when shrink axis bit set is not supported",
                       __func__);
@@ -52,8 +53,8 @@ bool StridedSlice::validate() {
             }
 
             // check for slice size larger than expected output
-            auto beginVector = sModelInfo->GetConstVecOperand<int32_t>(begins_OperandIndex);
-            auto endVector = sModelInfo->GetConstVecOperand<int32_t>(ends_OperandIndex);
+            auto beginVector = mModelInfo->GetConstVecOperand<int32_t>(begins_OperandIndex);
+            auto endVector = mModelInfo->GetConstVecOperand<int32_t>(ends_OperandIndex);
             if (((beginVector[i] - endVector[i]) > 1) || ((beginVector[i] - endVector[i]) < -1)) {
                 ALOGE("%s Trying to access invalid slice size when shrink axis bit is set",
                       __func__);
@@ -67,14 +68,14 @@ bool StridedSlice::validate() {
 
 std::shared_ptr<ngraph::Node> StridedSlice::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> data = getInputNode(0);
-    std::shared_ptr<ngraph::Node> begin = getInputNode(1);
-    std::shared_ptr<ngraph::Node> end = getInputNode(2);
-    std::shared_ptr<ngraph::Node> strides = getInputNode(3);
-
-    auto begin_mask = sModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 4);
-    auto end_mask = sModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 5);
-    auto shrink_axis_mask = sModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 6);
+    ngraph::Output<ngraph::Node> data = getInputNode(0);
+    ngraph::Output<ngraph::Node> begin = getInputNode(1);
+    ngraph::Output<ngraph::Node> end = getInputNode(2);
+    ngraph::Output<ngraph::Node> strides = getInputNode(3);
+
+    auto begin_mask = mModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 4);
+    auto end_mask = mModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 5);
+    auto shrink_axis_mask = mModelInfo->ParseOperationInput<int32_t>(mNnapiOperationIndex, 6);
 
     const auto data_dim_size = getInputOperandDimensions(0).size();
     std::vector<int64_t> begin_mask_bits, end_mask_bits, shrink_axis_mask_bits;
@@ -7,19 +7,20 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-TopkV2::TopkV2(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+TopkV2::TopkV2(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 void TopkV2::connectOperationToGraph() { createNode(); }
 
 std::shared_ptr<ngraph::Node> TopkV2::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
 
     input = getInputNode(0);
 
-    auto k = sModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
+    auto k = mModelInfo->ParseOperationInput<int>(mNnapiOperationIndex, 1);
     int axis = -1;  // to find largest entries for the last dimension.
 
     auto k_node = createConstNode(ngraph::element::i32, {}, convertToVector(k));
@@ -30,31 +31,17 @@ std::shared_ptr<ngraph::Node> TopkV2::createNode() {
     auto outputNode = topk->outputs();
 
     for (int i = 0; i < 2; i++) {
-        auto outputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, i);
-        // TODO: remove this dummy convert
-        std::shared_ptr<ngraph::Node> outNode;
-        if (checkOutputOperandType(i, (int32_t)OperandType::TENSOR_FLOAT32)) {
-            outNode =
-                std::make_shared<ngraph::opset3::Convert>(outputNode[i], ngraph::element::f32);
-        } else if (checkOutputOperandType(i, (int32_t)OperandType::TENSOR_FLOAT16)) {
-            outNode =
-                std::make_shared<ngraph::opset3::Convert>(outputNode[i], ngraph::element::f16);
-        } else if (checkOutputOperandType(i, (int32_t)OperandType::TENSOR_INT32)) {
-            outNode =
-                std::make_shared<ngraph::opset3::Convert>(outputNode[i], ngraph::element::i32);
-        } else if (checkOutputOperandType(i, (int32_t)OperandType::TENSOR_QUANT8_ASYMM)) {
-            outNode =
-                std::make_shared<ngraph::opset3::Convert>(outputNode[i], ngraph::element::f32);
+        auto outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, i);
+        ngraph::Output<ngraph::Node> outNode = outputNode[i];
+        if (checkOutputOperandType(i, (int32_t)OperandType::TENSOR_QUANT8_ASYMM)) {
             outNode = QuantizeNode(outNode, outputIndex, ngraph::element::u8);
         } else if (checkOutputOperandType(i, (int32_t)OperandType::TENSOR_QUANT8_ASYMM_SIGNED)) {
-            outNode =
-                std::make_shared<ngraph::opset3::Convert>(outputNode[i], ngraph::element::f32);
             outNode = QuantizeNode(outNode, outputIndex, ngraph::element::i8);
         }
 
         mNgraphNodes->setOutputAtOperandIndex(outputIndex, outNode);
         ALOGD("%s Set Output index %d", __func__, outputIndex);
-        const auto op = sModelInfo->getOperand(outputIndex);
+        const auto& op = mModelInfo->getOperand(outputIndex);
         if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
             addResultNode(outputIndex, outNode);
             ALOGD("%s Add result %d", __func__, outputIndex);
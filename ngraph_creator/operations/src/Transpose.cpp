@@ -7,15 +7,16 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-Transpose::Transpose(int operationIndex) : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+Transpose::Transpose(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 bool Transpose::validate() {
     // TODO: Add Support for all_tensors_as_inputs
-    const auto& dimsOperandIndex = sModelInfo->getOperationInput(mNnapiOperationIndex, 1);
+    const auto& dimsOperandIndex = mModelInfo->getOperationInput(mNnapiOperationIndex, 1);
     const auto& dims = getInputOperandDimensions(1);
-    if (!dims.empty() && dims[0] != 0 && !sModelInfo->isOperandLifeTimeConst(dimsOperandIndex)) {
+    if (!dims.empty() && dims[0] != 0 && !mModelInfo->isOperandLifeTimeConst(dimsOperandIndex)) {
         ALOGE("%s Only Constant dimensions supported now", __func__);
         return false;
     }
@@ -25,11 +26,11 @@ bool Transpose::validate() {
 
 std::shared_ptr<ngraph::Node> Transpose::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> input;
+    ngraph::Output<ngraph::Node> input;
 
     input = getInputNode(0);
 
-    std::shared_ptr<ngraph::Node> order;
+    ngraph::Output<ngraph::Node> order;
 
     const auto& dims = getInputOperandDimensions(1);
     if (!dims.empty() && dims[0] != 0) {
@@ -9,16 +9,17 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
-UnidirectionalSequenceRNN::UnidirectionalSequenceRNN(int operationIndex)
-    : OperationsBase(operationIndex) {
-    mDefaultOutputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+UnidirectionalSequenceRNN::UnidirectionalSequenceRNN(int operationIndex,
+                                                     const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
 }
 
 void UnidirectionalSequenceRNN::connectOperationToGraph() { createNode(); }
 
 std::shared_ptr<ngraph::Node> UnidirectionalSequenceRNN::createNode() {
     // Creating input nodes
-    std::shared_ptr<ngraph::Node> inputNode, W, R, bias, initial_hidden_state, outputNode;
+    ngraph::Output<ngraph::Node> inputNode, W, R, bias, initial_hidden_state;
 
     inputNode = getInputNode(0);
     W = getInputNode(1);
@@ -26,80 +27,43 @@ std::shared_ptr<ngraph::Node> UnidirectionalSequenceRNN::createNode() {
     bias = getInputNode(3);
     initial_hidden_state = getInputNode(4);
 
-    auto activationFn = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
-    auto isTimeMajor = sModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
+    auto activationFn = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 5);
+    auto isTimeMajor = mModelInfo->ParseOperationInput<uint32_t>(mNnapiOperationIndex, 6);
 
     if (!isTimeMajor) {
         inputNode = transpose(BTS_TBS, inputNode);
     }
 
-    const auto& inDims = getInputOperandDimensions(0);
-    uint32_t maxTime;
+    // The input projection of every timestep is computed at once, (inputs * input_weights) +
+    // bias for [maxTime, batchSize, inputSize] inputs, only the recurrence is iterated
+    auto inputProjection = std::make_shared<ngraph::opset3::Add>(
+        std::make_shared<ngraph::opset3::MatMul>(inputNode, W, false, true), bias);
 
-    if (isTimeMajor) {
-        maxTime = inDims[0];
-    } else {
-        maxTime = inDims[1];
-    }
-
-    auto axisNode = createConstNode(ngraph::element::i32, {}, convertToVector(0));
-    auto numSplits = maxTime;
-
-    auto inputSplit =
-        std::make_shared<ngraph::opset3::Split>(inputNode, axisNode, numSplits)->outputs();
-
-    std::vector<std::shared_ptr<ngraph::Node>> output_at_each_timestep;
-    std::shared_ptr<ngraph::Node> hidden_state_output_last_timestep;
-
-    for (uint32_t i = 0; i < maxTime; i++) {
-        auto dims = createConstNode(ngraph::element::i32, {0}, std::vector<int64_t>{});
-        inputSplit[i] = std::make_shared<ngraph::opset3::Squeeze>(inputSplit[i], dims);
-        // inputs * input_weights
-        auto input_W = std::make_shared<ngraph::opset3::MatMul>(inputSplit[i], W, false, true);
-        // state * recurrent_weights
-        auto Ht_R = std::make_shared<ngraph::opset3::MatMul>(initial_hidden_state, R, false, true);
-        // (state * recurrent_weights) + bias
-        auto add = std::make_shared<ngraph::opset3::Add>(Ht_R, bias);
-        // (inputs * input_weights) + (state * recurrent_weights) + bias
-        auto i_t = std::make_shared<ngraph::opset3::Add>(input_W, add);
-        // activation((inputs * input_weights) + (state * recurrent_weights) + bias)
-        auto outNode = applyActivation(i_t, activationFn);
-
-        initial_hidden_state = outNode;
-        output_at_each_timestep.push_back(outNode);
-        if (i == maxTime - 1) hidden_state_output_last_timestep = outNode;
-    }
-
-    outputNode = std::make_shared<ngraph::opset3::Concat>(output_at_each_timestep, 0);
-    std::vector<uint32_t> shape;
-    auto output_batch = outputNode->get_shape()[0] / maxTime;
-    shape.push_back(maxTime);
-    shape.push_back(output_batch);
-    shape.push_back(outputNode->get_shape()[1]);
+    auto sequence =
+        createRnnSequence(inputProjection, initial_hidden_state, R, activationFn, false);
+    ngraph::Output<ngraph::Node> outputNode = sequence.first;
+    const auto& hidden_state_output_last_timestep = sequence.second;
 
-    auto shapeNode =
-        createConstNode(ngraph::element::i32, ngraph::Shape{inputNode->get_shape().size()}, shape);
-    outputNode = std::make_shared<ngraph::opset3::Reshape>(outputNode, shapeNode, false);
     if (!isTimeMajor) {
         outputNode = transpose(BTS_TBS, outputNode);
     }
 
-    const auto& outputsSize = sModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
+    const auto& outputsSize = mModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
 
-    auto outputIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+    auto outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
     mNgraphNodes->setOutputAtOperandIndex(outputIndex, outputNode);
     ALOGD("%s Set Output index %d", __func__, outputIndex);
-    const auto op = sModelInfo->getOperand(outputIndex);
+    const auto& op = mModelInfo->getOperand(outputIndex);
     if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
         addResultNode(outputIndex, outputNode);
         ALOGD("%s Add result %d", __func__, outputIndex);
     }
 
     if (outputsSize == 2) {
-        auto hiddenStateIndex = sModelInfo->getOperationOutput(mNnapiOperationIndex, 1);
+        auto hiddenStateIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 1);
         mNgraphNodes->setOutputAtOperandIndex(hiddenStateIndex, hidden_state_output_last_timestep);
         ALOGD("%s Set Output index %d", __func__, hiddenStateIndex);
-        const auto hsOp = sModelInfo->getOperand(hiddenStateIndex);
+        const auto& hsOp = mModelInfo->getOperand(hiddenStateIndex);
         if (hsOp.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
             addResultNode(hiddenStateIndex, hidden_state_output_last_timestep);
             ALOGD("%s Add result %d", __func__, hiddenStateIndex);
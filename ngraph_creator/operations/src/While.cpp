@@ -0,0 +1,191 @@
+#include <While.hpp>
+#include <NgraphNetworkCreator.hpp>
+#include <algorithm>
+#include <ngraph/opsets/opset5.hpp>
+#include <stdexcept>
+#undef LOG_TAG
+#define LOG_TAG "While"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+// Inputs 0: condition model, 1: body model, 2 ~ (m + k + n + 1): the m output values and k state
+// values carried across iterations, then the n values only read by the models. The body model
+// returns the m + k carried values, the operation outputs are the final m output values.
+constexpr uint32_t kFirstLoopInput = 2;
+
+namespace {
+bool hasStaticShape(const Operand& operand) {
+    return operand.dimensions.size() > 0 &&
+           std::find(operand.dimensions.begin(), operand.dimensions.end(), 0) ==
+               operand.dimensions.end();
+}
+
+bool isSameTensor(const Operand& a, const Operand& b) {
+    return a.type == b.type && a.dimensions == b.dimensions;
+}
+
+// The representation getInputNode returns without dequantizing
+ngraph::element::Type getElementType(OperandType type) {
+    switch (type) {
+        case OperandType::TENSOR_FLOAT32:
+            return ngraph::element::f32;
+        case OperandType::TENSOR_INT32:
+            return ngraph::element::i32;
+        case OperandType::TENSOR_BOOL8:
+            return ngraph::element::boolean;
+        case OperandType::TENSOR_QUANT8_ASYMM:
+            return ngraph::element::u8;
+        case OperandType::TENSOR_QUANT8_SYMM:
+        case OperandType::TENSOR_QUANT8_ASYMM_SIGNED:
+            return ngraph::element::i8;
+        case OperandType::TENSOR_FLOAT16:
+            return ngraph::element::f16;
+        case OperandType::TENSOR_QUANT16_SYMM:
+            return ngraph::element::i16;
+        case OperandType::TENSOR_QUANT16_ASYMM:
+            return ngraph::element::u16;
+        default:
+            return ngraph::element::undefined;
+    }
+}
+}  // namespace
+
+While::While(int operationIndex, const GraphMetadata& graphMetadata)
+    : OperationsBase(operationIndex, graphMetadata) {
+    mDefaultOutputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, 0);
+}
+
+bool While::validate() {
+    // Of the plugins with a prepared model, only the CPU one runs Loop
+    if (mPluginType != IntelDeviceType::CPU) {
+        ALOGE("%s Loop is not supported by plugin %d", __func__, mPluginType);
+        return false;
+    }
+    auto condInfo = mModelInfo->getReferencedModelInfo(
+        mModelInfo->getOperationInput(mNnapiOperationIndex, 0));
+    auto bodyInfo = mModelInfo->getReferencedModelInfo(
+        mModelInfo->getOperationInput(mNnapiOperationIndex, 1));
+    if (condInfo == nullptr || bodyInfo == nullptr) return false;
+
+    const size_t loopInputs =
+        mModelInfo->getOperationInputsSize(mNnapiOperationIndex) - kFirstLoopInput;
+    const size_t outputs = mModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
+    const size_t carried = bodyInfo->getModelOutputsSize();
+    if (condInfo->getModelInputIndexes().size() != loopInputs ||
+        bodyInfo->getModelInputIndexes().size() != loopInputs ||
+        condInfo->getModelOutputsSize() != 1 || carried < outputs || carried > loopInputs) {
+        ALOGE("%s condition or body signature does not match the operation", __func__);
+        return false;
+    }
+    if (condInfo->getOperandType(condInfo->getModelOutputIndex(0)) != OperandType::TENSOR_BOOL8) {
+        ALOGE("%s condition model does not return TENSOR_BOOL8", __func__);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < loopInputs; i++) {
+        const auto& input = getInputOperand(kFirstLoopInput + i);
+        const auto& bodyInput = bodyInfo->getOperand(bodyInfo->getModelInputIndex(i));
+        if (!hasStaticShape(bodyInput) || !isSameTensor(input, bodyInput) ||
+            getElementType(bodyInput.type) == ngraph::element::undefined) {
+            ALOGE("%s input %d has no static shape or does not match the body", __func__, i);
+            return false;
+        }
+        if (i < carried &&
+            !isSameTensor(bodyInput, bodyInfo->getOperand(bodyInfo->getModelOutputIndex(i)))) {
+            ALOGE("%s carried value %d changes shape or type across iterations", __func__, i);
+            return false;
+        }
+        if (i < outputs && !isSameTensor(bodyInput, getOutputOperand(i))) {
+            ALOGE("%s output %d does not match the body", __func__, i);
+            return false;
+        }
+    }
+    if (!NgraphNetworkCreator::validateSubgraph(condInfo, mPluginType) ||
+        !NgraphNetworkCreator::validateSubgraph(bodyInfo, mPluginType))
+        return false;
+    ALOGV("%s PASSED", __func__);
+    return true;
+}
+
+void While::connectOperationToGraph() { createNode(); }
+
+std::shared_ptr<ngraph::Node> While::createNode() {
+    auto condInfo = mModelInfo->getReferencedModelInfo(
+        mModelInfo->getOperationInput(mNnapiOperationIndex, 0));
+    auto bodyInfo = mModelInfo->getReferencedModelInfo(
+        mModelInfo->getOperationInput(mNnapiOperationIndex, 1));
+    if (condInfo == nullptr || bodyInfo == nullptr)
+        throw std::runtime_error("WHILE models could not be read");
+    const size_t loopInputs =
+        mModelInfo->getOperationInputsSize(mNnapiOperationIndex) - kFirstLoopInput;
+    const size_t carried = bodyInfo->getModelOutputsSize();
+
+    ngraph::OutputVector inputs;
+    for (uint32_t i = 0; i < loopInputs; i++)
+        inputs.push_back(getInputNode(kFirstLoopInput + i, false));
+    // Each instance of a model is built by a creator of its own, as the nodes are per operand
+    const auto initialCondition =
+        NgraphNetworkCreator(condInfo, mPluginType, mLowPrecision).connectSubgraph(inputs);
+
+    ngraph::ParameterVector parameters;
+    for (uint32_t i = 0; i < loopInputs; i++) {
+        const auto& operand = bodyInfo->getOperand(bodyInfo->getModelInputIndex(i));
+        parameters.push_back(std::make_shared<ngraph::opset3::Parameter>(
+            getElementType(operand.type),
+            ngraph::Shape(operand.dimensions.begin(), operand.dimensions.end())));
+    }
+    const auto bodyOutputs = NgraphNetworkCreator(bodyInfo, mPluginType, mLowPrecision)
+                                 .connectSubgraph(ngraph::OutputVector(parameters.begin(),
+                                                                       parameters.end()));
+    if (initialCondition.size() != 1 || bodyOutputs.size() != carried)
+        throw std::runtime_error("WHILE models could not be built");
+    ngraph::OutputVector nextInputs(bodyOutputs);
+    nextInputs.insert(nextInputs.end(), parameters.begin() + carried, parameters.end());
+    const auto nextCondition =
+        NgraphNetworkCreator(condInfo, mPluginType, mLowPrecision).connectSubgraph(nextInputs);
+    if (nextCondition.size() != 1) throw std::runtime_error("WHILE condition could not be built");
+
+    ngraph::ResultVector results;
+    for (const auto& output : bodyOutputs)
+        results.push_back(std::make_shared<ngraph::opset3::Result>(output));
+    results.push_back(std::make_shared<ngraph::opset3::Result>(nextCondition[0]));
+    auto body = std::make_shared<ngraph::Function>(results, parameters);
+
+    // No trip count, the condition alone ends the loop
+    auto tripCount = ngraph::opset5::Constant::create(ngraph::element::i64, ngraph::Shape{}, {-1});
+    auto loop = std::make_shared<ngraph::opset5::Loop>(tripCount, initialCondition[0]);
+    loop->set_function(body);
+    loop->set_special_body_ports(
+        ngraph::opset5::Loop::SpecialBodyPorts{-1, static_cast<int64_t>(carried)});
+    for (uint32_t i = 0; i < loopInputs; i++) {
+        if (i < carried)
+            loop->set_merged_input(parameters[i], inputs[i], results[i]);
+        else
+            loop->set_invariant_input(parameters[i], inputs[i]);
+    }
+
+    const size_t outputs = mModelInfo->getOperationOutputsSize(mNnapiOperationIndex);
+    ngraph::OutputVector values;
+    for (uint32_t i = 0; i < outputs; i++) values.push_back(loop->get_iter_value(results[i], -1));
+    loop->validate_and_infer_types();
+
+    for (uint32_t i = 0; i < outputs; i++) {
+        auto outputIndex = mModelInfo->getOperationOutput(mNnapiOperationIndex, i);
+        mNgraphNodes->setOutputAtOperandIndex(outputIndex, values[i]);
+        ALOGD("%s Set Output index %d", __func__, outputIndex);
+        const auto& op = mModelInfo->getOperand(outputIndex);
+        if (op.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT) {
+            addResultNode(outputIndex, values[i]);
+            ALOGD("%s Add result %d", __func__, outputIndex);
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
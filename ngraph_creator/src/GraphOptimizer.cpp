@@ -0,0 +1,263 @@
+#include <GraphOptimizer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <ngraph/attribute_visitor.hpp>
+#include <ngraph/graph_util.hpp>
+#include <ngraph/opsets/opset3.hpp>
+#include <sstream>
+#undef LOG_TAG
+#define LOG_TAG "GraphOptimizer"
+
+namespace android {
+namespace hardware {
+namespace neuralnetworks {
+namespace nnhal {
+
+namespace {
+bool isShapeOp(const std::shared_ptr<ngraph::Node>& node) {
+    return ngraph::is_type<ngraph::opset3::Reshape>(node) ||
+           ngraph::is_type<ngraph::opset3::Squeeze>(node) ||
+           ngraph::is_type<ngraph::opset3::Unsqueeze>(node);
+}
+
+// Whether every value of type from survives a round trip through type to
+bool isLosslessConversion(const ngraph::element::Type& from, const ngraph::element::Type& to) {
+    if (from == to) return true;
+    if (to == ngraph::element::f32)
+        return from == ngraph::element::f16 ||
+               (from.is_integral_number() && from.bitwidth() <= 16);
+    if (from.is_integral_number() && to.is_integral_number()) {
+        if (from.is_signed() && !to.is_signed()) return false;
+        return to.bitwidth() > from.bitwidth();
+    }
+    return false;
+}
+
+// Serializes the attributes of a node, so that nodes of the same type can be compared
+class AttributeSerializer : public ngraph::AttributeVisitor {
+public:
+    std::ostringstream mStream;
+    bool mComparable = true;
+
+    // Keeps the overloads not serialized here visible, they report the node as not comparable
+    // through the ValueAccessor<void> one
+    using ngraph::AttributeVisitor::on_adapter;
+
+    void on_adapter(const std::string&, ngraph::ValueAccessor<void>&) override {
+        mComparable = false;
+    }
+    void on_adapter(const std::string& name,
+                    ngraph::ValueAccessor<std::string>& adapter) override {
+        mStream << name << '=' << adapter.get() << ';';
+    }
+    void on_adapter(const std::string& name, ngraph::ValueAccessor<bool>& adapter) override {
+        mStream << name << '=' << adapter.get() << ';';
+    }
+    void on_adapter(const std::string& name, ngraph::ValueAccessor<int64_t>& adapter) override {
+        mStream << name << '=' << adapter.get() << ';';
+    }
+    void on_adapter(const std::string& name, ngraph::ValueAccessor<double>& adapter) override {
+        mStream << name << '=' << adapter.get() << ';';
+    }
+    void on_adapter(const std::string& name,
+                    ngraph::ValueAccessor<std::vector<int64_t>>& adapter) override {
+        mStream << name << '=';
+        for (auto value : adapter.get()) mStream << value << ',';
+        mStream << ';';
+    }
+    void on_adapter(const std::string& name,
+                    ngraph::ValueAccessor<std::vector<uint64_t>>& adapter) override {
+        mStream << name << '=';
+        for (auto value : adapter.get()) mStream << value << ',';
+        mStream << ';';
+    }
+    void on_adapter(const std::string& name,
+                    ngraph::ValueAccessor<std::vector<float>>& adapter) override {
+        mStream << name << '=';
+        for (auto value : adapter.get()) mStream << value << ',';
+        mStream << ';';
+    }
+};
+}  // namespace
+
+GraphOptimizer::GraphOptimizer(const std::vector<std::string>& passes, bool keepQuantizedWeights)
+    : mPasses(passes), mKeepQuantizedWeights(keepQuantizedWeights) {}
+
+const std::vector<std::string>& GraphOptimizer::getDefaultPasses() {
+    static const std::vector<std::string> defaultPasses = {
+        "constant_folding", "convert_chains", "reshape_chains", "nop_elimination", "cse"};
+    return defaultPasses;
+}
+
+bool GraphOptimizer::isKnownPass(const std::string& pass) {
+    const auto& passes = getDefaultPasses();
+    return std::find(passes.begin(), passes.end(), pass) != passes.end();
+}
+
+void GraphOptimizer::run(std::shared_ptr<ngraph::Function> function) {
+    for (const auto& pass : mPasses) {
+        auto nodesBefore = function->get_ops().size();
+        auto start = std::chrono::steady_clock::now();
+
+        size_t rewrites = 0;
+        if (pass == "constant_folding")
+            rewrites = foldConstants(function);
+        else if (pass == "convert_chains")
+            rewrites = collapseConvertChains(function);
+        else if (pass == "reshape_chains")
+            rewrites = collapseReshapeChains(function);
+        else if (pass == "nop_elimination")
+            rewrites = eliminateNops(function);
+        else if (pass == "cse")
+            rewrites = eliminateCommonSubexpressions(function);
+        else
+            ALOGE("%s unknown pass %s", __func__, pass.c_str());
+
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        ALOGI("%s %s: %zu rewrites, nodes %zu -> %zu in %lld us", __func__, pass.c_str(), rewrites,
+              nodesBefore, function->get_ops().size(), (long long)duration);
+    }
+}
+
+size_t GraphOptimizer::foldConstants(std::shared_ptr<ngraph::Function> function) {
+    size_t folded = 0;
+    for (const auto& node : function->get_ordered_ops()) {
+        // The initial value of a ReadValue is only used until the state is first assigned
+        if (node->get_input_size() == 0 || ngraph::op::is_output(node) ||
+            ngraph::is_type<ngraph::opset3::ReadValue>(node))
+            continue;
+
+        bool constantInputs = true;
+        for (const auto& input : node->input_values()) {
+            if (!ngraph::op::is_constant(input.get_node())) {
+                constantInputs = false;
+                break;
+            }
+        }
+        if (!constantInputs) continue;
+
+        if (mKeepQuantizedWeights && ngraph::is_type<ngraph::opset3::Convert>(node)) {
+            const auto& inputType = node->get_input_element_type(0);
+            if (inputType == ngraph::element::u8 || inputType == ngraph::element::i8) continue;
+        }
+
+        ngraph::OutputVector replacements(node->get_output_size());
+        try {
+            if (!node->constant_fold(replacements, node->input_values())) continue;
+        } catch (const std::exception& ex) {
+            ALOGD("%s skipping %s: %s", __func__, node->get_name().c_str(), ex.what());
+            continue;
+        }
+        for (size_t i = 0; i < replacements.size(); i++) {
+            if (replacements[i].get_node())
+                ngraph::replace_output_update_name(node->output(i), replacements[i]);
+        }
+        folded++;
+    }
+    return folded;
+}
+
+size_t GraphOptimizer::collapseConvertChains(std::shared_ptr<ngraph::Function> function) {
+    size_t collapsed = 0;
+    for (const auto& node : function->get_ordered_ops()) {
+        if (!ngraph::is_type<ngraph::opset3::Convert>(node)) continue;
+        const auto& outputType = node->get_output_element_type(0);
+
+        auto input = node->input_value(0);
+        if (input.get_element_type() == outputType) {
+            if (ngraph::replace_output_update_name(node->output(0), input)) collapsed++;
+            continue;
+        }
+
+        auto inner = input.get_node_shared_ptr();
+        if (!ngraph::is_type<ngraph::opset3::Convert>(inner)) continue;
+        auto source = inner->input_value(0);
+        if (!isLosslessConversion(source.get_element_type(), input.get_element_type())) continue;
+
+        ngraph::Output<ngraph::Node> replacement = source;
+        if (source.get_element_type() != outputType)
+            replacement = std::make_shared<ngraph::opset3::Convert>(source, outputType);
+        if (ngraph::replace_output_update_name(node->output(0), replacement)) collapsed++;
+    }
+    return collapsed;
+}
+
+size_t GraphOptimizer::collapseReshapeChains(std::shared_ptr<ngraph::Function> function) {
+    size_t collapsed = 0;
+    for (const auto& node : function->get_ordered_ops()) {
+        if (!isShapeOp(node) || node->get_output_partial_shape(0).is_dynamic()) continue;
+        auto inner = node->get_input_node_shared_ptr(0);
+        if (!isShapeOp(inner)) continue;
+
+        const auto& shape = node->get_output_shape(0);
+        auto shapeNode = ngraph::opset3::Constant::create(
+            ngraph::element::i64, ngraph::Shape{shape.size()},
+            std::vector<int64_t>(shape.begin(), shape.end()));
+        auto reshape =
+            std::make_shared<ngraph::opset3::Reshape>(inner->input_value(0), shapeNode, false);
+        if (ngraph::replace_output_update_name(node->output(0), reshape)) collapsed++;
+    }
+    return collapsed;
+}
+
+size_t GraphOptimizer::eliminateNops(std::shared_ptr<ngraph::Function> function) {
+    size_t eliminated = 0;
+    for (const auto& node : function->get_ordered_ops()) {
+        bool isNop = false;
+        if (isShapeOp(node)) {
+            const auto& inputShape = node->get_input_partial_shape(0);
+            isNop = inputShape.is_static() && inputShape == node->get_output_partial_shape(0);
+        } else if (ngraph::is_type<ngraph::opset3::Transpose>(node)) {
+            auto order =
+                ngraph::as_type_ptr<ngraph::opset3::Constant>(node->get_input_node_shared_ptr(1));
+            if (order) {
+                auto axes = order->cast_vector<int64_t>();
+                isNop = true;
+                for (size_t i = 0; i < axes.size(); i++) isNop = isNop && axes[i] == (int64_t)i;
+            }
+        }
+        if (isNop && ngraph::replace_output_update_name(node->output(0), node->input_value(0)))
+            eliminated++;
+    }
+    return eliminated;
+}
+
+size_t GraphOptimizer::eliminateCommonSubexpressions(std::shared_ptr<ngraph::Function> function) {
+    size_t eliminated = 0;
+    std::map<std::string, std::shared_ptr<ngraph::Node>> seen;
+    for (const auto& node : function->get_ordered_ops()) {
+        if (node->get_input_size() == 0 || ngraph::op::is_output(node) ||
+            ngraph::is_type<ngraph::opset3::ReadValue>(node) ||
+            ngraph::is_type<ngraph::opset3::Assign>(node))
+            continue;
+
+        AttributeSerializer serializer;
+        serializer.mStream << node->get_type_info().name << '.' << node->get_type_info().version
+                           << '(';
+        for (const auto& input : node->input_values())
+            serializer.mStream << input.get_node() << ':' << input.get_index() << ',';
+        serializer.mStream << ')';
+        if (!node->visit_attributes(serializer) || !serializer.mComparable) continue;
+
+        auto key = serializer.mStream.str();
+        auto it = seen.find(key);
+        if (it == seen.end()) {
+            seen[key] = node;
+            continue;
+        }
+        bool replaced = true;
+        for (size_t i = 0; i < node->get_output_size(); i++)
+            replaced = ngraph::replace_output_update_name(node->output(i), it->second->output(i)) &&
+                       replaced;
+        if (replaced) eliminated++;
+    }
+    return eliminated;
+}
+
+}  // namespace nnhal
+}  // namespace neuralnetworks
+}  // namespace hardware
+}  // namespace android
@@ -1,4 +1,5 @@
 #include <NgraphNetworkCreator.hpp>
+#include "Tracing.h"
 #undef LOG_TAG
 #define LOG_TAG "NgraphNetworkCreator"
 
@@ -7,12 +8,26 @@ namespace hardware {
 namespace neuralnetworks {
 namespace nnhal {
 
+namespace {
+// A state input is fed back from a state output of the same shape, both being model operands
+bool isStateOperandPair(std::shared_ptr<NnapiModelInfo> modelInfo, uint32_t inputIndex,
+                        uint32_t outputIndex) {
+    const auto& input = modelInfo->getOperand(inputIndex);
+    const auto& output = modelInfo->getOperand(outputIndex);
+    return input.lifetime == OperandLifeTime::SUBGRAPH_INPUT &&
+           output.lifetime == OperandLifeTime::SUBGRAPH_OUTPUT &&
+           input.type == OperandType::TENSOR_FLOAT32 && output.type == input.type &&
+           !input.dimensions.empty() && input.dimensions[0] != 0 &&
+           input.dimensions == output.dimensions;
+}
+}  // namespace
+
 NgraphNetworkCreator::NgraphNetworkCreator(std::shared_ptr<NnapiModelInfo> modelInfo,
-                                           IntelDeviceType deviceType)
+                                           IntelDeviceType deviceType, bool lowPrecision)
     : mModelInfo(modelInfo),
       mNgraphNodes(std::make_shared<NgraphNodes>(mModelInfo->getOperandsSize(),
                                                  mModelInfo->getModelOutputsSize())),
-      mOpFactoryInstance(deviceType, mModelInfo, mNgraphNodes) {
+      mOpFactoryInstance(deviceType, mModelInfo, mNgraphNodes, lowPrecision) {
     auto nnapiOperationsSize = mModelInfo->getOperationsSize();
     mOperationNodes.resize(nnapiOperationsSize);
     for (size_t index = 0; index < nnapiOperationsSize; index++) {
@@ -20,8 +35,7 @@ NgraphNetworkCreator::NgraphNetworkCreator(std::shared_ptr<NnapiModelInfo> model
         auto operationNode = mOpFactoryInstance.getOperation(index, nnapiOperationType);
         if (operationNode == nullptr) {
             ALOGV("%s Unsupported Operation type %d", __func__, nnapiOperationType);
-        } else
-            operationNode->mNgraphNodes = mNgraphNodes;
+        }
         mOperationNodes[index] = operationNode;
     }
     ALOGV("%s Constructed", __func__);
@@ -101,8 +115,12 @@ bool NgraphNetworkCreator::createInputParams() {
                         return false;
                 }
 
-                mNgraphNodes->addInputParam(inputParam);
-                mNgraphNodes->setOutputAtOperandIndex(i, inputParam);
+                if (mNgraphNodes->getStateVariable(i).empty()) {
+                    mNgraphNodes->addInputParam(inputParam);
+                    mNgraphNodes->setOutputAtOperandIndex(i, inputParam);
+                } else {
+                    mNgraphNodes->addStateInput(i, inputParam);
+                }
             } else {
                 mNgraphNodes->setInvalidNode(i);
             }
@@ -124,6 +142,33 @@ void NgraphNetworkCreator::getSupportedOperations(std::vector<bool>& supportedOp
     }
 }
 
+void NgraphNetworkCreator::querySupportedOperations(std::shared_ptr<NnapiModelInfo> modelInfo,
+                                                    IntelDeviceType deviceType,
+                                                    std::vector<bool>& supportedOperations) {
+    OperationsFactory opFactory(deviceType, modelInfo, nullptr);
+    for (size_t i = 0; i < modelInfo->getOperationsSize(); i++) {
+        const auto& nnapiOperationType = modelInfo->getOperationType(i);
+        auto operationNode = opFactory.getOperation(i, nnapiOperationType);
+        supportedOperations[i] = operationNode && operationNode->validateForPlugin();
+        ALOGD("%s index %zu type %d, supported : %d", __func__, i, nnapiOperationType,
+              static_cast<int>(supportedOperations[i]));
+    }
+}
+
+bool NgraphNetworkCreator::validateSubgraph(std::shared_ptr<NnapiModelInfo> modelInfo,
+                                            IntelDeviceType deviceType) {
+    std::vector<bool> supportedOperations(modelInfo->getOperationsSize(), false);
+    querySupportedOperations(modelInfo, deviceType, supportedOperations);
+    for (size_t i = 0; i < supportedOperations.size(); i++) {
+        if (!supportedOperations[i]) {
+            ALOGE("%s index %zu type %d not supported", __func__, i,
+                  modelInfo->getOperationType(i));
+            return false;
+        }
+    }
+    return true;
+}
+
 bool NgraphNetworkCreator::validateOperations() {
     for (size_t i = 0; i < mModelInfo->getOperationsSize(); i++) {
         if (!mOperationNodes[i] || !mOperationNodes[i]->validateForPlugin()) {
@@ -135,14 +180,53 @@ bool NgraphNetworkCreator::validateOperations() {
     return true;
 }
 
-bool NgraphNetworkCreator::initializeModel() {
-    ALOGV("%s Called", __func__);
-    if (!createInputParams()) return false;
+size_t NgraphNetworkCreator::enableStatefulModel(bool internalStates) {
+    size_t stateVariables = 0;
+    mNgraphNodes->setInternalStates(internalStates);
+    for (size_t i = 0; i < mModelInfo->getOperationsSize(); i++) {
+        // Operation input and output indexes of each state
+        std::vector<std::pair<uint32_t, uint32_t>> states;
+        switch (mModelInfo->getOperationType(i)) {
+            case OperationType::LSTM:
+                // output_state_in/out, cell_state_in/out
+                states = {{18, 1}, {19, 2}};
+                break;
+            case OperationType::RNN:
+                states = {{4, 0}};
+                break;
+            case OperationType::UNIDIRECTIONAL_SEQUENCE_RNN:
+                states = {{4, 1}};
+                break;
+            case OperationType::BIDIRECTIONAL_SEQUENCE_RNN: {
+                // The backward output is concatenated to the forward one when merged
+                uint32_t mergeOutputs = mModelInfo->ParseOperationInput<uint8_t>(i, 14);
+                states = {{4, 2 - mergeOutputs}, {8, 3 - mergeOutputs}};
+                break;
+            }
+            default:
+                continue;
+        }
+
+        for (const auto& state : states) {
+            if (state.second >= mModelInfo->getOperationOutputsSize(i)) continue;
+            auto inputIndex = mModelInfo->getOperationInput(i, state.first);
+            auto outputIndex = mModelInfo->getOperationOutput(i, state.second);
+            if (!isStateOperandPair(mModelInfo, inputIndex, outputIndex)) continue;
+            mNgraphNodes->addStateVariable(inputIndex, outputIndex);
+            stateVariables++;
+        }
+    }
+    ALOGI("%s %zu state variables", __func__, stateVariables);
+    return stateVariables;
+}
+
+bool NgraphNetworkCreator::connectOperations() {
     for (size_t i = 0; i < mModelInfo->getOperationsSize(); i++) {
         if (mOperationNodes[i] == nullptr) {
-            ALOGE("initializeModel Failure at type %d", mModelInfo->getOperationType(i));
+            ALOGE("%s Failure at type %d", __func__, mModelInfo->getOperationType(i));
             return false;
         }
+        TraceEvent trace("createNode", 0, i);
         try {
             mOperationNodes[i]->connectOperationToGraph();
         } catch (const std::exception& ex) {
@@ -150,17 +234,61 @@ bool NgraphNetworkCreator::initializeModel() {
             return false;
         }
     }
+    return true;
+}
+
+bool NgraphNetworkCreator::initializeModel() {
+    ALOGV("%s Called", __func__);
+    if (!createInputParams() || !connectOperations()) return false;
     ALOGD("initializeModel Success");
     return true;
 }
 
+ngraph::OutputVector NgraphNetworkCreator::connectSubgraph(const ngraph::OutputVector& inputs) {
+    ALOGV("%s Called", __func__);
+    const auto& inputIndexes = mModelInfo->getModelInputIndexes();
+    if (inputs.size() != inputIndexes.size()) {
+        ALOGE("%s %zu inputs given for %zu subgraph inputs", __func__, inputs.size(),
+              inputIndexes.size());
+        return {};
+    }
+    for (size_t i = 0; i < inputs.size(); i++)
+        mNgraphNodes->setOutputAtOperandIndex(inputIndexes[i], inputs[i]);
+    if (!connectOperations()) return {};
+
+    ngraph::OutputVector outputs;
+    for (size_t i = 0; i < mModelInfo->getModelOutputsSize(); i++) {
+        auto output = mNgraphNodes->getOperationOutput(mModelInfo->getModelOutputIndex(i));
+        if (output.get_node() == nullptr) {
+            ALOGE("%s subgraph output %zu was not produced", __func__, i);
+            return {};
+        }
+        outputs.push_back(output);
+    }
+    return outputs;
+}
+
 const std::string& NgraphNetworkCreator::getNodeName(uint32_t index) {
     ALOGV("getNodeName %d", index);
     return mNgraphNodes->getNodeName(index);
 }
 
+const std::string& NgraphNetworkCreator::getStateSelector(uint32_t index) {
+    return mNgraphNodes->getStateSelector(index);
+}
+
+void NgraphNetworkCreator::releaseGraph() {
+    const auto& inputIndexes = mModelInfo->getModelInputIndexes();
+    std::vector<uint32_t> operandIndexes(inputIndexes.begin(), inputIndexes.end());
+    for (size_t i = 0; i < mModelInfo->getModelOutputsSize(); i++)
+        operandIndexes.push_back(mModelInfo->getModelOutputIndex(i));
+    mNgraphNodes->releaseGraph(operandIndexes);
+    std::vector<std::shared_ptr<OperationsBase>>().swap(mOperationNodes);
+}
+
 std::shared_ptr<ngraph::Function> NgraphNetworkCreator::generateGraph() {
     ALOGV("%s Called", __func__);
+    TraceEvent trace("generateGraph");
     std::shared_ptr<ngraph::Function> ret;
     try {
         if (initializeModel()) ret = mNgraphNodes->generateGraph();
@@ -170,6 +298,18 @@ std::shared_ptr<ngraph::Function> NgraphNetworkCreator::generateGraph() {
     return ret;
 }
 
+void NgraphNetworkCreator::optimizeGraph(std::shared_ptr<ngraph::Function> function,
+                                         const std::vector<std::string>& passes) {
+    ALOGV("%s Called", __func__);
+    try {
+        GraphOptimizer optimizer(passes, mOpFactoryInstance.getGraphMetadata().lowPrecision);
+        optimizer.run(function);
+    } catch (const std::exception& ex) {
+        // Every rewrite leaves a valid graph, so the function is still usable as is
+        ALOGE("%s Exception !!! %s", __func__, ex.what());
+    }
+}
+
 }  // namespace nnhal
 }  // namespace neuralnetworks
 }  // namespace hardware
@@ -9,7 +9,8 @@ namespace nnhal {
 NgraphNodes::NgraphNodes(size_t operandsSize, size_t resultsSize) {
     mOutputAtOperandIndex.resize(operandsSize);
     mForcedNchw.assign(operandsSize, false);
-    mResultNodes.reserve(resultsSize);
+    mDequantizedOutput.assign(operandsSize, false);
+    mResults.reserve(resultsSize);
     ALOGV("%s Constructed operandsSize %zu, resultsSize %zu", __func__, operandsSize, resultsSize);
 }
 
@@ -26,19 +27,104 @@ ngraph::Output<ngraph::Node> NgraphNodes::getOperationOutput(size_t index) {
     return mOutputAtOperandIndex[index];
 }
 
-void NgraphNodes::setResultNode(size_t outputIndex, std::shared_ptr<ngraph::Node> resultNode) {
+std::shared_ptr<ngraph::Node> NgraphNodes::getConstantNode(size_t index, bool dequantized) {
+    auto it = mConstantNodes.find({index, dequantized});
+    if (it == mConstantNodes.end()) return nullptr;
+    return it->second;
+}
+
+void NgraphNodes::setConstantNode(size_t index, bool dequantized,
+                                  std::shared_ptr<ngraph::Node> node) {
+    ALOGV("%s index %zu dequantized %d", __func__, index, dequantized);
+    mConstantNodes[{index, dequantized}] = node;
+}
+
+void NgraphNodes::setResultNode(size_t outputIndex, ngraph::Output<ngraph::Node> output) {
     ALOGD("setResultNode %zu", outputIndex);
-    mResultNodes.push_back(resultNode);
+    const auto& variableId = getStateVariable(outputIndex);
+    if (!variableId.empty())
+        mSinks.push_back(std::make_shared<ngraph::opset3::Assign>(output, variableId));
+    auto result = std::make_shared<ngraph::opset3::Result>(output);
+    mResults.push_back(result);
+    mResultAtOperandIndex[outputIndex] = result;
+}
+
+void NgraphNodes::addStateVariable(size_t inputIndex, size_t outputIndex) {
+    auto variableId = "state_" + std::to_string(inputIndex);
+    ALOGD("%s %s, input %zu output %zu", __func__, variableId.c_str(), inputIndex, outputIndex);
+    mStateVariables[inputIndex] = variableId;
+    mStateVariables[outputIndex] = variableId;
+}
+
+void NgraphNodes::addStateInput(size_t index,
+                                std::shared_ptr<ngraph::opset3::Parameter> inputParam) {
+    // Zero until the first execution assigns the variable
+    auto initialValue = ngraph::opset3::Constant::create(inputParam->get_element_type(),
+                                                         inputParam->get_shape(), {0.f});
+    auto state =
+        std::make_shared<ngraph::opset3::ReadValue>(initialValue, getStateVariable(index));
+    if (mInternalStates) {
+        // The input is left out of the network, so the request's value is never copied
+        mNodeNames[index] = "";
+        setOutputAtOperandIndex(index, state);
+        return;
+    }
+    addInputParam(inputParam);
+    auto selector =
+        std::make_shared<ngraph::opset3::Parameter>(ngraph::element::boolean, ngraph::Shape{1});
+    addInputParam(selector);
+    mStateSelectors[index] = selector->get_name();
+    // The request copies a passed state into the input Parameter, not into the Select
+    mNodeNames[index] = inputParam->get_name();
+    setOutputAtOperandIndex(
+        index, std::make_shared<ngraph::opset3::Select>(selector, inputParam, state));
+}
+
+const std::string& NgraphNodes::getStateSelector(size_t index) {
+    static const std::string kNoSelector;
+    auto it = mStateSelectors.find(index);
+    return it == mStateSelectors.end() ? kNoSelector : it->second;
+}
+
+const std::string& NgraphNodes::getStateVariable(size_t index) {
+    static const std::string kNoVariable;
+    auto it = mStateVariables.find(index);
+    return it == mStateVariables.end() ? kNoVariable : it->second;
 }
 
 const std::string& NgraphNodes::getNodeName(size_t index) {
     if (mNodeNames.find(index) == mNodeNames.end()) {
-        mNodeNames[index] = mOutputAtOperandIndex[index].get_node_shared_ptr()->get_name();
+        // Output names are first looked up once the network is loaded, after the graph passes
+        // that may have replaced the node feeding the Result. Only the names kept by
+        // releaseGraph are known once the graph is released.
+        auto result = mResultAtOperandIndex.find(index);
+        if (result != mResultAtOperandIndex.end()) {
+            const auto source = result->second->input_value(0);
+            mNodeNames[index] = source.get_node()->get_friendly_name();
+            if (source.get_node()->get_output_size() > 1)
+                mNodeNames[index] += "." + std::to_string(source.get_index());
+        } else {
+            const auto* node = index < mOutputAtOperandIndex.size()
+                                   ? mOutputAtOperandIndex[index].get_node()
+                                   : nullptr;
+            mNodeNames[index] = node ? node->get_name() : "";
+        }
         ALOGD("%s index %zu, name %s", __func__, index, mNodeNames[index].c_str());
     }
     ALOGV("%s index %zu, name %s", __func__, index, mNodeNames[index].c_str());
     return mNodeNames[index];
 }
+
+void NgraphNodes::releaseGraph(const std::vector<uint32_t>& operandIndexes) {
+    for (auto index : operandIndexes) getNodeName(index);
+    std::vector<ngraph::Output<ngraph::Node>>().swap(mOutputAtOperandIndex);
+    mInputParams.clear();
+    mResults.clear();
+    mResultAtOperandIndex.clear();
+    mConstantNodes.clear();
+    mSinks.clear();
+}
+
 // remove null input node parameter
 void NgraphNodes::removeInputParameter(std::string name, size_t index) {
     for (size_t i = 0; i < mInputParams.size(); i++) {
@@ -50,7 +136,21 @@ void NgraphNodes::removeInputParameter(std::string name, size_t index) {
 }
 
 std::shared_ptr<ngraph::Function> NgraphNodes::generateGraph() {
-    return std::make_shared<ngraph::Function>(mResultNodes, mInputParams);
+    std::shared_ptr<ngraph::Function> function;
+    if (mSinks.empty()) {
+        function = std::make_shared<ngraph::Function>(mResults, mInputParams);
+    } else {
+        function = std::make_shared<ngraph::Function>(mResults, mSinks, mInputParams);
+        ALOGI("%s %zu state variables", __func__, mSinks.size());
+    }
+    size_t transposes = 0;
+    for (const auto& node : function->get_ordered_ops()) {
+        if (ngraph::is_type<ngraph::opset3::Transpose>(node)) transposes++;
+    }
+    ALOGI("%s layout propagation removed %zu transpose pairs, %zu operations kept in NCHW, %zu "
+          "transposes left",
+          __func__, mElidedTransposes, mNchwOperations, transposes);
+    return function;
 }
 
 void NgraphNodes::setInvalidNode(size_t index) { mNodeNames[index] = ""; }
@@ -16,6 +16,8 @@
 
 #include <log/log.h>
 #include "Driver.h"
+#include "DriverConfig.h"
+#include "Tracing.h"
 #define MAX_LENGTH (255)
 
 #if __ANDROID__
@@ -28,24 +30,35 @@
 using android::hardware::configureRpcThreadpool;
 using android::hardware::joinRpcThreadpool;
 using android::hardware::neuralnetworks::nnhal::Driver;
+using android::hardware::neuralnetworks::nnhal::getDriverConfig;
+using android::hardware::neuralnetworks::nnhal::loadDriverConfig;
 
 int main(int argc, char* argv[]) {
     if (argc > 2 && argv[2] != NULL && strnlen(argv[2], MAX_LENGTH) > 0) {
         if (strcmp(argv[1], "-D") != 0) return 0;
         const char* deviceType = argv[2];
+        const char* configSection;
         android::sp<Driver> device;
 
-        if (strncmp(deviceType, "GNA", 3) == 0)
+        if (strncmp(deviceType, "GNA", 3) == 0) {
             device = new Driver(android::hardware::neuralnetworks::nnhal::IntelDeviceType::GNA);
-        else if (strncmp(deviceType, "VPU", 3) == 0)
+            configSection = "GNA";
+        } else if (strncmp(deviceType, "VPU", 3) == 0) {
             device = new Driver(android::hardware::neuralnetworks::nnhal::IntelDeviceType::VPU);
-        else if (strncmp(deviceType, "GPU", 3) == 0)
+            configSection = "VPU";
+        } else if (strncmp(deviceType, "GPU", 3) == 0) {
             device = new Driver(android::hardware::neuralnetworks::nnhal::IntelDeviceType::GPU);
-        else
+            configSection = "GPU";
+        } else {
             device = new Driver(android::hardware::neuralnetworks::nnhal::IntelDeviceType::CPU);
+            configSection = "CPU";
+        }
 
+        loadDriverConfig(configSection);
+        android::hardware::neuralnetworks::nnhal::startTracing(getDriverConfig().traceFile);
+        device->initCapabilities();
         ALOGD("NN-HAL-1.3(%s) is ready.", deviceType);
-        configureRpcThreadpool(4, true);
+        configureRpcThreadpool(getDriverConfig().binderThreads, true);
         android::status_t status = device->registerAsService(deviceType);
         LOG_ALWAYS_FATAL_IF(status != android::OK, "Error while registering as service for %s: %d",
                             deviceType, status);
@@ -62,7 +75,19 @@ namespace neuralnetworks {
 
 ::android::sp<V1_0::IDevice> V1_0::IDevice::getService(const std::string& serviceName, bool dummy) {
     ALOGD("Initializaing the Intel NNHAL driver. Service name: %s", serviceName.c_str());
-    return new nnhal::Driver(nnhal::IntelDeviceType::CPU);
+    // GNA runs in software emulation on hosts, see IENetwork
+    if (serviceName.compare(0, 3, "GNA") == 0) {
+        nnhal::loadDriverConfig("GNA");
+        nnhal::startTracing(nnhal::getDriverConfig().traceFile);
+        sp<nnhal::Driver> device = new nnhal::Driver(nnhal::IntelDeviceType::GNA);
+        device->initCapabilities();
+        return device;
+    }
+    nnhal::loadDriverConfig("CPU");
+    nnhal::startTracing(nnhal::getDriverConfig().traceFile);
+    sp<nnhal::Driver> device = new nnhal::Driver(nnhal::IntelDeviceType::CPU);
+    device->initCapabilities();
+    return device;
 }
 
 }  // namespace neuralnetworks